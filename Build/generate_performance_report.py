@@ -1,7 +1,10 @@
 #!/usr/bin/env python3
 
+import argparse
 import git
+import json
 import os
+import re
 import  matplotlib.pyplot as plt
 
 perf_report_path = r'./performance_report/'
@@ -9,94 +12,225 @@ perf_test_path = r'../tests/performance_tests/Build/Linux/Release/NeuralNetwork_
 perf_test_tmp_result_path = perf_report_path + r'tmp_result.txt'
 perf_test_results_path = perf_report_path + r'results/'
 perf_test_plots_path = perf_report_path + r'plots/'
+perf_test_roofline_result_path = perf_report_path + r'roofline.json'
+
+# kernels characterised by the roofline mode and the machine ceilings
+roofline_kernels = {
+    'element-wise': r'BM_Tensor(Addition|Subtraction|Multiplication|Division|Compare)',
+    'dotProductTranspose': r'BM_TensorDotProductTranspose/',
+    'Conv2D': r'BM_TensorConv2D',
+    'sum': r'BM_Tensor(Sum|RowSum|SumAxes)/',
+}
+time_unit_sec = {'ns': 1e9, 'us': 1e6, 'ms': 1e3, 's': 1.0}
+roofline_filter = r'BM_Machine|' + '|'.join(roofline_kernels.values())
 
 plt.style.use('dark_background')
 
-os.system(r'./build_release_sse.sh')
-
-repo = git.Repo('./..')
-
-repo_diff = repo.index.diff(None)
-if len(repo_diff) > 0:
-    print('Please commit your changes before running this script. Uncommited changes found in files:')
-    for diff in repo_diff:
-        print(f'  {diff.a_path}')
-    exit(1)
-    
-commit_hash = repo.head.commit.hexsha
-print(f'Commit hash = {commit_hash}')
-
-if not(os.path.isdir(perf_report_path)):
-    os.mkdir(perf_report_path)
-
-os.system(f'{perf_test_path} > {perf_test_tmp_result_path}')
-
-print('Gathering test results.')
-
-results = {}
-with open(perf_test_tmp_result_path, 'r') as tmp_result_file:
-    for line in tmp_result_file:
-        line_split = line.split()
-        if line_split[0][:3] == 'BM_':
-            results[line_split[0]] = f'{line_split[1]} {line_split[2]}'
-
-os.remove(perf_test_tmp_result_path)
-
-if not(os.path.isdir(perf_test_results_path)):
-    os.mkdir(perf_test_results_path)
-
-for key, value in results.items():
-    print(f'  test: {key}')
-    with open(os.path.join(perf_test_results_path, key + '.txt'), 'a+') as result_file:
-        result_file.write(f'{commit_hash} {value}\n')
-
-all_tests = []
-
-for _, _, fnames in os.walk(perf_test_results_path):
-    for fname in fnames:
-        all_tests.append(fname.split('.')[0])
-    break
-
-if not(os.path.isdir(perf_test_plots_path)):
-    os.mkdir(perf_test_plots_path)
-
-all_commits = [c.hexsha for c in repo.iter_commits()]
-
-print('Preparing plots.')
-for test in all_tests:
-    results = {c: None for c in all_commits[::-1]}
-    with open(os.path.join(perf_test_results_path, test + '.txt')) as result_file:
-        for line in result_file:
-            commit, time, _ = line.split()
-            results[commit] = int(time)
-    
-    x = []
-    y = []
-    for commit, time in results.items():
-        if time is not None:
-            x.append(commit[:6])
-            y.append(time)
-    
-    fig = plt.figure(figsize=(12, 3), facecolor=(13./255, 17./255, 23./255))
+def history_report():
+    repo = git.Repo('./..')
+
+    repo_diff = repo.index.diff(None)
+    if len(repo_diff) > 0:
+        print('Please commit your changes before running this script. Uncommited changes found in files:')
+        for diff in repo_diff:
+            print(f'  {diff.a_path}')
+        exit(1)
+
+    commit_hash = repo.head.commit.hexsha
+    print(f'Commit hash = {commit_hash}')
+
+    if not(os.path.isdir(perf_report_path)):
+        os.mkdir(perf_report_path)
+
+    os.system(f'{perf_test_path} > {perf_test_tmp_result_path}')
+
+    print('Gathering test results.')
+
+    results = {}
+    with open(perf_test_tmp_result_path, 'r') as tmp_result_file:
+        for line in tmp_result_file:
+            line_split = line.split()
+            if line_split and line_split[0][:3] == 'BM_':
+                # parameterised benchmark names contain slashes
+                results[line_split[0].replace('/', '__')] = f'{line_split[1]} {line_split[2]}'
+
+    os.remove(perf_test_tmp_result_path)
+
+    if not(os.path.isdir(perf_test_results_path)):
+        os.mkdir(perf_test_results_path)
+
+    for key, value in results.items():
+        print(f'  test: {key}')
+        with open(os.path.join(perf_test_results_path, key + '.txt'), 'a+') as result_file:
+            result_file.write(f'{commit_hash} {value}\n')
+
+    all_tests = []
+
+    for _, _, fnames in os.walk(perf_test_results_path):
+        for fname in fnames:
+            all_tests.append(fname.split('.')[0])
+        break
+
+    if not(os.path.isdir(perf_test_plots_path)):
+        os.mkdir(perf_test_plots_path)
+
+    all_commits = [c.hexsha for c in repo.iter_commits()]
+
+    print('Preparing plots.')
+    for test in all_tests:
+        results = {c: None for c in all_commits[::-1]}
+        with open(os.path.join(perf_test_results_path, test + '.txt')) as result_file:
+            for line in result_file:
+                commit, time, _ = line.split()
+                results[commit] = int(time)
+
+        x = []
+        y = []
+        for commit, time in results.items():
+            if time is not None:
+                x.append(commit[:6])
+                y.append(time)
+
+        fig = plt.figure(figsize=(12, 3), facecolor=(13./255, 17./255, 23./255))
+        ax = plt.gca()
+        ax.set_facecolor((13./255, 17./255, 23./255))
+
+        plt.plot(x, y, color='aqua')
+
+        plt.xticks(rotation=90)
+        plt.ylim(0, None)
+        plt.title(test)
+        plt.grid('both')
+        plt.savefig(os.path.join(perf_test_plots_path, test + '.png'), dpi=300, bbox_inches='tight', facecolor=fig.get_facecolor())
+        plt.clf()
+
+    remote_url = repo.remotes.origin.url
+
+    print(remote_url)
+
+    print('Creating report.')
+    with open(os.path.join(perf_report_path, 'report.md'), 'w') as report_file:
+        for test in sorted(all_tests):
+            report_file.write(f'![{test}]({remote_url}/blob/master/Build/{perf_test_plots_path}/{test}.png)\n')
+
+    print('All done.')
+
+
+def roofline_report():
+    if not(os.path.isdir(perf_test_plots_path)):
+        os.makedirs(perf_test_plots_path)
+
+    os.system(f'{perf_test_path} --benchmark_filter="{roofline_filter}" '
+              f'--benchmark_out={perf_test_roofline_result_path} --benchmark_out_format=json > /dev/null')
+
+    print('Gathering test results.')
+
+    with open(perf_test_roofline_result_path, 'r') as result_file:
+        raw = json.load(result_file)
+
+    # machine ceilings per threads count, GFLOP/s and bandwidth in GB/s per triad size
+    # (GFLOP counter is already a rate)
+    peak_gflops = {}
+    bandwidth = {}
+    kernels = []
+    for benchmark in raw['benchmarks']:
+        name = benchmark['name']
+        if name.startswith('BM_MachinePeakFlops'):
+            peak_gflops[benchmark['threads']] = benchmark['GFLOP']
+        elif name.startswith('BM_MachinePeakBandwidth'):
+            n = int(re.search(r'n:(\d+)', name).group(1))
+            bandwidth.setdefault(benchmark['threads'], {})[n] = benchmark['bytes_per_second'] / 1e9
+        elif benchmark.get('GFLOP', 0.0) > 0.0 and benchmark.get('bytes_per_second', 0.0) > 0.0:
+            kernels.append(benchmark)
+
+    if not peak_gflops or not bandwidth:
+        print('Machine benchmarks not found.')
+        exit(1)
+
+    def ceilings(threads):
+        # kernels without a threads argument use the whole default thread pool
+        available = sorted(t for t in peak_gflops if t <= threads) or [min(peak_gflops)]
+        t = available[-1]
+        return peak_gflops[t], bandwidth[t]
+
+    # caches listed by Google Benchmark in the result context, sizes in bytes
+    last_level_cache = max((cache['size'] for cache in raw['context'].get('caches', [])), default=0)
+
+    def level_name(levels, n):
+        # the largest triad is meant to stream from DRAM, unless the last level cache is bigger
+        label = f'triad {n * 3 * 4 // 1024} KiB'
+        if n == max(levels) and n * 3 * 4 > last_level_cache:
+            return f'DRAM ({label})'
+        return label
+
+    rows = []
+    for benchmark in kernels:
+        name = benchmark['name']
+        threads_match = re.search(r'threads:(\d+)', name)
+        threads = int(threads_match.group(1)) if threads_match else raw['context']['num_cpus']
+        peak, levels = ceilings(threads)
+
+        # bandwidth of the smallest triad level holding the bytes touched in one iteration
+        seconds = benchmark['real_time' if '/real_time' in name else 'cpu_time'] / time_unit_sec[benchmark['time_unit']]
+        working_set = benchmark['bytes_per_second'] * seconds
+        level = next((n for n in sorted(levels) if working_set <= n * 3 * 4), max(levels))
+        level_bandwidth = levels[level]
+
+        achieved = benchmark['GFLOP']
+        intensity = benchmark['GFLOP'] * 1e9 / benchmark['bytes_per_second']
+        attainable = min(peak, intensity * level_bandwidth)
+        family = next(f for f, pattern in roofline_kernels.items() if re.match(pattern, name))
+        bound = 'memory' if intensity * level_bandwidth < peak else 'compute'
+        rows.append((family, name, intensity, achieved, attainable, bound, level_name(levels, level)))
+
+    print('Preparing plots.')
+    fig = plt.figure(figsize=(12, 8), facecolor=(13./255, 17./255, 23./255))
     ax = plt.gca()
     ax.set_facecolor((13./255, 17./255, 23./255))
 
-    plt.plot(x, y, color='aqua')
-
-    plt.xticks(rotation=90)
-    plt.ylim(0, None)
-    plt.title(test)
+    peak, levels = ceilings(1)
+    intensities = [r[2] for r in rows] + [peak / bw for bw in levels.values()]
+    x_min, x_max = min(intensities) / 4, max(intensities) * 4
+    for n, bw in sorted(levels.items()):
+        label = level_name(levels, n)
+        ridge = peak / bw
+        plt.plot([x_min, ridge, x_max], [bw * x_min, peak, peak], '--' if n != max(levels) else '-', label=f'{label}: {bw:.1f} GB/s')
+    plt.axhline(peak, color='white', linewidth=0.5, label=f'peak (1 thread): {peak:.2f} GFLOP/s')
+
+    for family in roofline_kernels:
+        points = [r for r in rows if r[0] == family]
+        if points:
+            plt.scatter([r[2] for r in points], [r[3] for r in points], label=family, s=12)
+
+    plt.xscale('log')
+    plt.yscale('log')
+    plt.xlabel('arithmetic intensity [FLOP/byte]')
+    plt.ylabel('performance [GFLOP/s]')
+    plt.title('roofline')
     plt.grid('both')
-    plt.savefig(os.path.join(perf_test_plots_path, test + '.png'), dpi=300, bbox_inches='tight', facecolor=fig.get_facecolor())
+    plt.legend()
+    plt.savefig(os.path.join(perf_test_plots_path, 'roofline.png'), dpi=300, bbox_inches='tight', facecolor=fig.get_facecolor())
     plt.clf()
 
-remote_url = repo.remotes.origin.url
+    print('Creating report.')
+    with open(os.path.join(perf_report_path, 'roofline.md'), 'w') as report_file:
+        report_file.write('![roofline](plots/roofline.png)\n\n')
+        report_file.write('| kernel | FLOP/byte | GFLOP/s | memory level | attainable GFLOP/s | % of roof | bound |\n')
+        report_file.write('|---|---|---|---|---|---|---|\n')
+        for family, name, intensity, achieved, attainable, bound, level in sorted(rows):
+            report_file.write(f'| {name} | {intensity:.3f} | {achieved:.3f} | {level} | {attainable:.3f} | {100.0 * achieved / attainable:.1f} | {bound} |\n')
+
+    print('All done.')
+
 
-print(remote_url)
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Runs performance tests and generates the report.')
+    parser.add_argument('--roofline', action='store_true', help='characterise kernels against measured machine peaks instead of the commit history')
+    args = parser.parse_args()
 
-print('Creating report.')
-with open(os.path.join(perf_report_path, 'report.md'), 'w') as report_file:
-    for test in sorted(all_tests):
-        report_file.write(f'![{test}]({remote_url}/blob/master/Build/{perf_test_plots_path}/{test}.png)\n')
+    os.system(r'./build_release_sse.sh')
 
-print('All done.')
+    if args.roofline:
+        roofline_report()
+    else:
+        history_report()
\ No newline at end of file
@@ -0,0 +1,275 @@
+#!/usr/bin/env python3
+
+import argparse
+import json
+import math
+import os
+import subprocess
+import tempfile
+import time
+
+perf_report_path = r'./performance_report/'
+perf_test_path = r'../tests/performance_tests/Build/Linux/Release/NeuralNetwork_performance_tests'
+perf_baseline_path = perf_report_path + r'baseline.json'
+
+time_unit_ns = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+
+
+# Student's t distribution, needed for confidence intervals and Welch's test
+
+def betacf(a, b, x):
+    # continued fraction of the incomplete beta function (Lentz's method)
+    tiny = 1e-30
+    qab = a + b
+    qap = a + 1.0
+    qam = a - 1.0
+    c = 1.0
+    d = 1.0 - qab * x / qap
+    d = tiny if abs(d) < tiny else d
+    d = 1.0 / d
+    h = d
+    for m in range(1, 300):
+        m2 = 2 * m
+        aa = m * (b - m) * x / ((qam + m2) * (a + m2))
+        d = 1.0 + aa * d
+        d = tiny if abs(d) < tiny else d
+        c = 1.0 + aa / c
+        c = tiny if abs(c) < tiny else c
+        d = 1.0 / d
+        h *= d * c
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2))
+        d = 1.0 + aa * d
+        d = tiny if abs(d) < tiny else d
+        c = 1.0 + aa / c
+        c = tiny if abs(c) < tiny else c
+        d = 1.0 / d
+        delta = d * c
+        h *= delta
+        if abs(delta - 1.0) < 1e-12:
+            break
+    return h
+
+
+def betainc(a, b, x):
+    # regularized incomplete beta function I_x(a, b)
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    ln_front = math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b) + a * math.log(x) + b * math.log(1.0 - x)
+    if x < (a + 1.0) / (a + b + 2.0):
+        return math.exp(ln_front) * betacf(a, b, x) / a
+    return 1.0 - math.exp(ln_front) * betacf(b, a, 1.0 - x) / b
+
+
+def t_two_sided_p(t, df):
+    return betainc(df / 2.0, 0.5, df / (df + t * t))
+
+
+def t_quantile(p, df):
+    # t value with two-sided tail probability 1 - p, found by bisection
+    low, high = 0.0, 1e3
+    for _ in range(200):
+        mid = (low + high) / 2.0
+        if t_two_sided_p(mid, df) > 1.0 - p:
+            low = mid
+        else:
+            high = mid
+    return (low + high) / 2.0
+
+
+def summarize(samples, confidence):
+    n = len(samples)
+    mean = sum(samples) / n
+    stdev = math.sqrt(sum((s - mean) ** 2 for s in samples) / (n - 1)) if n > 1 else 0.0
+    half_width = t_quantile(confidence, n - 1) * stdev / math.sqrt(n) if n > 1 else 0.0
+    return {
+        'samples': samples,
+        'mean': mean,
+        'stdev': stdev,
+        'ci_low': mean - half_width,
+        'ci_high': mean + half_width,
+    }
+
+
+def welch_test(baseline, candidate):
+    n1, n2 = len(baseline['samples']), len(candidate['samples'])
+    if n1 < 2 or n2 < 2:
+        return 1.0
+    v1 = baseline['stdev'] ** 2 / n1
+    v2 = candidate['stdev'] ** 2 / n2
+    if v1 + v2 == 0.0:
+        return 0.0 if baseline['mean'] != candidate['mean'] else 1.0
+    t = (candidate['mean'] - baseline['mean']) / math.sqrt(v1 + v2)
+    df = (v1 + v2) ** 2 / (v1 ** 2 / (n1 - 1) + v2 ** 2 / (n2 - 1))
+    return t_two_sided_p(abs(t), df)
+
+
+# running benchmarks
+
+def current_commit():
+    try:
+        return subprocess.check_output(['git', 'rev-parse', 'HEAD'], cwd='..', text=True).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return 'unknown'
+
+
+def run_benchmarks(binary, repetitions, benchmark_filter, min_time, confidence):
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        out_path = os.path.join(tmp_dir, 'result.json')
+        command = [binary,
+                   f'--benchmark_repetitions={repetitions}',
+                   f'--benchmark_out={out_path}',
+                   '--benchmark_out_format=json']
+        if benchmark_filter:
+            command.append(f'--benchmark_filter={benchmark_filter}')
+        if min_time:
+            command.append(f'--benchmark_min_time={min_time}')
+
+        print(f'Running {" ".join(command)}')
+        if subprocess.call(command, stdout=subprocess.DEVNULL) != 0:
+            print('Performance tests failed.')
+            exit(2)
+
+        with open(out_path, 'r') as out_file:
+            raw = json.load(out_file)
+
+    samples = {}
+    for benchmark in raw['benchmarks']:
+        if benchmark.get('run_type', 'iteration') != 'iteration':
+            continue
+        name = benchmark.get('run_name', benchmark['name'])
+        samples.setdefault(name, []).append(benchmark['real_time'] * time_unit_ns[benchmark['time_unit']])
+
+    return {
+        'commit': current_commit(),
+        'date': time.strftime('%Y-%m-%d %H:%M:%S'),
+        'repetitions': repetitions,
+        'confidence': confidence,
+        'time_unit': 'ns',
+        'context': raw.get('context', {}),
+        'benchmarks': {name: summarize(values, confidence) for name, values in samples.items()},
+    }
+
+
+# comparing results
+
+def format_time(ns):
+    for unit, scale in (('s', 1e9), ('ms', 1e6), ('us', 1e3)):
+        if ns >= scale:
+            return f'{ns / scale:.3f} {unit}'
+    return f'{ns:.1f} ns'
+
+
+def compare(baseline, candidate, threshold, alpha):
+    rows = []
+    regressions = 0
+
+    for name in sorted(set(baseline['benchmarks']) | set(candidate['benchmarks'])):
+        base = baseline['benchmarks'].get(name)
+        cand = candidate['benchmarks'].get(name)
+        if base is None:
+            rows.append((name, '-', format_time(cand['mean']), '-', '-', 'new'))
+            continue
+        if cand is None:
+            rows.append((name, format_time(base['mean']), '-', '-', '-', 'missing'))
+            continue
+
+        change = (cand['mean'] - base['mean']) / base['mean'] * 100.0
+        p = welch_test(base, cand)
+        significant = p < alpha and abs(change) > threshold
+
+        if significant and change > 0.0:
+            status = 'REGRESSION'
+            regressions += 1
+        elif significant:
+            status = 'improvement'
+        else:
+            status = 'ok'
+
+        base_text = f'{format_time(base["mean"])} +- {format_time((base["ci_high"] - base["ci_low"]) / 2.0)}'
+        cand_text = f'{format_time(cand["mean"])} +- {format_time((cand["ci_high"] - cand["ci_low"]) / 2.0)}'
+        rows.append((name, base_text, cand_text, f'{change:+.2f}%', f'{p:.4f}', status))
+
+    header = ('benchmark', 'baseline', 'candidate', 'change', 'p-value', 'status')
+    widths = [max(len(str(row[i])) for row in rows + [header]) for i in range(len(header))]
+    line = '  '.join('-' * w for w in widths)
+
+    print(f'baseline:  {baseline["commit"]} ({baseline["date"]})')
+    print(f'candidate: {candidate["commit"]} ({candidate["date"]})')
+    print(f'threshold: {threshold}%, significance level: {alpha}')
+    print(line)
+    print('  '.join(str(h).ljust(w) for h, w in zip(header, widths)))
+    print(line)
+    for row in rows:
+        print('  '.join(str(c).ljust(w) for c, w in zip(row, widths)))
+    print(line)
+    print(f'{regressions} regression(s) found.')
+
+    return regressions
+
+
+def load(path):
+    with open(path, 'r') as result_file:
+        return json.load(result_file)
+
+
+def save(result, path):
+    os.makedirs(os.path.dirname(os.path.abspath(path)), exist_ok=True)
+    with open(path, 'w') as result_file:
+        json.dump(result, result_file, indent=2)
+    print(f'Results saved to {path}')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Runs performance tests with repetitions and compares them against a baseline.')
+    parser.add_argument('--binary', default=perf_test_path, help='performance tests binary')
+    parser.add_argument('--build', action='store_true', help='build release SSE configuration first')
+    parser.add_argument('--repetitions', type=int, default=10)
+    parser.add_argument('--filter', default='', help='benchmark filter regex')
+    parser.add_argument('--min-time', type=float, default=0.0, help='minimal time of one repetition in seconds')
+    parser.add_argument('--confidence', type=float, default=0.95)
+    parser.add_argument('--threshold', type=float, default=5.0, help='relative slowdown in percent treated as regression')
+    parser.add_argument('--alpha', type=float, default=0.05, help='significance level of Welch\'s t-test')
+
+    commands = parser.add_subparsers(dest='command', required=True)
+    run_parser = commands.add_parser('run', help='run benchmarks and store results')
+    run_parser.add_argument('output', nargs='?', default=None)
+    baseline_parser = commands.add_parser('baseline', help='run benchmarks and store them as the baseline')
+    baseline_parser.add_argument('output', nargs='?', default=perf_baseline_path)
+    compare_parser = commands.add_parser('compare', help='compare two stored results')
+    compare_parser.add_argument('baseline')
+    compare_parser.add_argument('candidate')
+    check_parser = commands.add_parser('check', help='run benchmarks and compare them against the baseline')
+    check_parser.add_argument('baseline', nargs='?', default=perf_baseline_path)
+    check_parser.add_argument('--output', default=None, help='also store candidate results')
+
+    args = parser.parse_args()
+
+    if args.build and args.command != 'compare':
+        os.system(r'./build_release_sse.sh')
+
+    if args.command == 'compare':
+        regressions = compare(load(args.baseline), load(args.candidate), args.threshold, args.alpha)
+        exit(1 if regressions > 0 else 0)
+
+    if args.command == 'check' and not os.path.isfile(args.baseline):
+        print(f'Baseline {args.baseline} not found, create it with the "baseline" command.')
+        exit(2)
+
+    result = run_benchmarks(args.binary, args.repetitions, args.filter, args.min_time, args.confidence)
+
+    if args.command == 'run':
+        output = args.output or os.path.join(perf_report_path, 'runs', f'{result["commit"]}.json')
+        save(result, output)
+    elif args.command == 'baseline':
+        save(result, args.output)
+    else:
+        if args.output:
+            save(result, args.output)
+        regressions = compare(load(args.baseline), result, args.threshold, args.alpha)
+        exit(1 if regressions > 0 else 0)
+
+
+if __name__ == '__main__':
+    main()
\ No newline at end of file
@@ -163,19 +163,11 @@ int main(int argc , char** argv) {
         Tensor batch_x = test_data.slice(0, i*batch_size, (i + 1)*batch_size);
         Tensor batch_y = test_labels.slice(0, i*batch_size, (i + 1)*batch_size);
 
-        Tensor pred_label = nn.predict(batch_x);
+        std::vector<float> pred_labels = nn.predict(batch_x).argmax(1).getData();
+        std::vector<float> true_labels = batch_y.argmax(1).getData();
 
         for (uint32_t j{ 0 }; j < batch_size; ++j) {
-            float max_val{ -1.0f };
-            uint32_t max_idx{ 0 };
-            for (uint32_t k{ 0 }; k < pred_label.getShape()[1]; ++k)
-            {
-                if (max_val < 0 || max_val < pred_label.getValue({ j, k })) {
-                    max_val = pred_label.getValue({ j, k });
-                    max_idx = k;
-                }
-            }
-            if (batch_y.getValue({ j, max_idx }) > 0.0f) {
+            if (pred_labels[j] == true_labels[j]) {
                 ++valid_cnt;
             }
         }
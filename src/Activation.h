@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cmath>
+
+enum class ActivationFun {
+	Sigmoid,
+	ReLU,
+	LeakyReLU
+};
+
+// Scalar activations used by fused layer kernels.
+// Derivatives take the activation output, so backward propagation needs only the cached output.
+struct IdentityActivation {
+	static float forward(float x) { return x; }
+	static float derivative(float) { return 1.0f; }
+};
+
+struct ReLUActivation {
+	static float forward(float x) { return x > 0.0f ? x : 0.0f; }
+	static float derivative(float y) { return y > 0.0f ? 1.0f : 0.0f; }
+};
+
+struct LeakyReLUActivation {
+	static float forward(float x) { return x > 0.0f ? x : x * 0.1f; }
+	static float derivative(float y) { return y > 0.0f ? 1.0f : 0.1f; }
+};
+
+struct SigmoidActivation {
+	static float forward(float x) { return 1.0f / (1.0f + expf(-x)); }
+	static float derivative(float y) { return y * (1.0f - y); }
+};
\ No newline at end of file
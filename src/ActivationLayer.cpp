@@ -1,4 +1,5 @@
 #include "ActivationLayer.h"
+#include "TensorKernels.h"
 
 ActivationLayer::ActivationLayer(std::vector<uint32_t> input_shape, const Tensor (*activation_fun)(const Tensor&), const Tensor (*activation_fun_d)(const Tensor&, const Tensor&)) : Layer() {
 	_input_shape = input_shape;
@@ -34,6 +35,8 @@ void ActivationLayer::initActivationFun(const Tensor (*activation_fun)(const Ten
 }
 
 void ActivationLayer::initActivationFun(ActivationFun activation_fun) {
+	_has_activation_type = true;
+	_activation_type = activation_fun;
 	switch (activation_fun) {
 	case ActivationFun::Sigmoid:
 		_activation_fun = Sigmoid_fun;
@@ -55,14 +58,45 @@ void ActivationLayer::initActivationFun(ActivationFun activation_fun) {
 }
 
 const Tensor ActivationLayer::forwardPropagation(const Tensor& x) {
-	_cached_input = Tensor(x);
+	if (_pass_through) {
+		return x;
+	}
+	cacheInput(x);
 	Tensor result = _activation_fun(x);
-	_cached_output = Tensor(result);
+	cacheOutput(result);
 	return result;
 }
 
+void ActivationLayer::infer(const Tensor& x, Tensor& result) const {
+	if (_pass_through) {
+		result = x;
+		return;
+	}
+	if (!_has_activation_type) {
+		result = _activation_fun(x);
+		return;
+	}
+
+	prepareResult(result, x.getShape());
+	switch (_activation_type) {
+	case ActivationFun::Sigmoid:
+		kernels::activationKernel<float, SigmoidActivation>(x.getSize(), x.getDataPtr(), result.getDataPtr());
+		break;
+	case ActivationFun::ReLU:
+		kernels::activationKernel<float, ReLUActivation>(x.getSize(), x.getDataPtr(), result.getDataPtr());
+		break;
+	case ActivationFun::LeakyReLU:
+		kernels::activationKernel<float, LeakyReLUActivation>(x.getSize(), x.getDataPtr(), result.getDataPtr());
+		break;
+	}
+}
+
 const Tensor ActivationLayer::backwardPropagation(const Tensor& dx) {
-	Tensor result = _activation_fun_d(_cached_input, dx);
+	if (_pass_through) {
+		return dx;
+	}
+	Tensor cached_input_storage;
+	Tensor result = _activation_fun_d(restoreCachedInput(cached_input_storage), dx);
 	return result;
 }
 
@@ -75,7 +109,7 @@ void ActivationLayer::initCachedGradient() {
 }
 
 void ActivationLayer::summary() const {
-	printf("Activation Layer\n");
+	printf(_pass_through ? "Activation Layer (fused)\n" : "Activation Layer\n");
 	printf("  in shape:  (*");
 	for (uint32_t i{ 0u }; i < _input_shape.size(); ++i) {
 		printf(", %d", _input_shape[i]);
@@ -92,6 +126,20 @@ uint32_t ActivationLayer::getParamsCount() const {
 	return 0;
 }
 
+bool ActivationLayer::getFusableActivation(ActivationFun& activation_fun) const {
+	// layers with custom activation functions are never fused
+	activation_fun = _activation_type;
+	return _has_activation_type;
+}
+
+void ActivationLayer::setPassThrough(bool pass_through) {
+	// previous layer applies the activation, cached tensors are not needed anymore
+	_pass_through = pass_through;
+	if (_pass_through) {
+		setPrecision(_cache_dtype);
+	}
+}
+
 const Tensor ActivationLayer::ReLU_fun(const Tensor& x) {
 	return x * (x > 0.0f);
 }
@@ -5,12 +5,7 @@
 #include <cmath>
 
 #include "Layer.h"
-
-enum class ActivationFun {
-	Sigmoid,
-	ReLU,
-	LeakyReLU
-};
+#include "Activation.h"
 
 class ActivationLayer : public Layer {
 public:
@@ -20,13 +15,20 @@ public:
 	ActivationLayer(Layer& prev_layer, ActivationFun activation_fun);
 
 	virtual const Tensor forwardPropagation(const Tensor& x);
+	virtual void infer(const Tensor& x, Tensor& result) const;
 	virtual const Tensor backwardPropagation(const Tensor& dx);
 	virtual void updateWeights(float learning_step);
 	virtual void initCachedGradient();
 	virtual void summary() const;
 	virtual uint32_t getParamsCount() const;
+	virtual bool getFusableActivation(ActivationFun& activation_fun) const;
+	virtual void setPassThrough(bool pass_through);
 
 private:
+	bool _has_activation_type{ false };
+	ActivationFun _activation_type;
+	bool _pass_through{ false };
+
 	void initActivationFun(const Tensor (*activation_fun)(const Tensor&), const Tensor (*activation_fun_d)(const Tensor&, const Tensor&));
 	void initActivationFun(ActivationFun activation_fun);
 	const Tensor (*_activation_fun)(const Tensor&);
@@ -0,0 +1,143 @@
+#include "BatchNormLayer.h"
+#include "TensorKernels.h"
+
+BatchNormLayer::BatchNormLayer(std::vector<uint32_t> input_shape, float momentum, float epsilon) : Layer() {
+	_input_shape = input_shape;
+	_output_shape = input_shape;
+	initParams(momentum, epsilon);
+}
+
+BatchNormLayer::BatchNormLayer(Layer& prev_layer, float momentum, float epsilon) : Layer() {
+	_input_shape = prev_layer.getOutputShape();
+	_output_shape = prev_layer.getOutputShape();
+	initParams(momentum, epsilon);
+	this->setPrevLayer(&prev_layer);
+	prev_layer.setNextLayer(this);
+}
+
+void BatchNormLayer::setGamma(std::vector<float> gamma) {
+	_gamma.setValues(gamma);
+}
+
+void BatchNormLayer::setBeta(std::vector<float> beta) {
+	_beta.setValues(beta);
+}
+
+void BatchNormLayer::initParams(float momentum, float epsilon) {
+	if (_input_shape.empty() || (momentum < 0.0f) || (momentum > 1.0f) || (epsilon <= 0.0f)) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	_channels = _input_shape.back();
+	_momentum = momentum;
+	_epsilon = epsilon;
+
+	_gamma = Tensor({ _channels }) + 1.0f;
+	_beta = Tensor({ _channels });
+	_running_mean = Tensor({ _channels });
+	_running_variance = Tensor({ _channels }) + 1.0f;
+}
+
+void BatchNormLayer::initCachedGradient() {
+	_cached_gamma_d = Tensor(_gamma.getShape());
+	_cached_beta_d = Tensor(_beta.getShape());
+	_samples = 0;
+}
+
+void BatchNormLayer::summary() const {
+	printf(_pass_through ? "BatchNorm Layer (folded)\n" : "BatchNorm Layer\n");
+	printf("  in shape:  (*");
+	for (uint32_t i{ 0u }; i < _input_shape.size(); ++i) {
+		printf(", %d", _input_shape[i]);
+	}
+	printf(")  ");
+	printf("  out shape: (*");
+	for (uint32_t i { 0u }; i < _output_shape.size(); ++i) {
+		printf(", %d", _output_shape[i]);
+	}
+	printf(")  total params: %d  non-trainable: %d\n", getParamsCount(), _running_mean.getSize() + _running_variance.getSize());
+}
+
+uint32_t BatchNormLayer::getParamsCount() const {
+	// running statistics are not trained, summary reports them separately
+	return _gamma.getSize() + _beta.getSize();
+}
+
+void BatchNormLayer::updateWeights(float learning_step) {
+	_gamma -= _cached_gamma_d * learning_step / _samples;
+	_beta -= _cached_beta_d * learning_step / _samples;
+}
+
+bool BatchNormLayer::getFoldableScaleShift(Tensor& scale, Tensor& shift) const {
+	// gamma * (x - mean) / sqrt(variance + epsilon) + beta = x * scale + shift
+	scale = Tensor({ _channels });
+	shift = Tensor({ _channels });
+	for (uint32_t ch{ 0 }; ch < _channels; ++ch) {
+		float s = _gamma.getDataPtr()[ch] / sqrtf(_running_variance.getDataPtr()[ch] + _epsilon);
+		scale.getDataPtr()[ch] = s;
+		shift.getDataPtr()[ch] = _beta.getDataPtr()[ch] - _running_mean.getDataPtr()[ch] * s;
+	}
+	return true;
+}
+
+void BatchNormLayer::setPassThrough(bool pass_through) {
+	_pass_through = pass_through;
+}
+
+const Tensor BatchNormLayer::forwardPropagation(const Tensor& x) {
+	cacheInput(x);
+
+	uint32_t n = x.getSize() / _channels;
+	_batch_mean = Tensor({ _channels });
+	_batch_variance = Tensor({ _channels });
+	_batch_inv_std = Tensor({ _channels });
+	kernels::channelMomentsKernel<float>(n, _channels, x.getDataPtr(), _batch_mean.getDataPtr(), _batch_variance.getDataPtr());
+
+	Tensor scale = Tensor({ _channels });
+	Tensor shift = Tensor({ _channels });
+	for (uint32_t ch{ 0 }; ch < _channels; ++ch) {
+		float inv_std = 1.0f / sqrtf(_batch_variance.getDataPtr()[ch] + _epsilon);
+		_batch_inv_std.getDataPtr()[ch] = inv_std;
+		scale.getDataPtr()[ch] = _gamma.getDataPtr()[ch] * inv_std;
+		shift.getDataPtr()[ch] = _beta.getDataPtr()[ch] - _batch_mean.getDataPtr()[ch] * scale.getDataPtr()[ch];
+	}
+
+	Tensor x_next = Tensor(x.getShape());
+	kernels::channelScaleShiftKernel<float>(n, _channels, x.getDataPtr(), scale.getDataPtr(), shift.getDataPtr(), x_next.getDataPtr());
+
+	cacheOutput(x_next);
+
+	return x_next;
+}
+
+void BatchNormLayer::infer(const Tensor& x, Tensor& result) const {
+	if (_pass_through) {
+		result = x;
+		return;
+	}
+	Tensor scale, shift;
+	getFoldableScaleShift(scale, shift);
+
+	prepareResult(result, x.getShape());
+	kernels::channelScaleShiftKernel<float>(x.getSize() / _channels, _channels, x.getDataPtr(), scale.getDataPtr(), shift.getDataPtr(),
+											result.getDataPtr());
+}
+
+const Tensor BatchNormLayer::backwardPropagation(const Tensor& dx) {
+	Tensor cached_input_storage;
+	const Tensor& cached_input = restoreCachedInput(cached_input_storage);
+
+	Tensor dx_prev = Tensor(cached_input.getShape());
+
+	_samples += cached_input.getShape()[0];
+
+	kernels::batchNormBackwardKernel<float>(cached_input.getSize() / _channels, _channels, cached_input.getDataPtr(), dx.getDataPtr(),
+											_batch_mean.getDataPtr(), _batch_inv_std.getDataPtr(), _gamma.getDataPtr(),
+											dx_prev.getDataPtr(), _cached_gamma_d.getDataPtr(), _cached_beta_d.getDataPtr());
+
+	// running statistics are updated once per batch that reaches backward propagation,
+	// forward passes recomputed by gradient checkpointing do not count twice
+	_running_mean = _running_mean * _momentum + _batch_mean * (1.0f - _momentum);
+	_running_variance = _running_variance * _momentum + _batch_variance * (1.0f - _momentum);
+
+	return dx_prev;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+#include "Utils.h"
+#include "Layer.h"
+
+// normalizes every channel (last axis) of NHWC or flat inputs, with batch statistics during training
+// and running statistics during inference
+class BatchNormLayer : public Layer {
+public:
+	BatchNormLayer(std::vector<uint32_t> input_shape, float momentum = 0.99f, float epsilon = 1e-3f);
+	BatchNormLayer(Layer& prev_layer, float momentum = 0.99f, float epsilon = 1e-3f);
+
+	void setGamma(std::vector<float> gamma);
+	void setBeta(std::vector<float> beta);
+
+	virtual const Tensor forwardPropagation(const Tensor& x);
+	virtual void infer(const Tensor& x, Tensor& result) const;
+	virtual const Tensor backwardPropagation(const Tensor& dx);
+	virtual void updateWeights(float learning_step);
+	virtual void initCachedGradient();
+	virtual void summary() const;
+	virtual uint32_t getParamsCount() const;
+	virtual bool getFoldableScaleShift(Tensor& scale, Tensor& shift) const;
+	// previous layer applies the running statistics, only inference passes values through
+	virtual void setPassThrough(bool pass_through);
+
+private:
+	uint32_t _channels;
+	float _momentum;
+	float _epsilon;
+	Tensor _gamma;
+	Tensor _beta;
+	Tensor _running_mean;
+	Tensor _running_variance;
+	// statistics of the last forward propagated batch
+	Tensor _batch_mean;
+	Tensor _batch_variance;
+	Tensor _batch_inv_std;
+	uint32_t _samples;
+	Tensor _cached_gamma_d;
+	Tensor _cached_beta_d;
+	bool _pass_through{ false };
+
+	void initParams(float momentum, float epsilon);
+};
\ No newline at end of file
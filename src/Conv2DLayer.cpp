@@ -1,6 +1,7 @@
 #include "Conv2DLayer.h"
+#include "TensorKernels.h"
 
-Conv2DLayer::Conv2DLayer(std::vector<uint32_t> input_shape, uint32_t filters_count, uint32_t filter_size) : Layer() {
+Conv2DLayer::Conv2DLayer(std::vector<uint32_t> input_shape, uint32_t filters_count, uint32_t filter_size, const Conv2DParams& params) : Layer() {
 	_input_shape = input_shape;
 	if (2 == _input_shape.size()) {
 		_input_shape.push_back(1);
@@ -8,14 +9,11 @@ Conv2DLayer::Conv2DLayer(std::vector<uint32_t> input_shape, uint32_t filters_cou
 	else if (3 != _input_shape.size()) {
 		// exception
 	}
-	_output_shape = _input_shape;
-    _output_shape[_output_shape.size() - 1] = filters_count;
-	_filters_count = filters_count;
-	_filter_size = filter_size;
+	initGeometry(filters_count, filter_size, params);
 	initWeights(_input_shape, filters_count, filter_size);
 }
 
-Conv2DLayer::Conv2DLayer(Layer& prev_layer, uint32_t filters_count, uint32_t filter_size) : Layer() {
+Conv2DLayer::Conv2DLayer(Layer& prev_layer, uint32_t filters_count, uint32_t filter_size, const Conv2DParams& params) : Layer() {
 	_input_shape = prev_layer.getOutputShape();
 	if (2 == _input_shape.size()) {
 		_input_shape.push_back(1);
@@ -23,23 +21,81 @@ Conv2DLayer::Conv2DLayer(Layer& prev_layer, uint32_t filters_count, uint32_t fil
 	else if (3 != _input_shape.size()) {
 		// exception
 	}
-	_output_shape = _input_shape;
-    _output_shape[_output_shape.size() - 1] = filters_count;
-	_filters_count = filters_count;
-	_filter_size = filter_size;
+	initGeometry(filters_count, filter_size, params);
 	initWeights(_input_shape, filters_count, filter_size);
 	this->setPrevLayer(&prev_layer);
 	prev_layer.setNextLayer(this);
 }
 
+void Conv2DLayer::initGeometry(uint32_t filters_count, uint32_t filter_size, const Conv2DParams& params) {
+	_filters_count = filters_count;
+	_filter_size = filter_size;
+	_params = params;
+	_geometry = Tensor::conv2DGeometry(_input_shape, { filter_size, filter_size, _input_shape[2], filters_count }, _params);
+	_output_shape = { _geometry.out_h, _geometry.out_w, filters_count };
+}
+
 void Conv2DLayer::setWeights(std::vector<float> weights) {
 	_weights.setValues(weights);
+	updateTransformedWeights();
 }
 
 void Conv2DLayer::setBiases(std::vector<float> biases) {
 	_biases.setValues(biases);
 }
 
+void Conv2DLayer::setAlgorithm(ConvAlgorithm algorithm) {
+	// only 3x3 filters with stride and dilation 1 have a winograd path, any filters with stride and dilation 1 an FFT path
+	bool fft_supported = (1 == _params.stride) && (1 == _params.dilation);
+	bool winograd_supported = (3 == _filter_size) && fft_supported;
+	if ((ConvAlgorithm::Auto == algorithm) || ((ConvAlgorithm::Winograd == algorithm) && !winograd_supported) ||
+		((ConvAlgorithm::FFT == algorithm) && !fft_supported)) {
+		algorithm = selectAlgorithm(_input_shape, _filters_count, _filter_size, _params);
+	}
+	_algorithm = algorithm;
+	updateTransformedWeights();
+}
+
+ConvAlgorithm Conv2DLayer::getAlgorithm() const {
+	return _algorithm;
+}
+
+ConvAlgorithm Conv2DLayer::selectAlgorithm(const std::vector<uint32_t>& input_shape, uint32_t filters_count, uint32_t filter_size,
+											const Conv2DParams& params) {
+	uint32_t channels = input_shape[2];
+
+	// large filters: spectra products replace filter_size^2 multiply-adds per output, estimated in flops
+	if ((filter_size >= CONV2D_MIN_FFT_FILTER_SIZE) && (1 == params.stride) && (1 == params.dilation)) {
+		Conv2DGeometry g = Tensor::conv2DGeometry(input_shape, { filter_size, filter_size, channels, filters_count }, params);
+		uint32_t grid_h, grid_w;
+		kernels::fftConv2DGridSize(g, grid_h, grid_w);
+		double grid = static_cast<double>(grid_h) * grid_w;
+		double bins = static_cast<double>(grid_h) * (grid_w / 2 + 1);
+		double fft_flops = (channels + filters_count) * 2.5 * grid * log2(grid) + 8.0 * bins * channels * filters_count;
+		double direct_flops = 2.0 * g.out_h * g.out_w * filter_size * filter_size * channels * filters_count;
+		double spectra_bytes = bins * channels * filters_count * sizeof(Complex);
+		if ((fft_flops * CONV2D_FFT_COST_FACTOR < direct_flops) && (spectra_bytes <= CONV2D_MAX_FFT_SPECTRA_BYTES)) {
+			return ConvAlgorithm::FFT;
+		}
+	}
+
+	// few channels or filters leave too little work per transformed tile or copied patch,
+	// the direct kernel needs no extra memory there
+	if ((channels < CONV2D_MIN_TRANSFORM_CHANNELS) || (filters_count < CONV2D_MIN_TRANSFORM_FILTERS)) {
+		return ConvAlgorithm::Direct;
+	}
+	if ((3 == filter_size) && (1 == params.stride) && (1 == params.dilation)) {
+		return ConvAlgorithm::Winograd;
+	}
+	#ifdef SSE
+	// large patches pay for the copy with the SSE matrix product
+	if (filter_size * filter_size * channels >= CONV2D_MIN_IM2COL_PATCH) {
+		return ConvAlgorithm::Im2col;
+	}
+	#endif	// SSE
+	return ConvAlgorithm::Direct;
+}
+
 void Conv2DLayer::initWeights(std::vector<uint32_t> input_shape, uint32_t filters_count, uint32_t filter_size) {
 	_filters_count = filters_count;
 
@@ -50,6 +106,27 @@ void Conv2DLayer::initWeights(std::vector<uint32_t> input_shape, uint32_t filter
 	_biases = Tensor({ filters_count });
 
     _biases.applyFunction([](float value) {return randUniform(-1.0f, 1.0f) * sqrtf(6.0f); });
+
+	setAlgorithm(ConvAlgorithm::Auto);
+}
+
+void Conv2DLayer::updateTransformedWeights() {
+	_weights_winograd = (ConvAlgorithm::Winograd == _algorithm) ? Tensor::winogradFilter(_weights) : Tensor();
+	// filters as rows of the patch matrix product
+	_weights_im2col = (ConvAlgorithm::Im2col == _algorithm)
+		? _weights.reshape({ _filter_size * _filter_size * _input_shape[2], _filters_count }).transpose() : Tensor();
+	// filter spectra for the grid of the layer input size
+	if (ConvAlgorithm::FFT == _algorithm) {
+		uint32_t grid_h, grid_w;
+		kernels::fftConv2DGridSize(_geometry, grid_h, grid_w);
+		_fft = RealFFT2D(grid_h, grid_w);
+		_weights_fft.resize(_fft.getBinsCount() * _geometry.c * _geometry.f);
+		kernels::fftFilterTransformKernel(_geometry, _fft, _weights.getDataPtr(), _weights_fft.data());
+	}
+	else {
+		_fft = RealFFT2D();
+		std::vector<Complex>().swap(_weights_fft);
+	}
 }
 
 void Conv2DLayer::initCachedGradient() {
@@ -61,7 +138,8 @@ void Conv2DLayer::initCachedGradient() {
 }
 
 void Conv2DLayer::summary() const {
-	printf("Conv2D Layer\n");
+	printf(_quantized ? "Conv2D Layer (int8)" : "Conv2D Layer");
+	printf(_folded ? " (folded scale shift)\n" : "\n");
 	printf("  in shape:  (*");
 	for (uint32_t i{ 0u }; i < _input_shape.size(); ++i) {
 		printf(", %d", _input_shape[i]);
@@ -71,7 +149,7 @@ void Conv2DLayer::summary() const {
 	for (uint32_t i { 0u }; i < _output_shape.size(); ++i) {
 		printf(", %d", _output_shape[i]);
 	}
-	printf(")  total params: %d\n", _weights.getSize() + _biases.getSize());
+	printf(")  stride: %d  dilation: %d  total params: %d\n", _params.stride, _params.dilation, _weights.getSize() + _biases.getSize());
 }
 
 uint32_t Conv2DLayer::getParamsCount() const {
@@ -81,72 +159,129 @@ uint32_t Conv2DLayer::getParamsCount() const {
 void Conv2DLayer::updateWeights(float learning_step) {
 	_weights -= _cached_weights_d * learning_step / _samples;
 	_biases -= _cached_biases_d * learning_step / _samples;
+
+	if (_quantized) {
+		_weights_quantized = QuantizedTensor(_weights, 3u);
+	}
+	updateTransformedWeights();
+}
+
+void Conv2DLayer::quantize(const Tensor& calibration_x) {
+	// one scale per filter for weights, one scale for inputs calibrated on sample data
+	_input_scale = QuantizedTensor::calibrateScale(calibration_x);
+	_weights_quantized = QuantizedTensor(_weights, 3u);
+	_quantized = true;
+}
+
+bool Conv2DLayer::foldScaleShift(const Tensor& scale, const Tensor& shift) {
+	// (x * weights + biases) * scale + shift = (x * weights) * scale + biases * scale + shift
+	_folded_scale = Tensor(scale);
+	_folded_biases = Tensor(_biases.getShape());
+	kernels::channelScaleShiftKernel<float>(1, _filters_count, _biases.getDataPtr(), scale.getDataPtr(), shift.getDataPtr(),
+											_folded_biases.getDataPtr());
+	_folded = true;
+	return true;
+}
+
+void Conv2DLayer::unfoldScaleShift() {
+	_folded = false;
+	_folded_scale.release();
+	_folded_biases.release();
 }
 
 const Tensor Conv2DLayer::forwardPropagation(const Tensor& x) {
-	_cached_input = Tensor(x);
+	cacheInput(x);
+
+	Tensor x_next;
+	forward(x, x_next, false);
 
+	cacheOutput(x_next);
+
+	return x_next;
+}
+
+void Conv2DLayer::infer(const Tensor& x, Tensor& result) const {
+	// folded scale and shift apply only to inference, training normalizes batches itself
+	forward(x, result, _folded);
+}
+
+void Conv2DLayer::forward(const Tensor& x, Tensor& result, bool folded) const {
 	std::vector<uint32_t> x_next_shape = _output_shape;
 	x_next_shape.insert(x_next_shape.begin(), x.getShape()[0]);
 
-	Tensor x_next = Tensor(x_next_shape);
+	prepareResult(result, x_next_shape);
 
-	for (uint32_t i{ 0 }; i < x.getShape()[0]; ++i) {
-		Tensor sub_tensor_x = x.getSubTensor({ i, WHOLE_AXIS, WHOLE_AXIS, WHOLE_AXIS });
-    	Tensor sub_tensor_x_next = sub_tensor_x.addPadding({ 0, 1 }, { Both, Both }, { (_filter_size - 1) / 2, (_filter_size - 1) / 2 }).Conv2D(_weights) + _biases;
-		x_next.setValuesOfSubTensor({i, WHOLE_AXIS, WHOLE_AXIS, WHOLE_AXIS }, sub_tensor_x_next);
-	}
+	// samples are convolved in place in the batch, padding is never materialized
+	const Conv2DGeometry& g = _geometry;
+	uint32_t x_size = g.h * g.w * g.c;
+	uint32_t x_next_size = g.out_h * g.out_w * g.f;
+	const float* x_ptr = x.getDataPtr();
+	float* result_ptr = result.getDataPtr();
 
-	_cached_output = Tensor(x_next);
+	if (_quantized) {
+		for (uint32_t i{ 0 }; i < x.getShape()[0]; ++i) {
+			Tensor sub_tensor_x = x.getSubTensor({ i, WHOLE_AXIS, WHOLE_AXIS, WHOLE_AXIS });
+			Tensor sub_tensor_x_next = QuantizedTensor::Conv2D(QuantizedTensor(sub_tensor_x, _input_scale), _weights_quantized, _params);
+			std::copy(sub_tensor_x_next.getDataPtr(), sub_tensor_x_next.getDataPtr() + x_next_size, result_ptr + i * x_next_size);
+		}
+	}
+	else if (ConvAlgorithm::Winograd == _algorithm) {
+		for (uint32_t i{ 0 }; i < x.getShape()[0]; ++i) {
+			kernels::winogradConv2DKernel<float>(g, x_ptr + i * x_size, _weights_winograd.getDataPtr(), result_ptr + i * x_next_size);
+		}
+	}
+	else if (ConvAlgorithm::FFT == _algorithm) {
+		for (uint32_t i{ 0 }; i < x.getShape()[0]; ++i) {
+			kernels::fftConv2DKernel(g, _fft, x_ptr + i * x_size, _weights_fft.data(), result_ptr + i * x_next_size);
+		}
+	}
+	else if (ConvAlgorithm::Im2col == _algorithm) {
+		Tensor cols = Tensor({ g.out_h * g.out_w, g.filter_h * g.filter_w * g.c });
+		for (uint32_t i{ 0 }; i < x.getShape()[0]; ++i) {
+			kernels::im2colKernel<float>(g, x_ptr + i * x_size, cols.getDataPtr());
+			Tensor sub_tensor_x_next = cols.dotProductTranspose(_weights_im2col);
+			std::copy(sub_tensor_x_next.getDataPtr(), sub_tensor_x_next.getDataPtr() + x_next_size, result_ptr + i * x_next_size);
+		}
+	}
+	else {
+		// result may hold a previous batch, the direct kernel accumulates
+		std::fill(result_ptr, result_ptr + result.getSize(), 0.0f);
+		for (uint32_t i{ 0 }; i < x.getShape()[0]; ++i) {
+			kernels::conv2DDirectKernel<float, float>(g, x_ptr + i * x_size, _weights.getDataPtr(), result_ptr + i * x_next_size);
+		}
+	}
 
-	return x_next;
+	if (folded) {
+		// convolution is linear in the weights, scaling its output costs the same pass as adding biases
+		kernels::channelScaleShiftKernel<float>(result.getSize() / g.f, g.f, result_ptr, _folded_scale.getDataPtr(),
+												_folded_biases.getDataPtr(), result_ptr);
+	}
+	else {
+		result += _biases;
+	}
 }
 
 const Tensor Conv2DLayer::backwardPropagation(const Tensor& dx) {
-	Tensor dx_prev = Tensor(_cached_input);
-	dx_prev *= 0.0f;
+	Tensor cached_input_storage;
+	const Tensor& cached_input = restoreCachedInput(cached_input_storage);
 
-	_samples += _cached_input.getShape()[0];
+	Tensor dx_prev = Tensor(cached_input.getShape());
 
-	Tensor weights_d = Tensor(_weights.getShape());
-	weights_d *= 0.0f;
-	Tensor biases_d = Tensor(_biases.getShape());
-	biases_d *= 0.0f;
+	_samples += cached_input.getShape()[0];
 
-	uint32_t padding_size = (_filter_size - 1) / 2;
+	// filters with swapped channel axes keep the input gradient loop over contiguous channels
+	Tensor weights_t = _weights.permute({ 0, 1, 3, 2 });
 
-	for (uint32_t i{ 0 }; i < dx.getShape()[0]; ++i) {
-		Tensor cached_input_pad = _cached_input.getSubTensor({ i, WHOLE_AXIS, WHOLE_AXIS, WHOLE_AXIS })
-											   .addPadding({ 0, 1 }, { Both, Both }, { padding_size, padding_size });
-		Tensor dx_prev_pad = dx_prev.getSubTensor({i, WHOLE_AXIS, WHOLE_AXIS, WHOLE_AXIS})
-									.addPadding({ 0, 1 }, { Both, Both }, { padding_size, padding_size });
-
-		for (uint32_t h{ 0 }; h < dx.getShape()[1]; ++h) {
-			for (uint32_t w{ 0 }; w < dx.getShape()[2]; ++w) {
-				for (uint32_t c{ 0 }; c < dx.getShape()[3]; ++c) {
-					Tensor sub_tensor = dx_prev_pad.getSubTensor({ { h, h + _filter_size }, { w, w + _filter_size }, {} });
-					sub_tensor += _weights.getSubTensor({ WHOLE_AXIS, WHOLE_AXIS, WHOLE_AXIS, c }) * dx.getValue({ i, h, w, c });
-					dx_prev_pad.setValuesOfSubTensor({ { h, h + _filter_size }, { w, w + _filter_size }, {} }, sub_tensor);
-
-					sub_tensor = weights_d.getSubTensor({ WHOLE_AXIS, WHOLE_AXIS, WHOLE_AXIS, c });
-					sub_tensor += cached_input_pad.getSubTensor({ { h, h + _filter_size }, { w, w + _filter_size }, {} }) * dx.getValue({ i, h, w, c });
-					weights_d.setValuesOfSubTensor({ WHOLE_AXIS, WHOLE_AXIS, WHOLE_AXIS, c }, sub_tensor);
-
-					float bias_c = biases_d.getValue({ c });
-					bias_c += dx.getValue({ i, h, w, c });
-					biases_d.setValue(bias_c, { c });
-				}
-			}
-		}
+	const Conv2DGeometry& g = _geometry;
+	uint32_t x_size = g.h * g.w * g.c;
+	uint32_t dx_size = g.out_h * g.out_w * g.f;
 
-		dx_prev.setValuesOfSubTensor({ i, WHOLE_AXIS, WHOLE_AXIS, WHOLE_AXIS },
-									 dx_prev_pad.getSubTensor({ { (_filter_size - 1) / 2, dx_prev_pad.getShape()[0] - (_filter_size - 1) / 2 },
-									 							{ (_filter_size - 1) / 2, dx_prev_pad.getShape()[1] - (_filter_size - 1) / 2 },
-																{} }));
+	for (uint32_t i{ 0 }; i < dx.getShape()[0]; ++i) {
+		const float* dx_sample = dx.getDataPtr() + i * dx_size;
+		kernels::conv2DBackwardInputKernel<float>(g, dx_sample, weights_t.getDataPtr(), dx_prev.getDataPtr() + i * x_size);
+		kernels::conv2DBackwardWeightsKernel<float>(g, cached_input.getDataPtr() + i * x_size, dx_sample,
+													_cached_weights_d.getDataPtr(), _cached_biases_d.getDataPtr());
 	}
 
-	_cached_weights_d += weights_d;
-	_cached_biases_d += biases_d;
-
 	return dx_prev;
 }
\ No newline at end of file
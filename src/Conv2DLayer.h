@@ -5,30 +5,75 @@
 
 #include "Utils.h"
 #include "Layer.h"
+#include "FFT.h"
+
+#define CONV2D_MIN_TRANSFORM_CHANNELS (16u)
+#define CONV2D_MIN_TRANSFORM_FILTERS (16u)
+#define CONV2D_MIN_IM2COL_PATCH (256u)
+#define CONV2D_MIN_FFT_FILTER_SIZE (5u)
+// FFT flops run at a lower rate than the register tiled direct kernel, measured crossover near 5x fewer flops
+#define CONV2D_FFT_COST_FACTOR (5.0)
+#define CONV2D_MAX_FFT_SPECTRA_BYTES (64u * 1024u * 1024u)
+
+enum class ConvAlgorithm : uint8_t {
+	Auto,
+	Direct,
+	Im2col,
+	Winograd,
+	FFT
+};
 
 class Conv2DLayer : public Layer {
 public:
-	Conv2DLayer(std::vector<uint32_t> input_shape, uint32_t filters_count, uint32_t filter_size);
-	Conv2DLayer(Layer& prev_layer, uint32_t filters_count, uint32_t filter_size);
+	// default keeps the input size, padding is applied virtually at the borders
+	Conv2DLayer(std::vector<uint32_t> input_shape, uint32_t filters_count, uint32_t filter_size, const Conv2DParams& params = { 1, 1, ConvPadding::Same });
+	Conv2DLayer(Layer& prev_layer, uint32_t filters_count, uint32_t filter_size, const Conv2DParams& params = { 1, 1, ConvPadding::Same });
 	
 	void setWeights(std::vector<float> weights);
 	void setBiases(std::vector<float> biases);
+	// Auto picks the algorithm for the layer shape, Winograd is only available for 3x3 filters with stride and dilation 1,
+	// FFT for any filter size with stride and dilation 1
+	void setAlgorithm(ConvAlgorithm algorithm);
+	ConvAlgorithm getAlgorithm() const;
+	static ConvAlgorithm selectAlgorithm(const std::vector<uint32_t>& input_shape, uint32_t filters_count, uint32_t filter_size,
+										 const Conv2DParams& params = Conv2DParams());
 
 	virtual const Tensor forwardPropagation(const Tensor& x);
+	virtual void infer(const Tensor& x, Tensor& result) const;
 	virtual const Tensor backwardPropagation(const Tensor& dx);
 	virtual void updateWeights(float learning_step);
 	virtual void initCachedGradient();
 	virtual void summary() const;
 	virtual uint32_t getParamsCount() const;
+	virtual void quantize(const Tensor& calibration_x);
+	virtual bool foldScaleShift(const Tensor& scale, const Tensor& shift);
+	virtual void unfoldScaleShift();
 
 private:
 	uint32_t _filters_count;
 	uint32_t _filter_size;
+	Conv2DParams _params;
+	Conv2DGeometry _geometry;
 	Tensor _weights;
 	Tensor _biases;
 	uint32_t _samples;
 	Tensor _cached_weights_d;
 	Tensor _cached_biases_d;
+	bool _quantized{ false };
+	float _input_scale;
+	QuantizedTensor _weights_quantized;
+	ConvAlgorithm _algorithm{ ConvAlgorithm::Direct };
+	Tensor _weights_winograd;
+	Tensor _weights_im2col;
+	RealFFT2D _fft;
+	std::vector<Complex> _weights_fft;
+	// inference output is scaled per filter in the bias pass, biases with the scale and shift applied
+	bool _folded{ false };
+	Tensor _folded_scale;
+	Tensor _folded_biases;
 
+	void initGeometry(uint32_t filters_count, uint32_t filter_size, const Conv2DParams& params);
 	void initWeights(std::vector<uint32_t> input_shape, uint32_t filters_count, uint32_t filter_size);
+	void updateTransformedWeights();
+	void forward(const Tensor& x, Tensor& result, bool folded) const;
 };
\ No newline at end of file
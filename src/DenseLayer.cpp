@@ -1,4 +1,5 @@
 #include "DenseLayer.h"
+#include "TensorKernels.h"
 
 DenseLayer::DenseLayer(std::vector<uint32_t> input_shape, uint32_t neurons_count) : Layer() {
 	_input_shape = input_shape;
@@ -58,7 +59,17 @@ void DenseLayer::initCachedGradient() {
 }
 
 void DenseLayer::summary() const {
-	printf("Dense Layer\n");
+	printf("Dense Layer");
+	if (_quantized) {
+		printf(" (int8)");
+	}
+	if (_fused_activation) {
+		printf(" (fused activation)");
+	}
+	if (_folded) {
+		printf(" (folded scale shift)");
+	}
+	printf("\n");
 	printf("  in shape:  (*");
 	for (uint32_t i{ 0u }; i < _input_shape.size(); ++i) {
 		printf(", %d", _input_shape[i]);
@@ -78,6 +89,35 @@ uint32_t DenseLayer::getParamsCount() const {
 void DenseLayer::updateWeights(float learning_step) {
 	_weights -= _cached_weights_d * learning_step / _samples;
 	_biases -= _cached_biases_d * learning_step / _samples;
+
+	if (DataType::Float32 != _cache_dtype) {
+		_weights_half = HalfTensor(_weights, _cache_dtype);
+	}
+	if (_quantized) {
+		_weights_quantized = QuantizedTensor(_weights, 0u);
+	}
+}
+
+void DenseLayer::quantize(const Tensor& calibration_x) {
+	// one scale per neuron for weights, one scale for inputs calibrated on sample data
+	_input_scale = QuantizedTensor::calibrateScale(calibration_x);
+	_weights_quantized = QuantizedTensor(_weights, 0u);
+	if (_folded) {
+		_folded_weights_quantized = QuantizedTensor(_folded_weights, 0u);
+	}
+	_quantized = true;
+}
+
+void DenseLayer::setPrecision(DataType dtype) {
+	Layer::setPrecision(dtype);
+
+	// _weights stay the fp32 master copy, forward propagation reads the reduced precision one
+	if (DataType::Float32 != dtype) {
+		_weights_half = HalfTensor(_weights, dtype);
+	}
+	else {
+		_weights_half = HalfTensor();
+	}
 }
 
 const Tensor DenseLayer::forwardPropagation(const Tensor& x) {
@@ -88,26 +128,173 @@ const Tensor DenseLayer::forwardPropagation(const Tensor& x) {
 	else {
 		x_next = Tensor(x);
 	}
-	_cached_input = Tensor(x_next);
-	x_next = _weights.dotProductTranspose(x_next).transpose() + _biases;
-	_cached_output = Tensor(x_next);
-	return x_next;
+	cacheInput(x_next);
+
+	Tensor result;
+	forward(x_next, result, false);
+	cacheOutput(result);
+	return result;
+}
+
+void DenseLayer::infer(const Tensor& x, Tensor& result) const {
+	// folded scale and shift apply only to inference, training normalizes batches itself
+	forward(x, result, _folded);
+}
+
+void DenseLayer::forward(const Tensor& x, Tensor& result, bool folded) const {
+	Tensor x_flatten_storage;
+	const Tensor& x_next = (x.getDim() > 2) ? (x_flatten_storage = x.flatten(1)) : x;
+	const Tensor& weights = folded ? _folded_weights : _weights;
+	const Tensor& biases = folded ? _folded_biases : _biases;
+
+	if (_quantized) {
+		result = QuantizedTensor::dotProductTranspose(QuantizedTensor(x_next, _input_scale), folded ? _folded_weights_quantized : _weights_quantized);
+		biasActivation(biases, result);
+	}
+	else if ((DataType::Float32 == _cache_dtype) || folded) {
+		prepareResult(result, { x_next.getShape()[0], _neurons_count });
+		denseForward(x_next, weights, biases, result);
+	}
+	else {
+		result = HalfTensor::dotProductTranspose(x_next, _weights_half);
+		biasActivation(biases, result);
+	}
 }
 
 const Tensor DenseLayer::backwardPropagation(const Tensor& dx) {
 	uint32_t n;
-	Tensor dx_prev = Tensor(dx);
+	Tensor cached_input_storage;
+	const Tensor& cached_input = restoreCachedInput(cached_input_storage);
 
-	n = _cached_input.getShape()[0];
+	n = cached_input.getShape()[0];
 	_samples += n;
 
-	Tensor weights_d = dx.transpose().dotProductTranspose(_cached_input.transpose());
-	Tensor biases_d = dx.sum(0);
+	// fused activation gradient is computed from cached output of this layer
+	Tensor dz;
+	if (_fused_activation) {
+		Tensor cached_output_storage;
+		dz = Tensor(dx.getShape());
+		activationBackward(restoreCachedOutput(cached_output_storage), dx, dz);
+	}
+	const Tensor& grad = _fused_activation ? dz : dx;
 
-	dx_prev = dx.dotProductTranspose(_weights.transpose());
+	Tensor weights_d = grad.dotProduct(cached_input, true, false);
+	Tensor biases_d = grad.sum(0);
+
+	Tensor dx_prev = grad.dotProduct(_weights, false, false);
 
 	_cached_weights_d += weights_d;
 	_cached_biases_d += biases_d;
 
 	return dx_prev;
+}
+
+bool DenseLayer::fuseActivation(ActivationFun activation_fun) {
+	_fused_activation = true;
+	_activation_fun = activation_fun;
+	return true;
+}
+
+void DenseLayer::unfuseActivation() {
+	_fused_activation = false;
+}
+
+bool DenseLayer::foldScaleShift(const Tensor& scale, const Tensor& shift) {
+	// (x . weights^T + biases) * scale + shift, rows of weights are scaled per neuron
+	if (_fused_activation) {
+		return false;
+	}
+	uint32_t k = _weights.getShape()[1];
+	const float* s = scale.getDataPtr();
+
+	_folded_weights = Tensor(_weights);
+	float* w = _folded_weights.getDataPtr();
+	for (uint32_t i{ 0 }; i < _neurons_count; ++i) {
+		for (uint32_t j{ 0 }; j < k; ++j) {
+			w[i * k + j] *= s[i];
+		}
+	}
+	_folded_biases = Tensor(_biases.getShape());
+	kernels::channelScaleShiftKernel<float>(1, _neurons_count, _biases.getDataPtr(), s, shift.getDataPtr(), _folded_biases.getDataPtr());
+
+	if (_quantized) {
+		_folded_weights_quantized = QuantizedTensor(_folded_weights, 0u);
+	}
+	_folded = true;
+	return true;
+}
+
+void DenseLayer::unfoldScaleShift() {
+	_folded = false;
+	_folded_weights.release();
+	_folded_biases.release();
+	_folded_weights_quantized = QuantizedTensor();
+}
+
+template <typename Activation>
+void DenseLayer::denseForwardKernel(const Tensor& x, const Tensor& weights, const Tensor& biases, Tensor& result) const {
+	uint32_t n = x.getShape()[0];
+	uint32_t k = x.getShape()[1];
+
+	#ifndef SSE
+	kernels::denseKernel<float, Activation>(n, _neurons_count, k, x.getDataPtr(), weights.getDataPtr(), biases.getDataPtr(), result.getDataPtr());
+	#else	// SSE
+	result = x.dotProductTranspose(weights);
+	kernels::biasActivationKernel<float, Activation>(n, _neurons_count, biases.getDataPtr(), result.getDataPtr());
+	#endif	// SSE
+}
+
+void DenseLayer::denseForward(const Tensor& x, const Tensor& weights, const Tensor& biases, Tensor& result) const {
+	if (!_fused_activation) {
+		denseForwardKernel<IdentityActivation>(x, weights, biases, result);
+		return;
+	}
+
+	switch (_activation_fun) {
+	case ActivationFun::Sigmoid:
+		denseForwardKernel<SigmoidActivation>(x, weights, biases, result);
+		break;
+	case ActivationFun::ReLU:
+		denseForwardKernel<ReLUActivation>(x, weights, biases, result);
+		break;
+	case ActivationFun::LeakyReLU:
+		denseForwardKernel<LeakyReLUActivation>(x, weights, biases, result);
+		break;
+	}
+}
+
+void DenseLayer::biasActivation(const Tensor& biases, Tensor& result) const {
+	uint32_t n = result.getShape()[0];
+	float* r = result.getDataPtr();
+
+	if (!_fused_activation) {
+		kernels::biasActivationKernel<float, IdentityActivation>(n, _neurons_count, biases.getDataPtr(), r);
+		return;
+	}
+
+	switch (_activation_fun) {
+	case ActivationFun::Sigmoid:
+		kernels::biasActivationKernel<float, SigmoidActivation>(n, _neurons_count, biases.getDataPtr(), r);
+		break;
+	case ActivationFun::ReLU:
+		kernels::biasActivationKernel<float, ReLUActivation>(n, _neurons_count, biases.getDataPtr(), r);
+		break;
+	case ActivationFun::LeakyReLU:
+		kernels::biasActivationKernel<float, LeakyReLUActivation>(n, _neurons_count, biases.getDataPtr(), r);
+		break;
+	}
+}
+
+void DenseLayer::activationBackward(const Tensor& y, const Tensor& dx, Tensor& result) const {
+	switch (_activation_fun) {
+	case ActivationFun::Sigmoid:
+		kernels::activationBackwardKernel<float, SigmoidActivation>(y.getSize(), y.getDataPtr(), dx.getDataPtr(), result.getDataPtr());
+		break;
+	case ActivationFun::ReLU:
+		kernels::activationBackwardKernel<float, ReLUActivation>(y.getSize(), y.getDataPtr(), dx.getDataPtr(), result.getDataPtr());
+		break;
+	case ActivationFun::LeakyReLU:
+		kernels::activationBackwardKernel<float, LeakyReLUActivation>(y.getSize(), y.getDataPtr(), dx.getDataPtr(), result.getDataPtr());
+		break;
+	}
 }
\ No newline at end of file
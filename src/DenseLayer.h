@@ -15,11 +15,18 @@ public:
 	void setBiases(std::vector<float> biases);
 
 	virtual const Tensor forwardPropagation(const Tensor& x);
+	virtual void infer(const Tensor& x, Tensor& result) const;
 	virtual const Tensor backwardPropagation(const Tensor& dx);
 	virtual void updateWeights(float learning_step);
 	virtual void initCachedGradient();
 	virtual void summary() const;
 	virtual uint32_t getParamsCount() const;
+	virtual void setPrecision(DataType dtype);
+	virtual void quantize(const Tensor& calibration_x);
+	virtual bool fuseActivation(ActivationFun activation_fun);
+	virtual void unfuseActivation();
+	virtual bool foldScaleShift(const Tensor& scale, const Tensor& shift);
+	virtual void unfoldScaleShift();
 
 private:
 	uint32_t _neurons_count;
@@ -28,6 +35,24 @@ private:
 	uint32_t _samples;
 	Tensor _cached_weights_d;
 	Tensor _cached_biases_d;
+	bool _quantized{ false };
+	float _input_scale;
+	QuantizedTensor _weights_quantized;
+	HalfTensor _weights_half;
+	bool _fused_activation{ false };
+	ActivationFun _activation_fun;
+	// inference weights with the following scale and shift applied
+	bool _folded{ false };
+	Tensor _folded_weights;
+	Tensor _folded_biases;
+	QuantizedTensor _folded_weights_quantized;
 
 	void initWeights(std::vector<uint32_t> input_shape, uint32_t neurons_count);
+	void forward(const Tensor& x, Tensor& result, bool folded) const;
+	void denseForward(const Tensor& x, const Tensor& weights, const Tensor& biases, Tensor& result) const;
+	void biasActivation(const Tensor& biases, Tensor& result) const;
+	void activationBackward(const Tensor& y, const Tensor& dx, Tensor& result) const;
+
+	template <typename Activation>
+	void denseForwardKernel(const Tensor& x, const Tensor& weights, const Tensor& biases, Tensor& result) const;
 };
\ No newline at end of file
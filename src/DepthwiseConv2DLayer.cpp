@@ -0,0 +1,126 @@
+#include "DepthwiseConv2DLayer.h"
+#include "TensorKernels.h"
+
+DepthwiseConv2DLayer::DepthwiseConv2DLayer(std::vector<uint32_t> input_shape, uint32_t filter_size, const Conv2DParams& params) : Layer() {
+	_input_shape = input_shape;
+	if (2 == _input_shape.size()) {
+		_input_shape.push_back(1);
+	}
+	else if (3 != _input_shape.size()) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	initWeights(filter_size, params);
+}
+
+DepthwiseConv2DLayer::DepthwiseConv2DLayer(Layer& prev_layer, uint32_t filter_size, const Conv2DParams& params) : Layer() {
+	_input_shape = prev_layer.getOutputShape();
+	if (2 == _input_shape.size()) {
+		_input_shape.push_back(1);
+	}
+	else if (3 != _input_shape.size()) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	initWeights(filter_size, params);
+	this->setPrevLayer(&prev_layer);
+	prev_layer.setNextLayer(this);
+}
+
+void DepthwiseConv2DLayer::setWeights(std::vector<float> weights) {
+	_weights.setValues(weights);
+}
+
+void DepthwiseConv2DLayer::setBiases(std::vector<float> biases) {
+	_biases.setValues(biases);
+}
+
+void DepthwiseConv2DLayer::initWeights(uint32_t filter_size, const Conv2DParams& params) {
+	uint32_t channels = _input_shape[2];
+
+	_filter_size = filter_size;
+	_params = params;
+	// every channel is its own filter, the geometry is the one of a convolution with as many filters as channels
+	_geometry = Tensor::conv2DGeometry(_input_shape, { filter_size, filter_size, channels, channels }, _params);
+	_output_shape = { _geometry.out_h, _geometry.out_w, channels };
+
+	_weights = Tensor({ filter_size, filter_size, channels }).applyFunction([](float value) { return randUniform(-1.0f, 1.0f); });
+	_weights *= sqrtf(6.0f / (filter_size * filter_size));
+
+	_biases = Tensor({ channels });
+}
+
+void DepthwiseConv2DLayer::initCachedGradient() {
+	_cached_weights_d = Tensor(_weights.getShape());
+	_cached_biases_d = Tensor(_biases.getShape());
+	_samples = 0;
+}
+
+void DepthwiseConv2DLayer::summary() const {
+	printf("DepthwiseConv2D Layer\n");
+	printf("  in shape:  (*");
+	for (uint32_t i{ 0u }; i < _input_shape.size(); ++i) {
+		printf(", %d", _input_shape[i]);
+	}
+	printf(")  ");
+	printf("  out shape: (*");
+	for (uint32_t i { 0u }; i < _output_shape.size(); ++i) {
+		printf(", %d", _output_shape[i]);
+	}
+	printf(")  stride: %d  dilation: %d  total params: %d\n", _params.stride, _params.dilation, getParamsCount());
+}
+
+uint32_t DepthwiseConv2DLayer::getParamsCount() const {
+	return _weights.getSize() + _biases.getSize();
+}
+
+void DepthwiseConv2DLayer::updateWeights(float learning_step) {
+	_weights -= _cached_weights_d * learning_step / _samples;
+	_biases -= _cached_biases_d * learning_step / _samples;
+}
+
+const Tensor DepthwiseConv2DLayer::forwardPropagation(const Tensor& x) {
+	cacheInput(x);
+
+	Tensor x_next;
+	infer(x, x_next);
+
+	cacheOutput(x_next);
+
+	return x_next;
+}
+
+void DepthwiseConv2DLayer::infer(const Tensor& x, Tensor& result) const {
+	std::vector<uint32_t> x_next_shape = _output_shape;
+	x_next_shape.insert(x_next_shape.begin(), x.getShape()[0]);
+
+	prepareResult(result, x_next_shape);
+
+	const Conv2DGeometry& g = _geometry;
+	uint32_t x_size = g.h * g.w * g.c;
+	uint32_t x_next_size = g.out_h * g.out_w * g.c;
+
+	for (uint32_t i{ 0 }; i < x.getShape()[0]; ++i) {
+		kernels::depthwiseConv2DKernel<float>(g, x.getDataPtr() + i * x_size, _weights.getDataPtr(), _biases.getDataPtr(),
+											  result.getDataPtr() + i * x_next_size);
+	}
+}
+
+const Tensor DepthwiseConv2DLayer::backwardPropagation(const Tensor& dx) {
+	Tensor cached_input_storage;
+	const Tensor& cached_input = restoreCachedInput(cached_input_storage);
+
+	Tensor dx_prev = Tensor(cached_input.getShape());
+
+	_samples += cached_input.getShape()[0];
+
+	const Conv2DGeometry& g = _geometry;
+	uint32_t x_size = g.h * g.w * g.c;
+	uint32_t dx_size = g.out_h * g.out_w * g.c;
+
+	for (uint32_t i{ 0 }; i < dx.getShape()[0]; ++i) {
+		kernels::depthwiseConv2DBackwardKernel<float>(g, cached_input.getDataPtr() + i * x_size, dx.getDataPtr() + i * dx_size,
+													  _weights.getDataPtr(), dx_prev.getDataPtr() + i * x_size,
+													  _cached_weights_d.getDataPtr(), _cached_biases_d.getDataPtr());
+	}
+
+	return dx_prev;
+}
\ No newline at end of file
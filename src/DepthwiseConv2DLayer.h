@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+
+#include "Utils.h"
+#include "Layer.h"
+
+// one filter per input channel, channels are not mixed, pairs with PointwiseConv2DLayer as a separable convolution
+class DepthwiseConv2DLayer : public Layer {
+public:
+	DepthwiseConv2DLayer(std::vector<uint32_t> input_shape, uint32_t filter_size, const Conv2DParams& params = { 1, 1, ConvPadding::Same });
+	DepthwiseConv2DLayer(Layer& prev_layer, uint32_t filter_size, const Conv2DParams& params = { 1, 1, ConvPadding::Same });
+
+	void setWeights(std::vector<float> weights);
+	void setBiases(std::vector<float> biases);
+
+	virtual const Tensor forwardPropagation(const Tensor& x);
+	virtual void infer(const Tensor& x, Tensor& result) const;
+	virtual const Tensor backwardPropagation(const Tensor& dx);
+	virtual void updateWeights(float learning_step);
+	virtual void initCachedGradient();
+	virtual void summary() const;
+	virtual uint32_t getParamsCount() const;
+
+private:
+	uint32_t _filter_size;
+	Conv2DParams _params;
+	Conv2DGeometry _geometry;
+	Tensor _weights;
+	Tensor _biases;
+	uint32_t _samples;
+	Tensor _cached_weights_d;
+	Tensor _cached_biases_d;
+
+	void initWeights(uint32_t filter_size, const Conv2DParams& params);
+};
\ No newline at end of file
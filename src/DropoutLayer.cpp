@@ -0,0 +1,78 @@
+#include "DropoutLayer.h"
+#include "TensorKernels.h"
+
+DropoutLayer::DropoutLayer(std::vector<uint32_t> input_shape, float rate, uint32_t seed) : Layer() {
+	_input_shape = input_shape;
+	_output_shape = input_shape;
+	initRate(rate, seed);
+}
+
+DropoutLayer::DropoutLayer(Layer& prev_layer, float rate, uint32_t seed) : Layer() {
+	_input_shape = prev_layer.getOutputShape();
+	_output_shape = prev_layer.getOutputShape();
+	initRate(rate, seed);
+	this->setPrevLayer(&prev_layer);
+	prev_layer.setNextLayer(this);
+}
+
+void DropoutLayer::initRate(float rate, uint32_t seed) {
+	if ((rate < 0.0f) || (rate >= 1.0f)) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	_rate = rate;
+	// random values are uniform 32 bit integers, the ones below the threshold are dropped
+	_threshold = static_cast<uint32_t>(std::min(static_cast<double>(rate) * 4294967296.0, 4294967295.0));
+	_seed = seed;
+}
+
+void DropoutLayer::initCachedGradient() {
+}
+
+void DropoutLayer::summary() const {
+	printf("Dropout Layer\n");
+	printf("  in shape:  (*");
+	for (uint32_t i{ 0u }; i < _input_shape.size(); ++i) {
+		printf(", %d", _input_shape[i]);
+	}
+	printf(")  ");
+	printf("  out shape: (*");
+	for (uint32_t i { 0u }; i < _output_shape.size(); ++i) {
+		printf(", %d", _output_shape[i]);
+	}
+	printf(")  rate: %.2f  total params: %d\n", _rate, getParamsCount());
+}
+
+uint32_t DropoutLayer::getParamsCount() const {
+	return 0;
+}
+
+void DropoutLayer::updateWeights(float learning_step) {
+
+}
+
+const Tensor DropoutLayer::forwardPropagation(const Tensor& x) {
+	Tensor x_next = x;
+	forwardPropagationInPlace(x_next);
+	return x_next;
+}
+
+void DropoutLayer::forwardPropagationInPlace(Tensor& x) {
+	// neither the input nor the mask is cached, backward propagation draws the same bits again
+	kernels::dropoutInPlaceKernel<float>(x.getSize(), kernels::counterRandom(_seed, _step), _threshold, 1.0f / (1.0f - _rate), x.getDataPtr());
+}
+
+void DropoutLayer::infer(const Tensor& x, Tensor& result) const {
+	result = x;
+}
+
+const Tensor DropoutLayer::backwardPropagation(const Tensor& dx) {
+	Tensor dx_prev = dx;
+	backwardPropagationInPlace(dx_prev);
+	return dx_prev;
+}
+
+void DropoutLayer::backwardPropagationInPlace(Tensor& dx) {
+	kernels::dropoutInPlaceKernel<float>(dx.getSize(), kernels::counterRandom(_seed, _step), _threshold, 1.0f / (1.0f - _rate), dx.getDataPtr());
+	// next batch, or next micro-batch, draws a new mask
+	++_step;
+}
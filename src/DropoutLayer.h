@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+
+#include "Utils.h"
+#include "Layer.h"
+
+// zeroes a fraction of values during training and scales the rest, inference passes values through,
+// the mask is a function of the seed and the training step, its bits are drawn again by backward propagation
+class DropoutLayer : public Layer {
+public:
+	DropoutLayer(std::vector<uint32_t> input_shape, float rate, uint32_t seed = std::random_device()());
+	DropoutLayer(Layer& prev_layer, float rate, uint32_t seed = std::random_device()());
+
+	virtual const Tensor forwardPropagation(const Tensor& x);
+	virtual void infer(const Tensor& x, Tensor& result) const;
+	virtual const Tensor backwardPropagation(const Tensor& dx);
+	virtual void forwardPropagationInPlace(Tensor& x);
+	virtual void backwardPropagationInPlace(Tensor& dx);
+	virtual void updateWeights(float learning_step);
+	virtual void initCachedGradient();
+	virtual void summary() const;
+	virtual uint32_t getParamsCount() const;
+
+private:
+	float _rate;
+	uint32_t _threshold;
+	uint32_t _seed;
+	// advanced by backward propagation, forward passes recomputed by gradient checkpointing draw the same mask
+	uint32_t _step{ 0 };
+
+	void initRate(float rate, uint32_t seed);
+};
\ No newline at end of file
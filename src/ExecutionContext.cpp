@@ -0,0 +1,20 @@
+#include "ExecutionContext.h"
+
+ExecutionContext::ExecutionContext() {
+}
+
+Tensor& ExecutionContext::getBuffer(uint32_t idx) {
+	if (idx >= _buffers.size()) {
+		_buffers.resize(idx + 1);
+	}
+	return _buffers[idx];
+}
+
+uint64_t ExecutionContext::getBuffersSize() const {
+	// bytes held by scratch buffers
+	uint64_t result{ 0 };
+	for (const auto& buffer : _buffers) {
+		result += buffer.getSize() * sizeof(float);
+	}
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+#include "Tensor.h"
+
+// Per-thread state of the read-only inference path.
+// Holds one output buffer per layer, buffers are reused while batch shapes stay the same.
+class ExecutionContext {
+public:
+	ExecutionContext();
+
+	Tensor& getBuffer(uint32_t idx);
+	uint64_t getBuffersSize() const;
+
+private:
+	// deque keeps references to earlier buffers valid while it grows
+	std::deque<Tensor> _buffers;
+};
\ No newline at end of file
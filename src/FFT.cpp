@@ -0,0 +1,251 @@
+#include "FFT.h"
+
+#include <cmath>
+#include <algorithm>
+
+#define FFT_PI (3.14159265358979323846)
+
+FFT::FFT(uint32_t n) {
+	if (0 == n) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	_n = n;
+
+	// radix 2 stages first, they have the specialised butterfly
+	uint32_t m = n;
+	for (uint32_t p : { 2u, 3u, 5u }) {
+		while (0 == (m % p)) {
+			m /= p;
+			_factors.push_back(p);
+			_factors.push_back(m);
+		}
+	}
+	if (1 != m) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	_twiddles.resize(n);
+	_inverse_twiddles.resize(n);
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		double phase = -2.0 * FFT_PI * i / n;
+		_twiddles[i] = Complex(static_cast<float>(cos(phase)), static_cast<float>(sin(phase)));
+		_inverse_twiddles[i] = std::conj(_twiddles[i]);
+	}
+}
+
+FFT::FFT() {
+}
+
+uint32_t FFT::getSize() const {
+	return _n;
+}
+
+void FFT::forward(const Complex* in, Complex* out) const {
+	if (1 == _n) {
+		out[0] = in[0];
+		return;
+	}
+	transform(in, out, 1, _factors.data(), _twiddles.data());
+}
+
+void FFT::inverse(const Complex* in, Complex* out) const {
+	if (1 == _n) {
+		out[0] = in[0];
+		return;
+	}
+	transform(in, out, 1, _factors.data(), _inverse_twiddles.data());
+}
+
+uint32_t FFT::fastSize(uint32_t n) {
+	for (uint32_t size{ std::max(n + (n & 1u), 2u) };; size += 2) {
+		uint32_t m = size;
+		for (uint32_t p : { 2u, 3u, 5u }) {
+			while (0 == (m % p)) {
+				m /= p;
+			}
+		}
+		if (1 == m) {
+			return size;
+		}
+	}
+}
+
+void FFT::transform(const Complex* in, Complex* out, uint32_t fstride, const uint32_t* factors, const Complex* twiddles) const {
+	// decimation in time: p interleaved sub-sequences of length m are transformed into consecutive blocks of out,
+	// then combined by radix p butterflies
+	uint32_t p = factors[0];
+	uint32_t m = factors[1];
+
+	if (1 == m) {
+		for (uint32_t j{ 0 }; j < p; ++j) {
+			out[j] = in[j * fstride];
+		}
+	}
+	else {
+		for (uint32_t j{ 0 }; j < p; ++j) {
+			transform(in + j * fstride, out + j * m, fstride * p, factors + 2, twiddles);
+		}
+	}
+
+	if (2 == p) {
+		butterfly2(out, fstride, m, twiddles);
+	}
+	else {
+		butterflyGeneric(out, fstride, m, p, twiddles);
+	}
+}
+
+void FFT::butterfly2(Complex* out, uint32_t fstride, uint32_t m, const Complex* twiddles) const {
+	for (uint32_t u{ 0 }; u < m; ++u) {
+		Complex t = out[u + m] * twiddles[u * fstride];
+		out[u + m] = out[u] - t;
+		out[u] += t;
+	}
+}
+
+void FFT::butterflyGeneric(Complex* out, uint32_t fstride, uint32_t m, uint32_t p, const Complex* twiddles) const {
+	Complex scratch[5];
+
+	for (uint32_t u{ 0 }; u < m; ++u) {
+		for (uint32_t q{ 0 }; q < p; ++q) {
+			scratch[q] = out[u + q * m];
+		}
+		for (uint32_t q1{ 0 }; q1 < p; ++q1) {
+			uint32_t k = u + q1 * m;
+			uint32_t twiddle_idx{ 0 };
+			Complex sum = scratch[0];
+			for (uint32_t q{ 1 }; q < p; ++q) {
+				twiddle_idx += fstride * k;
+				if (twiddle_idx >= _n) {
+					twiddle_idx %= _n;
+				}
+				sum += scratch[q] * twiddles[twiddle_idx];
+			}
+			out[k] = sum;
+		}
+	}
+}
+
+RealFFT::RealFFT(uint32_t n) : _fft(n / 2) {
+	if ((0 == n) || (0 != (n % 2))) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	_n = n;
+
+	_twiddles.resize(n / 2);
+	for (uint32_t i{ 0 }; i < n / 2; ++i) {
+		double phase = -2.0 * FFT_PI * i / n;
+		_twiddles[i] = Complex(static_cast<float>(cos(phase)), static_cast<float>(sin(phase)));
+	}
+}
+
+RealFFT::RealFFT() {
+}
+
+uint32_t RealFFT::getSize() const {
+	return _n;
+}
+
+uint32_t RealFFT::getBinsCount() const {
+	return _n / 2 + 1;
+}
+
+void RealFFT::forward(const float* x, Complex* spectrum, Complex* work) const {
+	// even samples as real parts and odd samples as imaginary parts, the half length spectrum z is split into
+	// the spectra of both halves: X[k] = E[k] + w^k O[k]
+	uint32_t half = _n / 2;
+	_fft.forward(reinterpret_cast<const Complex*>(x), work);
+
+	spectrum[0] = Complex(work[0].real() + work[0].imag(), 0.0f);
+	spectrum[half] = Complex(work[0].real() - work[0].imag(), 0.0f);
+	for (uint32_t k{ 1 }; k < half; ++k) {
+		Complex z = work[k];
+		Complex z_mirror = std::conj(work[half - k]);
+		Complex even = (z + z_mirror) * 0.5f;
+		Complex odd = (z - z_mirror) * Complex(0.0f, -0.5f);
+		spectrum[k] = even + _twiddles[k] * odd;
+	}
+}
+
+void RealFFT::inverse(const Complex* spectrum, float* x, Complex* work) const {
+	// rebuilds the half length spectrum z = E + i O scaled by 2, so the result is scaled by n like the complex transform
+	uint32_t half = _n / 2;
+	Complex* z = work;
+	Complex* result = work + half;
+
+	for (uint32_t k{ 0 }; k < half; ++k) {
+		Complex s = spectrum[k];
+		Complex s_mirror = std::conj(spectrum[half - k]);
+		Complex even = s + s_mirror;
+		Complex odd = (s - s_mirror) * std::conj(_twiddles[k]);
+		z[k] = even + Complex(0.0f, 1.0f) * odd;
+	}
+	_fft.inverse(z, result);
+
+	std::copy(result, result + half, reinterpret_cast<Complex*>(x));
+}
+
+RealFFT2D::RealFFT2D(uint32_t h, uint32_t w) : _columns_fft(h), _rows_fft(w) {
+	_h = h;
+	_w = w;
+}
+
+RealFFT2D::RealFFT2D() {
+}
+
+uint32_t RealFFT2D::getHeight() const {
+	return _h;
+}
+
+uint32_t RealFFT2D::getWidth() const {
+	return _w;
+}
+
+uint32_t RealFFT2D::getBinsCount() const {
+	return _h * _rows_fft.getBinsCount();
+}
+
+void RealFFT2D::forward(const float* x, Complex* spectrum, uint32_t row_begin, uint32_t row_end) const {
+	// real transforms of the non-zero rows, then complex transforms of the columns of bins
+	uint32_t bins_w = _rows_fft.getBinsCount();
+	std::vector<Complex> work(std::max(_w, 2 * _h));
+	Complex* column = work.data();
+	Complex* column_spectrum = work.data() + _h;
+
+	std::fill(spectrum, spectrum + row_begin * bins_w, Complex(0.0f, 0.0f));
+	std::fill(spectrum + row_end * bins_w, spectrum + _h * bins_w, Complex(0.0f, 0.0f));
+	for (uint32_t i{ row_begin }; i < row_end; ++i) {
+		_rows_fft.forward(x + i * _w, spectrum + i * bins_w, work.data());
+	}
+
+	for (uint32_t j{ 0 }; j < bins_w; ++j) {
+		for (uint32_t i{ 0 }; i < _h; ++i) {
+			column[i] = spectrum[i * bins_w + j];
+		}
+		_columns_fft.forward(column, column_spectrum);
+		for (uint32_t i{ 0 }; i < _h; ++i) {
+			spectrum[i * bins_w + j] = column_spectrum[i];
+		}
+	}
+}
+
+void RealFFT2D::inverse(Complex* spectrum, float* x, uint32_t rows) const {
+	uint32_t bins_w = _rows_fft.getBinsCount();
+	std::vector<Complex> work(std::max(_w, 2 * _h));
+	Complex* column = work.data();
+	Complex* column_signal = work.data() + _h;
+
+	for (uint32_t j{ 0 }; j < bins_w; ++j) {
+		for (uint32_t i{ 0 }; i < _h; ++i) {
+			column[i] = spectrum[i * bins_w + j];
+		}
+		_columns_fft.inverse(column, column_signal);
+		for (uint32_t i{ 0 }; i < rows; ++i) {
+			spectrum[i * bins_w + j] = column_signal[i];
+		}
+	}
+
+	for (uint32_t i{ 0 }; i < rows; ++i) {
+		_rows_fft.inverse(spectrum + i * bins_w, x + i * _w, work.data());
+	}
+}
\ No newline at end of file
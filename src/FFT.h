@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+typedef std::complex<float> Complex;
+
+// Unnormalized mixed radix (2, 3, 5) complex transform, inverse(forward(x)) is n * x.
+class FFT {
+public:
+	explicit FFT(uint32_t n);
+	FFT();
+
+	uint32_t getSize() const;
+	// out of place, in and out must not overlap
+	void forward(const Complex* in, Complex* out) const;
+	void inverse(const Complex* in, Complex* out) const;
+
+	// smallest even size not less than n with no prime factors other than 2, 3 and 5
+	static uint32_t fastSize(uint32_t n);
+
+private:
+	uint32_t _n{ 0 };
+	// radix and remaining length for every stage
+	std::vector<uint32_t> _factors;
+	std::vector<Complex> _twiddles;
+	std::vector<Complex> _inverse_twiddles;
+
+	void transform(const Complex* in, Complex* out, uint32_t fstride, const uint32_t* factors, const Complex* twiddles) const;
+	void butterfly2(Complex* out, uint32_t fstride, uint32_t m, const Complex* twiddles) const;
+	void butterflyGeneric(Complex* out, uint32_t fstride, uint32_t m, uint32_t p, const Complex* twiddles) const;
+};
+
+// Transform of n real values (n even) through a complex transform of n / 2, only the n / 2 + 1 non-redundant bins are kept.
+class RealFFT {
+public:
+	explicit RealFFT(uint32_t n);
+	RealFFT();
+
+	uint32_t getSize() const;
+	uint32_t getBinsCount() const;
+	// work holds n / 2 values
+	void forward(const float* x, Complex* spectrum, Complex* work) const;
+	// unnormalized, x is n times the original signal, work holds n values
+	void inverse(const Complex* spectrum, float* x, Complex* work) const;
+
+private:
+	uint32_t _n{ 0 };
+	FFT _fft;
+	std::vector<Complex> _twiddles;
+};
+
+// Real transform of (h x w) grids, spectra are (h x w / 2 + 1) row major.
+class RealFFT2D {
+public:
+	RealFFT2D(uint32_t h, uint32_t w);
+	RealFFT2D();
+
+	uint32_t getHeight() const;
+	uint32_t getWidth() const;
+	uint32_t getBinsCount() const;
+	// rows outside [row_begin, row_end) of x are zeros and are not read
+	void forward(const float* x, Complex* spectrum, uint32_t row_begin, uint32_t row_end) const;
+	// unnormalized, spectrum is overwritten, only the first rows of x are computed
+	void inverse(Complex* spectrum, float* x, uint32_t rows) const;
+
+private:
+	uint32_t _h{ 0 };
+	uint32_t _w{ 0 };
+	FFT _columns_fft;
+	RealFFT _rows_fft;
+};
\ No newline at end of file
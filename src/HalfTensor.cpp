@@ -0,0 +1,249 @@
+#include "HalfTensor.h"
+
+HalfTensor::HalfTensor(const Tensor& tensor, DataType dtype) {
+	if (DataType::Float32 == dtype) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	_shape = tensor.getShape();
+	_size = tensor.getSize();
+	_dtype = dtype;
+	_data.resize(_size);
+
+	convertFromFloat(_dtype, _size, tensor.getDataPtr(), _data.data());
+}
+
+HalfTensor::HalfTensor() {
+	_size = 0;
+	_dtype = DataType::BFloat16;
+}
+
+void HalfTensor::release() {
+	_shape.clear();
+	_size = 0;
+	std::vector<uint16_t, TrackingAllocator<uint16_t> >().swap(_data);
+}
+
+std::vector<uint32_t> HalfTensor::getShape() const {
+	return _shape;
+}
+
+uint32_t HalfTensor::getSize() const {
+	return _size;
+}
+
+DataType HalfTensor::getDataType() const {
+	return _dtype;
+}
+
+const Tensor HalfTensor::toTensor() const {
+	Tensor result = Tensor(_shape);
+
+	convertToFloat(_dtype, _size, _data.data(), result.getDataPtr());
+
+	return result;
+}
+
+float HalfTensor::sum() const {
+	float buffer[HALF_DOT_PRODUCT_BLOCK_SIZE * 64];
+	float result{ 0.0f };
+
+	// blocks are summed separately to limit rounding error of a single accumulator
+	for (uint32_t i{ 0 }; i < _size; i += HALF_DOT_PRODUCT_BLOCK_SIZE * 64) {
+		uint32_t count = std::min(_size - i, HALF_DOT_PRODUCT_BLOCK_SIZE * 64);
+		float block_sum{ 0.0f };
+
+		convertToFloat(_dtype, count, &_data[i], buffer);
+
+		for (uint32_t j{ 0 }; j < count; ++j) {
+			block_sum += buffer[j];
+		}
+		result += block_sum;
+	}
+
+	return result;
+}
+
+const Tensor HalfTensor::dotProductTranspose(const Tensor& tensor, const HalfTensor& other) {
+	std::vector<uint32_t> shape = tensor.getShape();
+
+	if ((shape.size() != 2) || (other._shape.size() != 2)) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	if (shape[1] != other._shape[1]) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	uint32_t n = shape[0];
+	uint32_t m = other._shape[0];
+	uint32_t k = shape[1];
+
+	Tensor result = Tensor({ n, m });
+
+	const float* a = tensor.getDataPtr();
+	float* r = result.getDataPtr();
+	std::vector<float> block(HALF_DOT_PRODUCT_BLOCK_SIZE * k);
+	std::vector<float> block_t(HALF_DOT_PRODUCT_BLOCK_SIZE * k);
+
+	// a few rows of other are widened to fp32 at a time and reused for all rows of tensor,
+	// the block is stored transposed so the innermost loop updates independent accumulators
+	for (uint32_t jb{ 0 }; jb < m; jb += HALF_DOT_PRODUCT_BLOCK_SIZE) {
+		uint32_t j_count = std::min(m - jb, HALF_DOT_PRODUCT_BLOCK_SIZE);
+
+		convertToFloat(other._dtype, j_count * k, &other._data[jb * k], block.data());
+		std::fill(block_t.begin(), block_t.end(), 0.0f);
+		for (uint32_t j{ 0 }; j < j_count; ++j) {
+			for (uint32_t p{ 0 }; p < k; ++p) {
+				block_t[p * HALF_DOT_PRODUCT_BLOCK_SIZE + j] = block[j * k + p];
+			}
+		}
+
+		for (uint32_t i{ 0 }; i < n; ++i) {
+			float acc[HALF_DOT_PRODUCT_BLOCK_SIZE] = { 0.0f };
+			for (uint32_t p{ 0 }; p < k; ++p) {
+				float a_ip = a[i * k + p];
+				for (uint32_t j{ 0 }; j < HALF_DOT_PRODUCT_BLOCK_SIZE; ++j) {
+					acc[j] += a_ip * block_t[p * HALF_DOT_PRODUCT_BLOCK_SIZE + j];
+				}
+			}
+			for (uint32_t j{ 0 }; j < j_count; ++j) {
+				r[i * m + jb + j] = acc[j];
+			}
+		}
+	}
+
+	return result;
+}
+
+uint16_t HalfTensor::floatToBFloat16(float value) {
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	if ((bits & 0x7FFFFFFFu) > 0x7F800000u) {
+		// NaN, keep it quiet
+		return static_cast<uint16_t>((bits >> 16) | 0x0040u);
+	}
+
+	// round to nearest even
+	bits += 0x7FFFu + ((bits >> 16) & 1u);
+
+	return static_cast<uint16_t>(bits >> 16);
+}
+
+float HalfTensor::bFloat16ToFloat(uint16_t value) {
+	uint32_t bits = static_cast<uint32_t>(value) << 16;
+	float result;
+	memcpy(&result, &bits, sizeof(result));
+
+	return result;
+}
+
+uint16_t HalfTensor::floatToFloat16(float value) {
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	uint32_t sign = (bits >> 16) & 0x8000u;
+	uint32_t exponent = (bits >> 23) & 0xFFu;
+	uint32_t mantissa = bits & 0x7FFFFFu;
+
+	if (0xFFu == exponent) {
+		// infinity or NaN
+		return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x0200u : 0u));
+	}
+
+	int32_t half_exponent = static_cast<int32_t>(exponent) - 127 + 15;
+
+	if (half_exponent >= 0x1F) {
+		// overflow
+		return static_cast<uint16_t>(sign | 0x7C00u);
+	}
+
+	if (half_exponent <= 0) {
+		if (half_exponent < -10) {
+			// underflow
+			return static_cast<uint16_t>(sign);
+		}
+
+		// subnormal
+		mantissa |= 0x800000u;
+		uint32_t shift = static_cast<uint32_t>(14 - half_exponent);
+		uint32_t half_mantissa = mantissa >> shift;
+		uint32_t remainder = mantissa & ((1u << shift) - 1u);
+		uint32_t halfway = 1u << (shift - 1u);
+
+		if (remainder > halfway || (remainder == halfway && (half_mantissa & 1u))) {
+			++half_mantissa;
+		}
+
+		return static_cast<uint16_t>(sign | half_mantissa);
+	}
+
+	uint32_t result = sign | (static_cast<uint32_t>(half_exponent) << 10) | (mantissa >> 13);
+	uint32_t remainder = mantissa & 0x1FFFu;
+
+	// round to nearest even, carry may propagate to exponent
+	if (remainder > 0x1000u || (remainder == 0x1000u && (result & 1u))) {
+		++result;
+	}
+
+	return static_cast<uint16_t>(result);
+}
+
+float HalfTensor::float16ToFloat(uint16_t value) {
+	uint32_t sign = (static_cast<uint32_t>(value) & 0x8000u) << 16;
+	uint32_t exponent = (value >> 10) & 0x1Fu;
+	uint32_t mantissa = value & 0x3FFu;
+	uint32_t bits;
+	float result;
+
+	if (0 == exponent) {
+		// zero or subnormal
+		result = ldexpf(static_cast<float>(mantissa), -24);
+		return sign ? -result : result;
+	}
+
+	if (0x1Fu == exponent) {
+		bits = sign | 0x7F800000u | (mantissa << 13);
+	}
+	else {
+		bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+	}
+
+	memcpy(&result, &bits, sizeof(result));
+
+	return result;
+}
+
+void HalfTensor::convertFromFloat(DataType dtype, uint32_t n, const float* v, uint16_t* r) {
+	switch (dtype) {
+	case DataType::BFloat16:
+		for (uint32_t i{ 0 }; i < n; ++i) {
+			r[i] = floatToBFloat16(v[i]);
+		}
+		break;
+	case DataType::Float16:
+		for (uint32_t i{ 0 }; i < n; ++i) {
+			r[i] = floatToFloat16(v[i]);
+		}
+		break;
+	default:
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+}
+
+void HalfTensor::convertToFloat(DataType dtype, uint32_t n, const uint16_t* v, float* r) {
+	switch (dtype) {
+	case DataType::BFloat16:
+		for (uint32_t i{ 0 }; i < n; ++i) {
+			r[i] = bFloat16ToFloat(v[i]);
+		}
+		break;
+	case DataType::Float16:
+		for (uint32_t i{ 0 }; i < n; ++i) {
+			r[i] = float16ToFloat(v[i]);
+		}
+		break;
+	default:
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+
+#include "Tensor.h"
+
+#define HALF_DOT_PRODUCT_BLOCK_SIZE (8u)
+
+enum class DataType : uint8_t {
+	Float32,
+	BFloat16,
+	Float16
+};
+
+// Tensor stored in 16-bit floating point format (bf16 or fp16).
+// Values are converted to fp32 for computation, all accumulation is done in fp32.
+class HalfTensor {
+public:
+	HalfTensor(const Tensor& tensor, DataType dtype);
+	HalfTensor();
+
+	std::vector<uint32_t> getShape() const;
+	uint32_t getSize() const;
+	DataType getDataType() const;
+	const Tensor toTensor() const;
+	float sum() const;
+	// frees the storage, tensor becomes empty
+	void release();
+
+	static const Tensor dotProductTranspose(const Tensor& tensor, const HalfTensor& other);
+
+	static uint16_t floatToBFloat16(float value);
+	static float bFloat16ToFloat(uint16_t value);
+	static uint16_t floatToFloat16(float value);
+	static float float16ToFloat(uint16_t value);
+	static void convertFromFloat(DataType dtype, uint32_t n, const float* v, uint16_t* r);
+	static void convertToFloat(DataType dtype, uint32_t n, const uint16_t* v, float* r);
+
+private:
+	std::vector<uint32_t> _shape;
+	uint32_t _size;
+	DataType _dtype;
+	std::vector<uint16_t, TrackingAllocator<uint16_t> > _data;
+};
\ No newline at end of file
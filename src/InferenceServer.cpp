@@ -0,0 +1,195 @@
+#include "InferenceServer.h"
+
+InferenceServer::InferenceServer(const NeuralNetwork& neural_network, uint32_t max_batch_size, uint32_t max_latency_us, uint32_t workers_count) {
+	if ((0 == max_batch_size) || (0 == workers_count)) {
+		printf("EXCEPTION %d\n", __LINE__);
+		throw std::invalid_argument(""); // exception
+	}
+
+	_neural_network = &neural_network;
+	_max_batch_size = max_batch_size;
+	_max_latency = std::chrono::microseconds(max_latency_us);
+	_input_shape = neural_network.getInputShape();
+	_output_shape = neural_network.getOutputShape();
+
+	_input_size = 1;
+	for (auto s : _input_shape) {
+		_input_size *= s;
+	}
+	_output_size = 1;
+	for (auto s : _output_shape) {
+		_output_size *= s;
+	}
+
+	_latencies_ms.reserve(INFERENCE_LATENCY_WINDOW);
+
+	for (uint32_t i{ 0 }; i < workers_count; ++i) {
+		_workers.emplace_back(&InferenceServer::workerLoop, this);
+	}
+}
+
+InferenceServer::~InferenceServer() {
+	stop();
+}
+
+std::future<Tensor> InferenceServer::submit(const Tensor& sample) {
+	if (sample.getSize() != _input_size) {
+		printf("EXCEPTION %d\n", __LINE__);
+		throw std::invalid_argument(""); // exception
+	}
+
+	Request request;
+	request.sample = sample;
+	request.submit_time = Clock::now();
+	std::future<Tensor> result = request.promise.get_future();
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_stop) {
+			printf("EXCEPTION %d\n", __LINE__);
+			throw std::invalid_argument(""); // exception
+		}
+		_queue.push_back(std::move(request));
+	}
+	_queue_cv.notify_all();
+
+	return result;
+}
+
+InferenceServerStats InferenceServer::getStats() const {
+	InferenceServerStats stats;
+	std::vector<float> latencies;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		stats.queue_depth = _queue.size();
+		stats.last_batch_size = _last_batch_size;
+		stats.requests_count = _requests_count;
+		stats.batches_count = _batches_count;
+		latencies = _latencies_ms;
+	}
+
+	stats.average_batch_size = (stats.batches_count > 0) ? float(stats.requests_count) / stats.batches_count : 0.0f;
+	stats.p50_latency_ms = 0.0f;
+	stats.p99_latency_ms = 0.0f;
+
+	if (!latencies.empty()) {
+		auto p50 = latencies.begin() + (latencies.size() - 1) / 2;
+		std::nth_element(latencies.begin(), p50, latencies.end());
+		stats.p50_latency_ms = *p50;
+
+		auto p99 = latencies.begin() + (latencies.size() - 1) * 99 / 100;
+		std::nth_element(latencies.begin(), p99, latencies.end());
+		stats.p99_latency_ms = *p99;
+	}
+
+	return stats;
+}
+
+void InferenceServer::stop() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_queue_cv.notify_all();
+
+	// workers drain the queue before exiting
+	for (auto& worker : _workers) {
+		worker.join();
+	}
+	_workers.clear();
+}
+
+void InferenceServer::workerLoop() {
+	// batch tensors indexed by batch size, allocated on first use and reused
+	std::vector<Tensor> batch_buffers(_max_batch_size);
+	std::vector<Request> batch;
+	batch.reserve(_max_batch_size);
+	ExecutionContext context;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_queue_cv.wait(lock, [this] { return _stop || !_queue.empty(); });
+			if (_queue.empty()) {
+				return;
+			}
+
+			Clock::time_point deadline = _queue.front().submit_time + _max_latency;
+			_queue_cv.wait_until(lock, deadline, [this] { return _stop || (_queue.size() >= _max_batch_size); });
+
+			// other worker could take the requests in the meantime
+			if (_queue.empty()) {
+				continue;
+			}
+
+			uint32_t batch_size = std::min<uint32_t>(_queue.size(), _max_batch_size);
+			for (uint32_t i{ 0 }; i < batch_size; ++i) {
+				batch.push_back(std::move(_queue.front()));
+				_queue.pop_front();
+			}
+		}
+
+		runBatch(batch, batch_buffers, context);
+		batch.clear();
+	}
+}
+
+void InferenceServer::runBatch(std::vector<Request>& batch, std::vector<Tensor>& batch_buffers, ExecutionContext& context) {
+	uint32_t batch_size = batch.size();
+	Tensor& x = batch_buffers[batch_size - 1];
+
+	if (x.getSize() != batch_size * _input_size) {
+		std::vector<uint32_t> shape = { batch_size };
+		shape.insert(shape.end(), _input_shape.begin(), _input_shape.end());
+		x = Tensor(shape);
+	}
+
+	float* x_data = x.getDataPtr();
+	for (uint32_t i{ 0 }; i < batch_size; ++i) {
+		memcpy(x_data + i * _input_size, batch[i].sample.getDataPtr(), _input_size * sizeof(float));
+	}
+
+	try {
+		// workers share the network, each one has its own context
+		const Tensor& y = _neural_network->predict(x, context);
+
+		std::vector<Tensor> results(batch_size, Tensor(_output_shape));
+		const float* y_data = y.getDataPtr();
+		for (uint32_t i{ 0 }; i < batch_size; ++i) {
+			memcpy(results[i].getDataPtr(), y_data + i * _output_size, _output_size * sizeof(float));
+		}
+
+		// counters are updated before results are visible to clients
+		recordBatch(batch);
+		for (uint32_t i{ 0 }; i < batch_size; ++i) {
+			batch[i].promise.set_value(results[i]);
+		}
+	}
+	catch (...) {
+		recordBatch(batch);
+		for (auto& request : batch) {
+			request.promise.set_exception(std::current_exception());
+		}
+	}
+}
+
+void InferenceServer::recordBatch(const std::vector<Request>& batch) {
+	Clock::time_point now = Clock::now();
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	for (const auto& request : batch) {
+		float latency_ms = std::chrono::duration<float, std::milli>(now - request.submit_time).count();
+		if (_latencies_ms.size() < INFERENCE_LATENCY_WINDOW) {
+			_latencies_ms.push_back(latency_ms);
+		}
+		else {
+			_latencies_ms[_latencies_idx] = latency_ms;
+		}
+		_latencies_idx = (_latencies_idx + 1) % INFERENCE_LATENCY_WINDOW;
+	}
+
+	_last_batch_size = batch.size();
+	_requests_count += batch.size();
+	++_batches_count;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <chrono>
+
+#include "NeuralNetwork.h"
+
+#define INFERENCE_LATENCY_WINDOW (4096u)
+
+struct InferenceServerStats {
+	uint32_t queue_depth;
+	uint32_t last_batch_size;
+	float average_batch_size;
+	uint64_t requests_count;
+	uint64_t batches_count;
+	float p50_latency_ms;
+	float p99_latency_ms;
+};
+
+// Queues single samples and runs them through the network in dynamic batches.
+// A batch is formed when max_batch_size samples are waiting or when the oldest
+// waiting sample has been queued for max_latency_us.
+class InferenceServer {
+public:
+	InferenceServer(const NeuralNetwork& neural_network, uint32_t max_batch_size, uint32_t max_latency_us, uint32_t workers_count=1u);
+	~InferenceServer();
+
+	std::future<Tensor> submit(const Tensor& sample);
+	InferenceServerStats getStats() const;
+	void stop();
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	struct Request {
+		Tensor sample;
+		std::promise<Tensor> promise;
+		Clock::time_point submit_time;
+	};
+
+	const NeuralNetwork* _neural_network;
+	uint32_t _max_batch_size;
+	Clock::duration _max_latency;
+	std::vector<uint32_t> _input_shape;
+	std::vector<uint32_t> _output_shape;
+	uint32_t _input_size;
+	uint32_t _output_size;
+
+	std::vector<std::thread> _workers;
+	std::deque<Request> _queue;
+	mutable std::mutex _mutex;
+	std::condition_variable _queue_cv;
+	bool _stop{ false };
+
+	uint32_t _last_batch_size{ 0 };
+	uint64_t _requests_count{ 0 };
+	uint64_t _batches_count{ 0 };
+	std::vector<float> _latencies_ms;
+	uint32_t _latencies_idx{ 0 };
+
+	void workerLoop();
+	void runBatch(std::vector<Request>& batch, std::vector<Tensor>& batch_buffers, ExecutionContext& context);
+	void recordBatch(const std::vector<Request>& batch);
+};
\ No newline at end of file
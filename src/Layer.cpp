@@ -36,5 +36,97 @@ Layer* Layer::getNextLayer() const {
 }
 
 Tensor Layer::getCachedOutput() const {
+	if (DataType::Float32 != _cache_dtype) {
+		return _cached_output_half.toTensor();
+	}
 	return _cached_output;
+}
+
+void Layer::releaseCache() {
+	_cached_input.release();
+	_cached_output.release();
+	_cached_input_half.release();
+	_cached_output_half.release();
+}
+
+void Layer::setPrecision(DataType dtype) {
+	_cache_dtype = dtype;
+	releaseCache();
+}
+
+void Layer::quantize(const Tensor& calibration_x) {
+}
+
+bool Layer::fuseActivation(ActivationFun activation_fun) {
+	return false;
+}
+
+void Layer::unfuseActivation() {
+}
+
+bool Layer::getFusableActivation(ActivationFun& activation_fun) const {
+	return false;
+}
+
+void Layer::setPassThrough(bool pass_through) {
+}
+
+bool Layer::getFoldableScaleShift(Tensor& scale, Tensor& shift) const {
+	return false;
+}
+
+bool Layer::foldScaleShift(const Tensor& scale, const Tensor& shift) {
+	return false;
+}
+
+void Layer::unfoldScaleShift() {
+}
+
+void Layer::forwardPropagationInPlace(Tensor& x) {
+	x = forwardPropagation(x);
+}
+
+void Layer::backwardPropagationInPlace(Tensor& dx) {
+	dx = backwardPropagation(dx);
+}
+
+void Layer::cacheInput(const Tensor& x) {
+	if (DataType::Float32 == _cache_dtype) {
+		_cached_input = x;
+	}
+	else {
+		_cached_input_half = HalfTensor(x, _cache_dtype);
+	}
+}
+
+void Layer::cacheOutput(const Tensor& y) {
+	if (DataType::Float32 == _cache_dtype) {
+		_cached_output = y;
+	}
+	else {
+		_cached_output_half = HalfTensor(y, _cache_dtype);
+	}
+}
+
+const Tensor& Layer::restoreCachedInput(Tensor& storage) const {
+	if (DataType::Float32 == _cache_dtype) {
+		return _cached_input;
+	}
+	// cached input is widened only for the duration of backward propagation
+	storage = _cached_input_half.toTensor();
+	return storage;
+}
+const Tensor& Layer::restoreCachedOutput(Tensor& storage) const {
+	if (DataType::Float32 == _cache_dtype) {
+		return _cached_output;
+	}
+	storage = _cached_output_half.toTensor();
+	return storage;
+}
+
+void Layer::prepareResult(Tensor& result, const std::vector<uint32_t>& shape) {
+	// result buffer is reallocated only when its shape changes
+	if (result.getShape() != shape) {
+		result = Tensor(shape);
+	}
 }
\ No newline at end of file
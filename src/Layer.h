@@ -7,6 +7,9 @@
 
 #include "Utils.h"
 #include "Tensor.h"
+#include "HalfTensor.h"
+#include "QuantizedTensor.h"
+#include "Activation.h"
 
 class Layer {
 public:
@@ -21,9 +24,27 @@ public:
 	Layer* getPrevLayer() const;
 	Layer* getNextLayer() const;
 	Tensor getCachedOutput() const;
+	// frees cached activations, next forward propagation caches them again
+	void releaseCache();
+	virtual void setPrecision(DataType dtype);
+	virtual void quantize(const Tensor& calibration_x);
+	virtual bool fuseActivation(ActivationFun activation_fun);
+	virtual void unfuseActivation();
+	virtual bool getFusableActivation(ActivationFun& activation_fun) const;
+	virtual void setPassThrough(bool pass_through);
+	// per-channel affine map of inference output, e.g. batch normalization with running statistics,
+	// a layer folding it applies it with its own weights during inference
+	virtual bool getFoldableScaleShift(Tensor& scale, Tensor& shift) const;
+	virtual bool foldScaleShift(const Tensor& scale, const Tensor& shift);
+	virtual void unfoldScaleShift();
 
 	virtual const Tensor forwardPropagation(const Tensor& x) = 0;
+	// read-only forward pass, safe to call concurrently with distinct result tensors
+	virtual void infer(const Tensor& x, Tensor& result) const = 0;
 	virtual const Tensor backwardPropagation(const Tensor& dx) = 0;
+	// training passes overwriting their argument, a layer that can work in place skips allocating the result
+	virtual void forwardPropagationInPlace(Tensor& x);
+	virtual void backwardPropagationInPlace(Tensor& dx);
 	virtual void updateWeights(float learning_step) = 0;
 	virtual void initCachedGradient() = 0;
 	virtual void summary() const = 0;
@@ -38,4 +59,15 @@ protected:
 
 	Tensor _cached_input;
 	Tensor _cached_output;
+
+	DataType _cache_dtype{ DataType::Float32 };
+	HalfTensor _cached_input_half;
+	HalfTensor _cached_output_half;
+
+	void cacheInput(const Tensor& x);
+	void cacheOutput(const Tensor& y);
+	const Tensor& restoreCachedInput(Tensor& storage) const;
+	const Tensor& restoreCachedOutput(Tensor& storage) const;
+
+	static void prepareResult(Tensor& result, const std::vector<uint32_t>& shape);
 };
\ No newline at end of file
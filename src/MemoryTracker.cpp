@@ -0,0 +1,180 @@
+#include "MemoryTracker.h"
+
+std::atomic<bool> MemoryTracker::_enabled{ false };
+MemoryTracker::Counters MemoryTracker::_counters;
+std::mutex MemoryTracker::_scopes_mutex;
+std::map<std::string, MemoryTracker::Counters> MemoryTracker::_scopes;
+thread_local MemoryTracker::Counters* MemoryTracker::_scope_counters{ nullptr };
+
+struct MemoryTracker::AllocationHeader {
+	Counters* scope;
+	bool tracked;
+};
+
+static uint32_t histogramBucket(size_t bytes) {
+	uint32_t bucket{ 0 };
+	while ((bytes >>= 1) && (bucket + 1 < MEMORY_HISTOGRAM_BUCKETS)) {
+		++bucket;
+	}
+	return bucket;
+}
+
+MemoryTracker::Counters::Counters() {
+	reset();
+}
+
+void MemoryTracker::Counters::reset() {
+	live_bytes = 0;
+	peak_bytes = 0;
+	allocated_bytes = 0;
+	allocations_count = 0;
+	for (auto& count : size_histogram) {
+		count = 0;
+	}
+}
+
+void MemoryTracker::Counters::allocate(size_t bytes) {
+	int64_t live = live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+	int64_t peak = peak_bytes.load(std::memory_order_relaxed);
+	while ((live > peak) && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+	}
+
+	allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+	allocations_count.fetch_add(1, std::memory_order_relaxed);
+	size_histogram[histogramBucket(bytes)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemoryTracker::Counters::deallocate(size_t bytes) {
+	live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+MemoryStats MemoryTracker::Counters::getStats() const {
+	MemoryStats result;
+
+	result.live_bytes = live_bytes;
+	result.peak_bytes = peak_bytes;
+	result.allocated_bytes = allocated_bytes;
+	result.allocations_count = allocations_count;
+	result.size_histogram.resize(MEMORY_HISTOGRAM_BUCKETS);
+	for (uint32_t i{ 0 }; i < MEMORY_HISTOGRAM_BUCKETS; ++i) {
+		result.size_histogram[i] = size_histogram[i];
+	}
+
+	return result;
+}
+
+void MemoryTracker::setEnabled(bool enabled) {
+	_enabled = enabled;
+}
+
+bool MemoryTracker::isEnabled() {
+	return _enabled.load(std::memory_order_relaxed);
+}
+
+void MemoryTracker::reset() {
+	std::lock_guard<std::mutex> lock(_scopes_mutex);
+
+	_counters.reset();
+	// scopes may be active in other threads, counters are reset but kept
+	for (auto& scope : _scopes) {
+		scope.second.reset();
+	}
+}
+
+MemoryStats MemoryTracker::getStats() {
+	return _counters.getStats();
+}
+
+MemoryStats MemoryTracker::getScopeStats(const std::string& name) {
+	std::lock_guard<std::mutex> lock(_scopes_mutex);
+
+	auto it = _scopes.find(name);
+	if (it == _scopes.end()) {
+		return Counters().getStats();
+	}
+	return it->second.getStats();
+}
+
+std::vector<std::string> MemoryTracker::getScopeNames() {
+	std::lock_guard<std::mutex> lock(_scopes_mutex);
+	std::vector<std::string> result;
+
+	for (const auto& scope : _scopes) {
+		result.push_back(scope.first);
+	}
+	return result;
+}
+
+std::string MemoryTracker::getScopeName(const char* name, uint32_t index) {
+	return std::string(name) + " " + std::to_string(index);
+}
+
+void MemoryTracker::printStats(const MemoryStats& stats) {
+	printf("  memory: allocated %llu B in %llu allocations, peak %lld B, live %lld B\n",
+		(unsigned long long)stats.allocated_bytes, (unsigned long long)stats.allocations_count,
+		(long long)stats.peak_bytes, (long long)stats.live_bytes);
+}
+
+void* MemoryTracker::allocate(size_t bytes) {
+	static_assert(sizeof(AllocationHeader) <= MEMORY_ALLOCATION_HEADER_SIZE, "allocation header does not fit");
+
+	char* block = static_cast<char*>(::operator new(bytes + MEMORY_ALLOCATION_HEADER_SIZE));
+	AllocationHeader* header = new (block) AllocationHeader{ nullptr, isEnabled() };
+
+	if (header->tracked) {
+		header->scope = _scope_counters;
+		_counters.allocate(bytes);
+		if (header->scope) {
+			header->scope->allocate(bytes);
+		}
+	}
+	return block + MEMORY_ALLOCATION_HEADER_SIZE;
+}
+
+void MemoryTracker::deallocate(void* p, size_t bytes) noexcept {
+	char* block = static_cast<char*>(p) - MEMORY_ALLOCATION_HEADER_SIZE;
+	const AllocationHeader* header = reinterpret_cast<const AllocationHeader*>(block);
+
+	// scope counters are never removed, the owning scope may be active in another thread or already left
+	if (header->tracked) {
+		_counters.deallocate(bytes);
+		if (header->scope) {
+			header->scope->deallocate(bytes);
+		}
+	}
+	::operator delete(block);
+}
+
+MemoryTracker::Counters* MemoryTracker::getScopeCounters(const std::string& name) {
+	std::lock_guard<std::mutex> lock(_scopes_mutex);
+
+	// std::map nodes are stable, pointer stays valid while other scopes are added
+	return &_scopes[name];
+}
+
+MemoryScope::MemoryScope(const char* name) : MemoryScope(std::string(name)) {
+}
+
+MemoryScope::MemoryScope(const std::string& name) {
+	if (MemoryTracker::isEnabled()) {
+		enter(name);
+	}
+}
+
+MemoryScope::MemoryScope(const char* name, uint32_t index) {
+	if (MemoryTracker::isEnabled()) {
+		enter(MemoryTracker::getScopeName(name, index));
+	}
+}
+
+void MemoryScope::enter(const std::string& name) {
+	_active = true;
+	_prev_counters = MemoryTracker::_scope_counters;
+	MemoryTracker::_scope_counters = MemoryTracker::getScopeCounters(name);
+}
+
+MemoryScope::~MemoryScope() {
+	if (_active) {
+		MemoryTracker::_scope_counters = _prev_counters;
+	}
+}
\ No newline at end of file
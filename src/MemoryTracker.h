@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+#include <string>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+#define MEMORY_HISTOGRAM_BUCKETS (40u)
+
+// Bytes are counted from the moment tracking was enabled or reset, memory allocated while tracking
+// was disabled is not counted when freed, memory allocated before reset makes live bytes negative.
+// Histogram bucket i counts allocations of [2^i, 2^(i+1)) bytes.
+struct MemoryStats {
+	int64_t live_bytes;
+	int64_t peak_bytes;
+	uint64_t allocated_bytes;
+	uint64_t allocations_count;
+	std::vector<uint64_t> size_histogram;
+};
+
+// Opt-in counters of tensor storage allocations.
+// Allocations made inside a MemoryScope are also attributed to that scope,
+// their frees are charged to it wherever they happen.
+class MemoryTracker {
+public:
+	static void setEnabled(bool enabled);
+	static bool isEnabled();
+	static void reset();
+
+	static MemoryStats getStats();
+	static MemoryStats getScopeStats(const std::string& name);
+	static std::vector<std::string> getScopeNames();
+	static std::string getScopeName(const char* name, uint32_t index);
+	static void printStats(const MemoryStats& stats);
+
+	// storage of TrackingAllocator, every block starts with a header remembering the scope it was allocated in
+	static void* allocate(size_t bytes);
+	static void deallocate(void* p, size_t bytes) noexcept;
+
+private:
+	friend class MemoryScope;
+
+	struct AllocationHeader;
+
+	struct Counters {
+		std::atomic<int64_t> live_bytes{ 0 };
+		std::atomic<int64_t> peak_bytes{ 0 };
+		std::atomic<uint64_t> allocated_bytes{ 0 };
+		std::atomic<uint64_t> allocations_count{ 0 };
+		std::atomic<uint64_t> size_histogram[MEMORY_HISTOGRAM_BUCKETS];
+
+		Counters();
+		void reset();
+		void allocate(size_t bytes);
+		void deallocate(size_t bytes);
+		MemoryStats getStats() const;
+	};
+
+	static std::atomic<bool> _enabled;
+	static Counters _counters;
+	static std::mutex _scopes_mutex;
+	static std::map<std::string, Counters> _scopes;
+	static thread_local Counters* _scope_counters;
+
+	static Counters* getScopeCounters(const std::string& name);
+};
+
+#define MEMORY_ALLOCATION_HEADER_SIZE (alignof(std::max_align_t))
+
+// Attributes allocations of the current thread to a named scope until destroyed.
+// Scopes nest, allocations count only to the innermost one.
+class MemoryScope {
+public:
+	explicit MemoryScope(const char* name);
+	explicit MemoryScope(const std::string& name);
+	// indexed scope, e.g. of a layer, its name is built only when tracking is enabled
+	MemoryScope(const char* name, uint32_t index);
+	~MemoryScope();
+
+	MemoryScope(const MemoryScope&) = delete;
+	MemoryScope& operator=(const MemoryScope&) = delete;
+
+private:
+	MemoryTracker::Counters* _prev_counters{ nullptr };
+	bool _active{ false };
+
+	void enter(const std::string& name);
+};
+
+template <typename T>
+struct TrackingAllocator {
+	typedef T value_type;
+
+	TrackingAllocator() noexcept {}
+	template <typename U>
+	TrackingAllocator(const TrackingAllocator<U>&) noexcept {}
+
+	T* allocate(size_t n) {
+		return static_cast<T*>(MemoryTracker::allocate(n * sizeof(T)));
+	}
+
+	void deallocate(T* p, size_t n) noexcept {
+		MemoryTracker::deallocate(p, n * sizeof(T));
+	}
+
+	template <typename U>
+	bool operator==(const TrackingAllocator<U>&) const noexcept { return true; }
+	template <typename U>
+	bool operator!=(const TrackingAllocator<U>&) const noexcept { return false; }
+};
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "Metrics.h"
+
+#include <cmath>
+
+Stopwatch::Stopwatch() {
+	_start = Clock::now();
+	_lap_start = _start;
+}
+
+double Stopwatch::lap() {
+	Clock::time_point now = Clock::now();
+	double result = std::chrono::duration<double>(now - _lap_start).count();
+	_lap_start = now;
+	return result;
+}
+
+double Stopwatch::elapsed() const {
+	return std::chrono::duration<double>(Clock::now() - _start).count();
+}
+
+PhaseTimes& PhaseTimes::operator+=(const PhaseTimes& other) {
+	data_sec += other.data_sec;
+	forward_sec += other.forward_sec;
+	backward_sec += other.backward_sec;
+	update_sec += other.update_sec;
+
+	return *this;
+}
+
+MetricsWriter::MetricsWriter() {
+}
+
+MetricsWriter::~MetricsWriter() {
+	close();
+}
+
+bool MetricsWriter::open(const std::string& path) {
+	close();
+	_file = fopen(path.c_str(), "a");
+	return nullptr != _file;
+}
+
+bool MetricsWriter::isOpen() const {
+	return nullptr != _file;
+}
+
+void MetricsWriter::close() {
+	if (_file) {
+		fclose(_file);
+		_file = nullptr;
+	}
+}
+
+static void writeNumber(FILE* file, const char* key, double value) {
+	// JSON has no NaN or infinity
+	if (std::isfinite(value)) {
+		fprintf(file, ", \"%s\": %.9g", key, value);
+	}
+	else {
+		fprintf(file, ", \"%s\": null", key);
+	}
+}
+
+static void writePhases(FILE* file, const PhaseTimes& phases) {
+	writeNumber(file, "data_sec", phases.data_sec);
+	writeNumber(file, "forward_sec", phases.forward_sec);
+	writeNumber(file, "backward_sec", phases.backward_sec);
+	writeNumber(file, "update_sec", phases.update_sec);
+}
+
+void MetricsWriter::write(const BatchMetrics& metrics) {
+	if (!_file) {
+		return;
+	}
+
+	fprintf(_file, "{\"type\": \"batch\", \"epoch\": %u, \"batch\": %u, \"samples\": %u", metrics.epoch, metrics.batch, metrics.samples);
+	writeNumber(_file, "cost", metrics.cost);
+	writeNumber(_file, "wall_sec", metrics.wall_sec);
+	writeNumber(_file, "samples_per_sec", metrics.samples_per_sec);
+	writePhases(_file, metrics.phases);
+	fprintf(_file, "}\n");
+	fflush(_file);
+}
+
+void MetricsWriter::write(const EpochMetrics& metrics) {
+	if (!_file) {
+		return;
+	}
+
+	fprintf(_file, "{\"type\": \"epoch\", \"epoch\": %u, \"batches\": %u, \"samples\": %u", metrics.epoch, metrics.batches_count, metrics.samples);
+	writeNumber(_file, "train_cost", metrics.train_cost);
+	writeNumber(_file, "test_cost", metrics.test_cost);
+	writeNumber(_file, "wall_sec", metrics.wall_sec);
+	writeNumber(_file, "train_sec", metrics.train_sec);
+	writeNumber(_file, "test_sec", metrics.test_sec);
+	writeNumber(_file, "samples_per_sec", metrics.samples_per_sec);
+	writePhases(_file, metrics.phases);
+	fprintf(_file, "}\n");
+	fflush(_file);
+}
\ No newline at end of file
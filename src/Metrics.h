@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <chrono>
+#include <string>
+
+// Measures consecutive intervals with the monotonic clock.
+class Stopwatch {
+public:
+	Stopwatch();
+
+	// seconds since construction or the previous lap
+	double lap();
+	// seconds since construction, does not start a new lap
+	double elapsed() const;
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	Clock::time_point _start;
+	Clock::time_point _lap_start;
+};
+
+// Wall time of one training step split into phases.
+struct PhaseTimes {
+	double data_sec{ 0.0 };
+	double forward_sec{ 0.0 };
+	double backward_sec{ 0.0 };
+	double update_sec{ 0.0 };
+
+	PhaseTimes& operator+=(const PhaseTimes& other);
+};
+
+struct BatchMetrics {
+	uint32_t epoch;
+	uint32_t batch;
+	uint32_t samples;
+	float cost;
+	double wall_sec;
+	double samples_per_sec;
+	PhaseTimes phases;
+};
+
+struct EpochMetrics {
+	uint32_t epoch;
+	uint32_t batches_count;
+	uint32_t samples;
+	float train_cost;
+	float test_cost;
+	double wall_sec;
+	double train_sec;
+	double test_sec;
+	double samples_per_sec;
+	PhaseTimes phases;
+};
+
+// Writes metrics as JSON lines, one object per batch or epoch, flushed after every line.
+class MetricsWriter {
+public:
+	MetricsWriter();
+	~MetricsWriter();
+
+	MetricsWriter(const MetricsWriter&) = delete;
+	MetricsWriter& operator=(const MetricsWriter&) = delete;
+
+	bool open(const std::string& path);
+	bool isOpen() const;
+	void close();
+	void write(const BatchMetrics& metrics);
+	void write(const EpochMetrics& metrics);
+
+private:
+	FILE* _file{ nullptr };
+};
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include "NeuralNetwork.h"
 
+// memory of layer i is tracked in scope "layer i"
+#define LAYER_MEMORY_SCOPE "layer"
+
 extern double g_time;
 
 NeuralNetwork::NeuralNetwork(Layer& input_layer, Layer& output_layer, float(*cost_function)(const Tensor&, const Tensor&), const Tensor(*cost_function_d)(const Tensor&, const Tensor&)) {
@@ -7,6 +10,7 @@ NeuralNetwork::NeuralNetwork(Layer& input_layer, Layer& output_layer, float(*cos
 	_output_layer = &output_layer;
 	_cost_function = cost_function;
 	_cost_function_d = cost_function_d;
+	setLayersFusion(true);
 }
 
 NeuralNetwork::NeuralNetwork(Layer& input_layer, Layer& output_layer, CostFun cost_fun) {
@@ -22,33 +26,84 @@ NeuralNetwork::NeuralNetwork(Layer& input_layer, Layer& output_layer, CostFun co
 		_cost_function_d = nullptr;
 		// exception
 	}
+	setLayersFusion(true);
 }
 
 float(*NeuralNetwork::getCostFun())(const Tensor&, const Tensor&) {
 	return _cost_function;
 }
 
+std::vector<uint32_t> NeuralNetwork::getInputShape() const {
+	return _input_layer->getInputShape();
+}
+
+std::vector<uint32_t> NeuralNetwork::getOutputShape() const {
+	return _output_layer->getOutputShape();
+}
+
 const Tensor NeuralNetwork::predict(const Tensor& input) {
+	// layers run in inference mode, e.g. dropout passes values through, no activations are cached
+	ExecutionContext context;
+	return predict(input, context);
+}
+
+const Tensor NeuralNetwork::forwardPropagation(const Tensor& input) {
 	Layer* layer;
 	Tensor output;
+	uint32_t idx{ 0 };
+
+	if (!_checkpoints.empty() || (_activation_memory_budget > 0)) {
+		return forwardPropagationCheckpointed(input);
+	}
 
 	layer = _input_layer;
-	output = layer->forwardPropagation(input);
+	{
+		MemoryScope scope(LAYER_MEMORY_SCOPE, idx++);
+		output = layer->forwardPropagation(input);
+	}
 
 	while (layer != _output_layer) {
 		layer = layer->getNextLayer();
-		output = layer->forwardPropagation(output);
+		MemoryScope scope(LAYER_MEMORY_SCOPE, idx++);
+		layer->forwardPropagationInPlace(output);
 	}
 
 	return output;
 }
 
-FitHistory NeuralNetwork::fit(const Tensor& train_x, const Tensor& train_y, const Tensor& test_x, const Tensor& test_y, uint32_t batch_size, uint32_t epochs, float learning_step, uint8_t verbose) {
+const Tensor& NeuralNetwork::predict(const Tensor& input, ExecutionContext& context) const {
+	// layers are only read, so threads with own contexts can share one network
+	const Layer* layer = _input_layer;
+	const Tensor* output = &input;
+	uint32_t idx{ 0 };
+
+	prepareInference();
+
+	while (true) {
+		Tensor& result = context.getBuffer(idx++);
+		layer->infer(*output, result);
+		output = &result;
+
+		if (layer == _output_layer) {
+			break;
+		}
+		layer = layer->getNextLayer();
+	}
+
+	return *output;
+}
+
+FitHistory NeuralNetwork::fit(const Tensor& train_x, const Tensor& train_y, const Tensor& test_x, const Tensor& test_y, uint32_t batch_size, uint32_t epochs, float learning_step, uint8_t verbose, DataType precision, uint32_t accumulation_steps) {
 	FitHistory result;
-	Layer* layer;
 	uint32_t epoch{ 0 };
 	uint32_t batch_start{ 0 };
 
+	if ((0 == accumulation_steps) || (0 != batch_size % accumulation_steps)) {
+		printf("EXCEPTION %d\n", __LINE__);
+		throw std::invalid_argument(""); // exception
+	}
+	uint32_t micro_batch_size = batch_size / accumulation_steps;
+
 	result.length = epochs;
 
 	result.test_cost = (float*)malloc(sizeof(float) * epochs);
@@ -60,46 +115,71 @@ FitHistory NeuralNetwork::fit(const Tensor& train_x, const Tensor& train_y, cons
 		// exception
 	}
 
+	// mixed precision: activations and forward weights in 16 bits, fp32 master weights
+	setLayersPrecision(precision);
+	// gradients are cleared after every update, ready for the next batch
+	initLayersCachedGradient();
+
 	for (epoch = 0; epoch < epochs; ++epoch) {
-		uint32_t* permutation = genPermutation(train_x.getShape()[0]);
+		Stopwatch epoch_watch;
+		Stopwatch phase_watch;
+		EpochMetrics epoch_metrics{};
+		epoch_metrics.epoch = epoch;
+
+		uint32_t* permutation = _shuffle_seed ? genPermutation(train_x.getShape()[0], _shuffle_seed + epoch) : genPermutation(train_x.getShape()[0]);
 
 		Tensor train_x_shuffled = train_x.shuffle(permutation);
 		Tensor train_y_shuffled = train_y.shuffle(permutation);
 
 		free(permutation);
+		epoch_metrics.phases.data_sec += phase_watch.lap();
 
 		float train_cost{ 0.0f };
 		float test_cost{ 0.0f };
 		uint32_t batch_count{ 0 };
 
-
-		double train_start = perf_counter_ns();
 		for (batch_start = 0; batch_start + batch_size <= train_x.getShape()[0]; batch_start += batch_size) {
-			initLayersCachedGradient();
-
-			Tensor batch_x = train_x_shuffled.slice(0, batch_start, batch_start + batch_size);
-			Tensor batch_y = train_y_shuffled.slice(0, batch_start, batch_start + batch_size);
-
-			Tensor y_hat = predict(batch_x);
-
-			float batch_cost = _cost_function(y_hat, batch_y);
-
-			layer = _output_layer;
-
-			Tensor dx = _cost_function_d(y_hat, batch_y);
-			dx = layer->backwardPropagation(dx);
-
-			while (layer != _input_layer) {
-				layer = layer->getPrevLayer();
-				std::vector<uint32_t> dx_new_shape = layer->getOutputShape();
-				dx_new_shape.insert(dx_new_shape.begin(), dx.getShape()[0]);
-				dx = dx.reshape(dx_new_shape);
-				dx = layer->backwardPropagation(dx);
+			Stopwatch batch_watch;
+			BatchMetrics batch_metrics{};
+			batch_metrics.epoch = epoch;
+			batch_metrics.batch = batch_count;
+			batch_metrics.samples = batch_size;
+			phase_watch.lap();
+
+			float batch_cost{ 0.0f };
+			for (uint32_t micro_start = batch_start; micro_start < batch_start + batch_size; micro_start += micro_batch_size) {
+				Tensor batch_x = train_x_shuffled.slice(0, micro_start, micro_start + micro_batch_size);
+				Tensor batch_y = train_y_shuffled.slice(0, micro_start, micro_start + micro_batch_size);
+				batch_metrics.phases.data_sec += phase_watch.lap();
+
+				Tensor y_hat = forwardPropagation(batch_x);
+
+				batch_cost += _cost_function(y_hat, batch_y) / accumulation_steps;
+				batch_metrics.phases.forward_sec += phase_watch.lap();
+
+				backwardPropagation(y_hat, batch_y);
+				batch_metrics.phases.backward_sec += phase_watch.lap();
 			}
 
+			updateLayersWeights(learning_step);
+			initLayersCachedGradient();
+			batch_metrics.phases.update_sec = phase_watch.lap();
+
 			train_cost += batch_cost;
 			++batch_count;
 
+			batch_metrics.cost = batch_cost;
+			batch_metrics.wall_sec = batch_watch.elapsed();
+			batch_metrics.samples_per_sec = batch_size / batch_metrics.wall_sec;
+			epoch_metrics.phases += batch_metrics.phases;
+			if (_batch_history_limit > 0) {
+				if (result.batches.size() == _batch_history_limit) {
+					result.batches.pop_front();
+				}
+				result.batches.push_back(batch_metrics);
+			}
+			_metrics_writer.write(batch_metrics);
+
 			uint32_t done = batch_start / batch_size + 1;
 			uint32_t total = train_x.getShape()[0] / batch_size;
 			
@@ -107,19 +187,20 @@ FitHistory NeuralNetwork::fit(const Tensor& train_x, const Tensor& train_y, cons
 				printf("\r%4d ", epoch + 1);
 				print_progress(static_cast<float>(done) / total);
 				printf(" ");
-				print_time(TIME_DIFF_SEC(train_start, perf_counter_ns()) * (total - done) / done);
+				print_time(epoch_watch.elapsed() * (total - done) / done);
 				printf(" train cost: %f", train_cost / batch_count);
 				fflush(stdout);
 			}
-
-			updateLayersWeights(learning_step);
-
 		}
+		epoch_metrics.train_sec = epoch_watch.elapsed();
+		epoch_metrics.batches_count = batch_count;
+		epoch_metrics.samples = batch_count * batch_size;
+
 		if (verbose >= 1) {
 			printf("\r%4d ", epoch + 1);
 			print_progress(1.0f);
 			printf(" ");
-			print_time(TIME_DIFF_SEC(train_start, perf_counter_ns()));
+			print_time(epoch_metrics.train_sec);
 			printf(" train cost: %f", train_cost / batch_count);
 			fflush(stdout);
 		}
@@ -142,24 +223,337 @@ FitHistory NeuralNetwork::fit(const Tensor& train_x, const Tensor& train_y, cons
 		}
 
 		result.test_cost[epoch] = test_cost / batch_count;
+
+		epoch_metrics.train_cost = result.train_cost[epoch];
+		epoch_metrics.test_cost = result.test_cost[epoch];
+		epoch_metrics.wall_sec = epoch_watch.elapsed();
+		epoch_metrics.test_sec = epoch_metrics.wall_sec - epoch_metrics.train_sec;
+		epoch_metrics.samples_per_sec = epoch_metrics.samples / epoch_metrics.train_sec;
+		result.epochs.push_back(epoch_metrics);
+		_metrics_writer.write(epoch_metrics);
 	}
 
+	setLayersPrecision(DataType::Float32);
+
 	return result;
 }
 
+void NeuralNetwork::setCheckpoints(const std::vector<uint32_t>& segment_starts) {
+	std::vector<uint32_t> checkpoints = segment_starts;
+	std::sort(checkpoints.begin(), checkpoints.end());
+	checkpoints.erase(std::unique(checkpoints.begin(), checkpoints.end()), checkpoints.end());
+
+	if (!checkpoints.empty() && (checkpoints.back() >= getLayersCount())) {
+		printf("EXCEPTION %d\n", __LINE__);
+		throw std::invalid_argument(""); // exception
+	}
+	// first segment always starts at the input layer
+	if (!checkpoints.empty() && (checkpoints[0] != 0)) {
+		checkpoints.insert(checkpoints.begin(), 0);
+	}
+
+	_checkpoints = checkpoints;
+	_checkpoint_inputs.clear();
+	_activation_memory_budget = 0;
+	_checkpoints_batch_size = 0;
+}
+
+void NeuralNetwork::setActivationMemoryBudget(uint64_t bytes) {
+	_checkpoints.clear();
+	_checkpoint_inputs.clear();
+	_activation_memory_budget = bytes;
+	_checkpoints_batch_size = 0;
+}
+
+std::vector<uint32_t> NeuralNetwork::getCheckpoints() const {
+	return _checkpoints;
+}
+
+uint64_t NeuralNetwork::getActivationMemory(uint32_t batch_size) const {
+	uint64_t value_bytes = (DataType::Float32 == _precision) ? sizeof(float) : sizeof(uint16_t);
+	uint64_t result{ 0 };
+
+	for (const Layer* layer : getLayers()) {
+		uint64_t input_size = batch_size;
+		uint64_t output_size = batch_size;
+		for (auto s : layer->getInputShape()) {
+			input_size *= s;
+		}
+		for (auto s : layer->getOutputShape()) {
+			output_size *= s;
+		}
+		result += (input_size + output_size) * value_bytes;
+	}
+	return result;
+}
+
+void NeuralNetwork::planCheckpoints(uint32_t batch_size) {
+	std::vector<Layer*> layers = getLayers();
+	uint32_t n = layers.size();
+	uint64_t value_bytes = (DataType::Float32 == _precision) ? sizeof(float) : sizeof(uint16_t);
+
+	// cached activations of each layer and size of its input kept as a checkpoint
+	std::vector<uint64_t> cache_bytes(n);
+	std::vector<uint64_t> input_bytes(n);
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		uint64_t input_size = batch_size;
+		uint64_t output_size = batch_size;
+		for (auto s : layers[i]->getInputShape()) {
+			input_size *= s;
+		}
+		for (auto s : layers[i]->getOutputShape()) {
+			output_size *= s;
+		}
+		cache_bytes[i] = (input_size + output_size) * value_bytes;
+		input_bytes[i] = input_size * sizeof(float);
+	}
+
+	// segments are formed greedily for every candidate segment size, the plan that fits the budget
+	// with the least recomputation wins, if none fits the one with the least memory
+	std::vector<uint32_t> best;
+	uint64_t best_memory{ 0 };
+	uint64_t best_recompute{ 0 };
+	bool best_fits{ false };
+
+	for (uint32_t a{ 0 }; a < n; ++a) {
+		uint64_t limit{ 0 };
+		for (uint32_t b{ a }; b < n; ++b) {
+			limit += cache_bytes[b];
+
+			std::vector<uint32_t> starts = { 0 };
+			uint64_t segment{ 0 };
+			uint64_t max_segment{ 0 };
+			for (uint32_t i{ 0 }; i < n; ++i) {
+				if ((i > starts.back()) && (segment + cache_bytes[i] > limit)) {
+					starts.push_back(i);
+					segment = 0;
+				}
+				segment += cache_bytes[i];
+				max_segment = std::max(max_segment, segment);
+			}
+
+			// inputs of all but the last segment are kept while the last one is cached
+			uint64_t memory{ max_segment };
+			uint64_t recompute{ 0 };
+			for (uint32_t s{ 0 }; s + 1 < starts.size(); ++s) {
+				memory += input_bytes[starts[s]];
+			}
+			for (uint32_t i{ 0 }; i < starts.back(); ++i) {
+				recompute += cache_bytes[i];
+			}
+
+			bool fits = memory <= _activation_memory_budget;
+			bool better = best.empty() ||
+						  (fits && !best_fits) ||
+						  (fits && best_fits && ((recompute < best_recompute) || ((recompute == best_recompute) && (memory < best_memory)))) ||
+						  (!fits && !best_fits && (memory < best_memory));
+			if (better) {
+				best = starts;
+				best_memory = memory;
+				best_recompute = recompute;
+				best_fits = fits;
+			}
+		}
+	}
+
+	_checkpoints = best;
+	_checkpoints_batch_size = batch_size;
+}
+
+const Tensor NeuralNetwork::forwardPropagationCheckpointed(const Tensor& input) {
+	std::vector<Layer*> layers = getLayers();
+
+	if ((_activation_memory_budget > 0) && (_checkpoints_batch_size != input.getShape()[0])) {
+		planCheckpoints(input.getShape()[0]);
+	}
+
+	uint32_t segments_count = _checkpoints.size();
+	uint32_t segment{ 0 };
+	Tensor output;
+
+	_checkpoint_inputs.resize(segments_count);
+
+	for (uint32_t i{ 0 }; i < layers.size(); ++i) {
+		MemoryScope scope(LAYER_MEMORY_SCOPE, i);
+
+		if ((segment + 1 < segments_count) && (i == _checkpoints[segment + 1])) {
+			++segment;
+		}
+
+		if ((segment + 1 < segments_count) && (i == _checkpoints[segment])) {
+			_checkpoint_inputs[segment] = (0 == i) ? input : output;
+		}
+		if (0 == i) {
+			output = layers[i]->forwardPropagation(input);
+		}
+		else {
+			layers[i]->forwardPropagationInPlace(output);
+		}
+
+		if (segment + 1 == segments_count) {
+			// last segment is cached right away, backward propagation starts with it
+			_checkpoint_inputs[segment].release();
+		}
+		else {
+			// training forward pass, e.g. batch statistics, its cache is dropped right away
+			layers[i]->releaseCache();
+		}
+	}
+
+	return output;
+}
+
+void NeuralNetwork::backwardPropagationCheckpointed(const Tensor& y_hat, const Tensor& y) {
+	std::vector<Layer*> layers = getLayers();
+	uint32_t segments_count = _checkpoints.size();
+
+	if (_checkpoint_inputs.size() != segments_count) {
+		printf("EXCEPTION %d\n", __LINE__);
+		throw std::invalid_argument(""); // exception
+	}
+
+	Tensor dx = _cost_function_d(y_hat, y);
+
+	for (uint32_t segment{ segments_count }; segment-- > 0;) {
+		uint32_t begin = _checkpoints[segment];
+		uint32_t end = (segment + 1 < segments_count) ? _checkpoints[segment + 1] : layers.size();
+
+		// recompute activations of the segment from its checkpoint
+		if (segment + 1 < segments_count) {
+			Tensor output = _checkpoint_inputs[segment];
+			for (uint32_t i{ begin }; i < end; ++i) {
+				MemoryScope scope(LAYER_MEMORY_SCOPE, i);
+				layers[i]->forwardPropagationInPlace(output);
+			}
+		}
+		_checkpoint_inputs[segment].release();
+
+		for (uint32_t i{ end }; i-- > begin;) {
+			MemoryScope scope(LAYER_MEMORY_SCOPE, i);
+			if (i + 1 < layers.size()) {
+				std::vector<uint32_t> dx_new_shape = layers[i]->getOutputShape();
+				dx_new_shape.insert(dx_new_shape.begin(), dx.getShape()[0]);
+				dx = dx.reshape(dx_new_shape);
+			}
+			layers[i]->backwardPropagationInPlace(dx);
+			layers[i]->releaseCache();
+		}
+	}
+}
+
+bool NeuralNetwork::setMetricsOutput(const std::string& path) {
+	if (path.empty()) {
+		_metrics_writer.close();
+		return true;
+	}
+	return _metrics_writer.open(path);
+}
+
+void NeuralNetwork::setBatchHistoryLimit(uint32_t limit) {
+	_batch_history_limit = limit;
+}
+
+void NeuralNetwork::setShuffleSeed(uint32_t seed) {
+	_shuffle_seed = seed;
+}
+
+void NeuralNetwork::quantize(const Tensor& calibration_x) {
+	Layer* layer;
+	Tensor output;
+
+	// each layer is calibrated on outputs of already quantized layers before it
+	layer = _input_layer;
+	layer->quantize(calibration_x);
+	layer->infer(calibration_x, output);
+
+	while (layer != _output_layer) {
+		Tensor next_output;
+		layer = layer->getNextLayer();
+		layer->quantize(output);
+		layer->infer(output, next_output);
+		output = next_output;
+	}
+}
+
+void NeuralNetwork::setLayersFusion(bool enabled) {
+	Layer* layer;
+
+	_layers_fusion = enabled;
+
+	// layer followed by an activation layer applies the activation itself, activation layer passes values through
+	layer = _input_layer;
+
+	while (layer != _output_layer) {
+		Layer* next_layer = layer->getNextLayer();
+		ActivationFun activation_fun;
+		bool fused = enabled &&
+					 next_layer->getFusableActivation(activation_fun) &&
+					 layer->fuseActivation(activation_fun);
+		if (!fused) {
+			layer->unfuseActivation();
+		}
+		next_layer->setPassThrough(fused);
+		layer = next_layer;
+	}
+
+	setLayersFolding(false);
+	_folding_dirty = enabled;
+}
+
+void NeuralNetwork::prepareInference() const {
+	if (!_folding_dirty.load(std::memory_order_acquire)) {
+		return;
+	}
+	// threads sharing the network fold it once, the others wait for the folded weights
+	std::lock_guard<std::mutex> lock(_folding_mutex);
+	if (_folding_dirty.load(std::memory_order_relaxed)) {
+		setLayersFolding(true);
+		_folding_dirty.store(false, std::memory_order_release);
+	}
+}
+
+void NeuralNetwork::setLayersFolding(bool enabled) const {
+	Layer* layer;
+
+	// layer followed by a per-channel scale and shift applies it with its own weights during inference,
+	// the following layer passes values through
+	layer = _input_layer;
+
+	while (layer != _output_layer) {
+		Layer* next_layer = layer->getNextLayer();
+		Tensor scale, shift;
+		if (next_layer->getFoldableScaleShift(scale, shift)) {
+			layer->unfoldScaleShift();
+			bool folded = enabled && layer->foldScaleShift(scale, shift);
+			next_layer->setPassThrough(folded);
+		}
+		layer = next_layer;
+	}
+}
+
 void NeuralNetwork::summary() const {
 	Layer *layer{ _input_layer };
 	uint32_t total_params{ 0u };
+	uint32_t idx{ 0u };
 
 	while (1) {
 		layer->summary();
+		// memory used by the layer since tracking was enabled, e.g. during the last training step
+		if (MemoryTracker::isEnabled()) {
+			MemoryTracker::printStats(MemoryTracker::getScopeStats(MemoryTracker::getScopeName(LAYER_MEMORY_SCOPE, idx)));
+		}
 		total_params += layer->getParamsCount();
+		++idx;
 		if (layer == _output_layer) {
 			break;
 		}
 		layer = layer->getNextLayer();
 	}
 	printf("total params: %d\n", total_params);
+	if (MemoryTracker::isEnabled()) {
+		printf("total");
+		MemoryTracker::printStats(MemoryTracker::getStats());
+	}
 }
 
 float NeuralNetwork::binary_crossentropy(const Tensor& y_hat, const Tensor& y) {
@@ -172,16 +566,74 @@ const Tensor NeuralNetwork::binary_crossentropy_d(const Tensor& y_hat, const Ten
 	return -result;
 }
 
+void NeuralNetwork::backwardPropagation(const Tensor& y_hat, const Tensor& y) {
+	Layer* layer;
+	uint32_t idx{ getLayersCount() - 1 };
+
+	if (!_checkpoints.empty()) {
+		backwardPropagationCheckpointed(y_hat, y);
+		return;
+	}
+
+	layer = _output_layer;
+
+	Tensor dx = _cost_function_d(y_hat, y);
+	{
+		MemoryScope scope(LAYER_MEMORY_SCOPE, idx--);
+		layer->backwardPropagationInPlace(dx);
+	}
+
+	while (layer != _input_layer) {
+		layer = layer->getPrevLayer();
+		MemoryScope scope(LAYER_MEMORY_SCOPE, idx--);
+		std::vector<uint32_t> dx_new_shape = layer->getOutputShape();
+		dx_new_shape.insert(dx_new_shape.begin(), dx.getShape()[0]);
+		dx = dx.reshape(dx_new_shape);
+		layer->backwardPropagationInPlace(dx);
+	}
+}
+
 void NeuralNetwork::updateLayersWeights(float learning_step) {
 	Layer* layer;
+	uint32_t idx{ 0 };
 
 	layer = _input_layer;
-	layer->updateWeights(learning_step);
+	{
+		MemoryScope scope(LAYER_MEMORY_SCOPE, idx++);
+		layer->updateWeights(learning_step);
+	}
 
 	while (layer != _output_layer) {
 		layer = layer->getNextLayer();
+		MemoryScope scope(LAYER_MEMORY_SCOPE, idx++);
 		layer->updateWeights(learning_step);
 	}
+
+	// folded weights are stale, their copies are freed until the next inference folds them again
+	if (_layers_fusion && !_folding_dirty) {
+		setLayersFolding(false);
+		_folding_dirty = true;
+	}
+}
+
+uint32_t NeuralNetwork::getLayersCount() const {
+	const Layer* layer{ _input_layer };
+	uint32_t result{ 1 };
+
+	while (layer != _output_layer) {
+		layer = layer->getNextLayer();
+		++result;
+	}
+	return result;
+}
+
+std::vector<Layer*> NeuralNetwork::getLayers() const {
+	std::vector<Layer*> result = { _input_layer };
+
+	while (result.back() != _output_layer) {
+		result.push_back(result.back()->getNextLayer());
+	}
+	return result;
 }
 
 void NeuralNetwork::initLayersCachedGradient() {
@@ -196,6 +648,20 @@ void NeuralNetwork::initLayersCachedGradient() {
 	}
 }
 
+void NeuralNetwork::setLayersPrecision(DataType dtype) {
+	Layer* layer;
+
+	_precision = dtype;
+
+	layer = _input_layer;
+	layer->setPrecision(dtype);
+
+	while (layer != _output_layer) {
+		layer = layer->getNextLayer();
+		layer->setPrecision(dtype);
+	}
+}
+
 void NeuralNetwork::print_progress(float percent) {
 	uint32_t i{ 0 };
 	bool arrow = true;
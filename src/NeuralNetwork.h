@@ -1,19 +1,30 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <cstdio>
 #include <chrono>
 #include <cmath>
+#include <deque>
+#include <mutex>
+#include <string>
 
 #include "Layer.h"
+#include "ExecutionContext.h"
+#include "MemoryTracker.h"
+#include "Metrics.h"
 #include "Utils.h"
 
-#define TIME_DIFF_SEC(t_start, t_end) (float(t_end - t_start) / (CLOCKS_PER_SEC * 1000LL))
+#define FIT_HISTORY_BATCHES_LIMIT (4096u)
 
 struct FitHistory {
 	uint32_t length;
 	float* train_cost;
 	float* test_cost;
+	std::vector<EpochMetrics> epochs;
+	// only the last batches, see NeuralNetwork::setBatchHistoryLimit
+	std::deque<BatchMetrics> batches;
 };
 
 enum class CostFun {
@@ -26,9 +37,39 @@ public:
 	NeuralNetwork(Layer& input_layer, Layer& output_layer, CostFun cost_fun);
 
 	float(*getCostFun())(const Tensor&, const Tensor&);
+	std::vector<uint32_t> getInputShape() const;
+	std::vector<uint32_t> getOutputShape() const;
+	// inference, fit uses it for test cost, training steps use forwardPropagation
 	const Tensor predict(const Tensor& input);
-	FitHistory fit(const Tensor& train_x, const Tensor& train_y, const Tensor& test_x, const Tensor& test_y, uint32_t batch_size, uint32_t epochs, float learning_step, uint8_t verbose=1u);
+	const Tensor& predict(const Tensor& input, ExecutionContext& context) const;
+	// accumulation_steps splits every batch into micro-batches, weights are updated once per batch
+	FitHistory fit(const Tensor& train_x, const Tensor& train_y, const Tensor& test_x, const Tensor& test_y, uint32_t batch_size, uint32_t epochs, float learning_step, uint8_t verbose=1u, DataType precision=DataType::Float32, uint32_t accumulation_steps=1u);
 
+	// single training step split into phases, fit runs them for every batch
+	void initLayersCachedGradient();
+	// caches activations for backward propagation, keeps only checkpoints when checkpointing is set
+	const Tensor forwardPropagation(const Tensor& input);
+	void backwardPropagation(const Tensor& y_hat, const Tensor& y);
+	void updateLayersWeights(float learning_step);
+
+	// gradient checkpointing: during training forward pass only inputs of segment start layers are kept,
+	// activations inside a segment are recomputed when backward propagation reaches it
+	void setCheckpoints(const std::vector<uint32_t>& segment_starts);
+	// chooses segments for every batch size so cached activations fit the budget, 0 disables checkpointing
+	void setActivationMemoryBudget(uint64_t bytes);
+	std::vector<uint32_t> getCheckpoints() const;
+	// bytes of activations cached by forward propagation without checkpointing
+	uint64_t getActivationMemory(uint32_t batch_size) const;
+
+	// appends per-batch and per-epoch metrics of fit to a JSON-lines file, empty path stops it
+	bool setMetricsOutput(const std::string& path);
+	// FitHistory keeps metrics of at most the last limit batches, 0 keeps none, metrics output gets all of them
+	void setBatchHistoryLimit(uint32_t limit);
+	// seeds shuffling of training samples in fit, every epoch uses the next seed, 0 seeds it with time
+	void setShuffleSeed(uint32_t seed);
+	void quantize(const Tensor& calibration_x);
+	// activation layers are fused into the layer before them, batch normalization is folded into it for inference
+	void setLayersFusion(bool enabled);
 	void summary() const;
 
 	static float binary_crossentropy(const Tensor& y_hat, const Tensor& y);
@@ -39,9 +80,28 @@ private:
 	Layer* _output_layer;
 	float(*_cost_function)(const Tensor& y_hat, const Tensor& y);
 	const Tensor (*_cost_function_d)(const Tensor& y_hat, const Tensor& y);
+	MetricsWriter _metrics_writer;
+	DataType _precision{ DataType::Float32 };
+	bool _layers_fusion{ false };
+	uint32_t _shuffle_seed{ 0 };
+	uint32_t _batch_history_limit{ FIT_HISTORY_BATCHES_LIMIT };
+	// folded weights are built by the first inference after weights change and released when training resumes
+	mutable std::atomic<bool> _folding_dirty{ false };
+	mutable std::mutex _folding_mutex;
 
-	void updateLayersWeights(float learning_step);
-	void initLayersCachedGradient();
+	std::vector<uint32_t> _checkpoints;
+	std::vector<Tensor> _checkpoint_inputs;
+	uint64_t _activation_memory_budget{ 0 };
+	uint32_t _checkpoints_batch_size{ 0 };
+
+	void setLayersPrecision(DataType dtype);
+	void setLayersFolding(bool enabled) const;
+	void prepareInference() const;
+	uint32_t getLayersCount() const;
+	std::vector<Layer*> getLayers() const;
+	void planCheckpoints(uint32_t batch_size);
+	const Tensor forwardPropagationCheckpointed(const Tensor& input);
+	void backwardPropagationCheckpointed(const Tensor& y_hat, const Tensor& y);
 
 	static void print_progress(float percent);
 	static void print_time(double seconds);
@@ -0,0 +1,120 @@
+#include "PointwiseConv2DLayer.h"
+#include "TensorKernels.h"
+
+PointwiseConv2DLayer::PointwiseConv2DLayer(std::vector<uint32_t> input_shape, uint32_t filters_count) : Layer() {
+	_input_shape = input_shape;
+	if (2 == _input_shape.size()) {
+		_input_shape.push_back(1);
+	}
+	else if (3 != _input_shape.size()) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	initWeights(filters_count);
+}
+
+PointwiseConv2DLayer::PointwiseConv2DLayer(Layer& prev_layer, uint32_t filters_count) : Layer() {
+	_input_shape = prev_layer.getOutputShape();
+	if (2 == _input_shape.size()) {
+		_input_shape.push_back(1);
+	}
+	else if (3 != _input_shape.size()) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	initWeights(filters_count);
+	this->setPrevLayer(&prev_layer);
+	prev_layer.setNextLayer(this);
+}
+
+void PointwiseConv2DLayer::setWeights(std::vector<float> weights) {
+	_weights.setValues(weights);
+}
+
+void PointwiseConv2DLayer::setBiases(std::vector<float> biases) {
+	_biases.setValues(biases);
+}
+
+void PointwiseConv2DLayer::initWeights(uint32_t filters_count) {
+	uint32_t channels = _input_shape[2];
+
+	_filters_count = filters_count;
+	_output_shape = { _input_shape[0], _input_shape[1], filters_count };
+
+	// same layout as 1x1 Conv2DLayer weights
+	_weights = Tensor({ channels, filters_count }).applyFunction([](float value) { return randUniform(-1.0f, 1.0f); });
+	_weights *= sqrtf(6.0f / channels);
+
+	_biases = Tensor({ filters_count });
+}
+
+void PointwiseConv2DLayer::initCachedGradient() {
+	_cached_weights_d = Tensor(_weights.getShape());
+	_cached_biases_d = Tensor(_biases.getShape());
+	_samples = 0;
+}
+
+void PointwiseConv2DLayer::summary() const {
+	printf("PointwiseConv2D Layer\n");
+	printf("  in shape:  (*");
+	for (uint32_t i{ 0u }; i < _input_shape.size(); ++i) {
+		printf(", %d", _input_shape[i]);
+	}
+	printf(")  ");
+	printf("  out shape: (*");
+	for (uint32_t i { 0u }; i < _output_shape.size(); ++i) {
+		printf(", %d", _output_shape[i]);
+	}
+	printf(")  total params: %d\n", getParamsCount());
+}
+
+uint32_t PointwiseConv2DLayer::getParamsCount() const {
+	return _weights.getSize() + _biases.getSize();
+}
+
+void PointwiseConv2DLayer::updateWeights(float learning_step) {
+	_weights -= _cached_weights_d * learning_step / _samples;
+	_biases -= _cached_biases_d * learning_step / _samples;
+}
+
+const Tensor PointwiseConv2DLayer::forwardPropagation(const Tensor& x) {
+	cacheInput(x);
+
+	Tensor x_next;
+	infer(x, x_next);
+
+	cacheOutput(x_next);
+
+	return x_next;
+}
+
+void PointwiseConv2DLayer::infer(const Tensor& x, Tensor& result) const {
+	uint32_t channels = _input_shape[2];
+	uint32_t pixels = x.getSize() / channels;
+
+	std::vector<uint32_t> x_next_shape = _output_shape;
+	x_next_shape.insert(x_next_shape.begin(), x.getShape()[0]);
+
+	// an NHWC batch is a (pixels x channels) matrix, the convolution is one matrix product with the filters
+	result = x.reshape({ pixels, channels }).dotProduct(_weights, false, false);
+	kernels::biasActivationKernel<float, IdentityActivation>(pixels, _filters_count, _biases.getDataPtr(), result.getDataPtr());
+	result.reshapeInPlace(x_next_shape);
+}
+
+const Tensor PointwiseConv2DLayer::backwardPropagation(const Tensor& dx) {
+	Tensor cached_input_storage;
+	const Tensor& cached_input = restoreCachedInput(cached_input_storage);
+
+	_samples += cached_input.getShape()[0];
+
+	uint32_t channels = _input_shape[2];
+	uint32_t pixels = cached_input.getSize() / channels;
+	Tensor x = cached_input.reshape({ pixels, channels });
+	Tensor dy = dx.reshape({ pixels, _filters_count });
+
+	_cached_weights_d += x.dotProduct(dy, true, false);
+	_cached_biases_d += dy.sum(0);
+
+	Tensor dx_prev = dy.dotProduct(_weights, false, true);
+	dx_prev.reshapeInPlace(cached_input.getShape());
+
+	return dx_prev;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+
+#include "Utils.h"
+#include "Layer.h"
+
+// 1x1 convolution, every NHWC pixel is a row of one matrix product with the filters
+class PointwiseConv2DLayer : public Layer {
+public:
+	PointwiseConv2DLayer(std::vector<uint32_t> input_shape, uint32_t filters_count);
+	PointwiseConv2DLayer(Layer& prev_layer, uint32_t filters_count);
+
+	// channels x filters_count
+	void setWeights(std::vector<float> weights);
+	void setBiases(std::vector<float> biases);
+
+	virtual const Tensor forwardPropagation(const Tensor& x);
+	virtual void infer(const Tensor& x, Tensor& result) const;
+	virtual const Tensor backwardPropagation(const Tensor& dx);
+	virtual void updateWeights(float learning_step);
+	virtual void initCachedGradient();
+	virtual void summary() const;
+	virtual uint32_t getParamsCount() const;
+
+private:
+	uint32_t _filters_count;
+	Tensor _weights;
+	Tensor _biases;
+	uint32_t _samples;
+	Tensor _cached_weights_d;
+	Tensor _cached_biases_d;
+
+	void initWeights(uint32_t filters_count);
+};
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Pool2DLayer.h"
+#include "TensorKernels.h"
 
 Pool2DLayer::Pool2DLayer(std::vector<uint32_t> input_shape, int32_t pool_size, PoolMode pool_mode) {
 	_input_shape = input_shape;
@@ -22,16 +23,7 @@ Pool2DLayer::Pool2DLayer(std::vector<uint32_t> input_shape, int32_t pool_size, P
     _output_shape[_output_shape.size() - 3] /= pool_size;
 
     _pool_size = pool_size;
-    switch (pool_mode) {
-        case PoolMode::Max:
-            _pool_function = pool_max;
-            _pool_function_d = pool_max_d;
-            break;
-        case PoolMode::Average:
-            _pool_function = pool_average;
-            _pool_function_d = pool_average_d;
-            break;
-    }
+    _pool_mode = pool_mode;
 }
 
 Pool2DLayer::Pool2DLayer(Layer& prev_layer, int32_t pool_size, PoolMode pool_mode) {
@@ -59,21 +51,20 @@ Pool2DLayer::Pool2DLayer(Layer& prev_layer, int32_t pool_size, PoolMode pool_mod
 	prev_layer.setNextLayer(this);
 
     _pool_size = pool_size;
-    switch (pool_mode) {
-        case PoolMode::Max:
-            _pool_function = pool_max;
-            _pool_function_d = pool_max_d;
-            break;
-        case PoolMode::Average:
-            _pool_function = pool_average;
-            _pool_function_d = pool_average_d;
-            break;
-    }
+    _pool_mode = pool_mode;
 }
 
 const Tensor Pool2DLayer::forwardPropagation(const Tensor& x) {
-    _cached_input = x;
+    cacheInput(x);
+
+    Tensor result;
+    infer(x, result);
+
+    cacheOutput(result);
+    return result;
+}
 
+void Pool2DLayer::infer(const Tensor& x, Tensor& result) const {
     std::vector<uint32_t> x_shape = x.getShape();
     std::vector<uint32_t> new_shape = {
         1,
@@ -85,40 +76,30 @@ const Tensor Pool2DLayer::forwardPropagation(const Tensor& x) {
         new_shape[0] *= x_shape[i];
     }
 
-    Tensor reshaped_x = x.reshape(new_shape);
-
-    std::vector<uint32_t> reshaped_result_shape = new_shape;
-    reshaped_result_shape[1] /= _pool_size;
-    reshaped_result_shape[2] /= _pool_size;
-    Tensor reshaped_result = Tensor(reshaped_result_shape);
-
-    for (uint32_t i = 0; i < reshaped_result_shape[0]; ++i) {
-        for (uint32_t x = 0; x < reshaped_result_shape[1]; ++x) {
-            for (uint32_t y = 0; y < reshaped_result_shape[2]; ++y) {
-                for (uint32_t c = 0; c < reshaped_result_shape[3]; ++c) {
-                    reshaped_result.setValue(
-                        _pool_function(reshaped_x.getSubTensor(
-                            { { i },
-                            { _pool_size*x, _pool_size*(x + 1) },
-                            { _pool_size*y, _pool_size*(y + 1) },
-                            { c }})).getValue(),
-                        { i, x, y, c });
-                }
-            }
-        }
-    }
+    // kernels see the result as (n, h / pool, w / pool, c)
     std::vector<uint32_t> result_shape = x_shape;
     result_shape[result_shape.size() - 3] = x_shape[x_shape.size() - 3]/_pool_size;
     result_shape[result_shape.size() - 2] = x_shape[x_shape.size() - 2]/_pool_size;
+    prepareResult(result, result_shape);
 
-    Tensor result = reshaped_result.reshape(result_shape);
-
-    _cached_output = result;
-    return result;
+    switch (_pool_size) {
+        case 2:
+            poolKernel<2>(new_shape[0], new_shape[1], new_shape[2], new_shape[3], x.getDataPtr(), result.getDataPtr());
+            break;
+        case 3:
+            poolKernel<3>(new_shape[0], new_shape[1], new_shape[2], new_shape[3], x.getDataPtr(), result.getDataPtr());
+            break;
+        default:
+            poolKernel<0>(new_shape[0], new_shape[1], new_shape[2], new_shape[3], x.getDataPtr(), result.getDataPtr());
+            break;
+    }
 }
 
 const Tensor Pool2DLayer::backwardPropagation(const Tensor& dx) {
-    std::vector<uint32_t> x_shape = _cached_input.getShape();
+    Tensor cached_input_storage;
+    const Tensor& cached_input = restoreCachedInput(cached_input_storage);
+
+    std::vector<uint32_t> x_shape = cached_input.getShape();
     std::vector<uint32_t> new_shape = {
         1,
         x_shape[x_shape.size() - 3],
@@ -129,39 +110,20 @@ const Tensor Pool2DLayer::backwardPropagation(const Tensor& dx) {
         new_shape[0] *= x_shape[i];
     }
 
-    std::vector<uint32_t> reshaped_result_shape = new_shape;
-    reshaped_result_shape[1] /= _pool_size;
-    reshaped_result_shape[2] /= _pool_size;
     Tensor reshaped_result = Tensor(new_shape);
 
-    Tensor reshaped_cached_input = _cached_input.reshape(new_shape);
-    Tensor reshaped_dx = dx.reshape(reshaped_result_shape);
-    
-    for (uint32_t i = 0; i < reshaped_result_shape[0]; ++i) {
-        for (uint32_t x = 0; x < reshaped_result_shape[1]; ++x) {
-            for (uint32_t y = 0; y < reshaped_result_shape[2]; ++y) {
-                for (uint32_t c = 0; c < reshaped_result_shape[3]; ++c) {
-                    reshaped_result.setValuesOfSubTensor(
-                        { { i },
-                          { _pool_size*x, _pool_size*(x + 1) },
-                          { _pool_size*y, _pool_size*(y + 1) },
-                          { c }},
-                        _pool_function_d(
-                            reshaped_cached_input.getSubTensor(
-                                { { i },
-                                  { _pool_size*x, _pool_size*(x + 1) },
-                                  { _pool_size*y, _pool_size*(y + 1) },
-                                  { c }}),
-                            reshaped_dx.getSubTensor(
-                                { {{ i }},
-                                  {{ x }},
-                                  {{ y }},
-                                  {{ c }} })));
-                }
-            }
-        }
+    switch (_pool_size) {
+        case 2:
+            poolKernelBackward<2>(new_shape[0], new_shape[1], new_shape[2], new_shape[3], cached_input.getDataPtr(), dx.getDataPtr(), reshaped_result.getDataPtr());
+            break;
+        case 3:
+            poolKernelBackward<3>(new_shape[0], new_shape[1], new_shape[2], new_shape[3], cached_input.getDataPtr(), dx.getDataPtr(), reshaped_result.getDataPtr());
+            break;
+        default:
+            poolKernelBackward<0>(new_shape[0], new_shape[1], new_shape[2], new_shape[3], cached_input.getDataPtr(), dx.getDataPtr(), reshaped_result.getDataPtr());
+            break;
     }
-    
+
     Tensor result = reshaped_result.reshape(x_shape);
 
     return result;
@@ -193,45 +155,26 @@ uint32_t Pool2DLayer::getParamsCount() const {
     return 0;
 }
 
-const Tensor Pool2DLayer::pool_max(const Tensor& x) {
-    Tensor result = Tensor();
-    result.setValue(x.max());
-    return result;
-}
-
-const Tensor Pool2DLayer::pool_max_d(const Tensor& x, const Tensor& dx) {
-    float max = x.max();
-    Tensor result = x;
-
-    std::vector x_data = x.getData();
-    float dx_value = dx.getValue();
-
-    std::transform(x_data.begin(), x_data.end(), x_data.begin(),
-        [max, dx_value] (float x) {return x == max ? dx_value : 0.0f;});
-
-    float c = 0.0f;
-    for (auto v : x_data) {
-        if (v != 0) {
-            c += 1;
-        }
-    }
-
-    if (c > 0) {
-        std::transform(x_data.begin(), x_data.end(), x_data.begin(),
-            [c] (float x) {return x/c;});
+template <uint32_t P>
+void Pool2DLayer::poolKernel(uint32_t n, uint32_t h, uint32_t w, uint32_t c, const float* x, float* r) const {
+    switch (_pool_mode) {
+        case PoolMode::Max:
+            kernels::maxPool2DKernel<float, P>(n, h, w, c, _pool_size, x, r);
+            break;
+        case PoolMode::Average:
+            kernels::averagePool2DKernel<float, P>(n, h, w, c, _pool_size, x, r);
+            break;
     }
-
-    result.setValues(x_data);
-
-    return result;
-}
-
-const Tensor Pool2DLayer::pool_average(const Tensor& x) {
-    Tensor result = Tensor();
-    result.setValue(x.average());
-    return result;
 }
 
-const Tensor Pool2DLayer::pool_average_d(const Tensor& x, const Tensor& dx) {
-    return (x/x.average())*dx.getValue();
+template <uint32_t P>
+void Pool2DLayer::poolKernelBackward(uint32_t n, uint32_t h, uint32_t w, uint32_t c, const float* x, const float* dx, float* r) const {
+    switch (_pool_mode) {
+        case PoolMode::Max:
+            kernels::maxPool2DBackwardKernel<float, P>(n, h, w, c, _pool_size, x, dx, r);
+            break;
+        case PoolMode::Average:
+            kernels::averagePool2DBackwardKernel<float, P>(n, h, w, c, _pool_size, x, dx, r);
+            break;
+    }
 }
\ No newline at end of file
@@ -17,6 +17,7 @@ public:
 	Pool2DLayer(Layer& prev_layer, int32_t pool_size, PoolMode pool_mode);
 	
 	virtual const Tensor forwardPropagation(const Tensor& x);
+	virtual void infer(const Tensor& x, Tensor& result) const;
 	virtual const Tensor backwardPropagation(const Tensor& dx);
 	virtual void updateWeights(float learning_step);
 	virtual void initCachedGradient();
@@ -25,11 +26,10 @@ public:
 
 private:
 	uint32_t _pool_size;
-	const Tensor (*_pool_function)(const Tensor& x);
-	const Tensor (*_pool_function_d)(const Tensor& x, const Tensor& dx);
+	PoolMode _pool_mode;
 
-	static const Tensor pool_max(const Tensor& x);
-	static const Tensor pool_max_d(const Tensor& x, const Tensor& dx);
-	static const Tensor pool_average(const Tensor& x);
-	static const Tensor pool_average_d(const Tensor& x, const Tensor& dx);
+	template <uint32_t P>
+	void poolKernel(uint32_t n, uint32_t h, uint32_t w, uint32_t c, const float* x, float* r) const;
+	template <uint32_t P>
+	void poolKernelBackward(uint32_t n, uint32_t h, uint32_t w, uint32_t c, const float* x, const float* dx, float* r) const;
 };
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "QuantizedTensor.h"
+#include "TensorKernels.h"
+
+QuantizedTensor::QuantizedTensor(const Tensor& tensor, uint32_t channel_axis) {
+	_shape = tensor.getShape();
+	_size = tensor.getSize();
+	_channel_axis = channel_axis;
+	_data.resize(_size);
+
+	if (channel_axis >= _shape.size()) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	uint32_t channels = _shape[channel_axis];
+	uint32_t inner_size = 1;
+	for (uint32_t i{ channel_axis + 1 }; i < _shape.size(); ++i) {
+		inner_size *= _shape[i];
+	}
+
+	const float* data = tensor.getDataPtr();
+
+	// index of flat element i along channel axis is (i / inner_size) % channels
+	std::vector<float> max_abs(channels, 0.0f);
+	for (uint32_t i{ 0 }; i < _size; ++i) {
+		uint32_t c = (i / inner_size) % channels;
+		max_abs[c] = std::max(max_abs[c], fabsf(data[i]));
+	}
+
+	_scales.resize(channels);
+	std::vector<float> inv_scales(channels);
+	for (uint32_t c{ 0 }; c < channels; ++c) {
+		_scales[c] = max_abs[c] > 0.0f ? max_abs[c] / QUANTIZED_MAX_VALUE : 1.0f;
+		inv_scales[c] = 1.0f / _scales[c];
+	}
+
+	for (uint32_t i{ 0 }; i < _size; ++i) {
+		_data[i] = quantizeValue(data[i], inv_scales[(i / inner_size) % channels]);
+	}
+}
+
+QuantizedTensor::QuantizedTensor(const Tensor& tensor, float scale) {
+	_shape = tensor.getShape();
+	_size = tensor.getSize();
+	_channel_axis = QUANTIZED_PER_TENSOR;
+	_scales = { scale };
+	_data.resize(_size);
+
+	const float* data = tensor.getDataPtr();
+	float inv_scale = 1.0f / scale;
+
+	for (uint32_t i{ 0 }; i < _size; ++i) {
+		_data[i] = quantizeValue(data[i], inv_scale);
+	}
+}
+
+QuantizedTensor::QuantizedTensor() {
+	_size = 0;
+	_channel_axis = QUANTIZED_PER_TENSOR;
+}
+
+std::vector<uint32_t> QuantizedTensor::getShape() const {
+	return _shape;
+}
+
+uint32_t QuantizedTensor::getSize() const {
+	return _size;
+}
+
+std::vector<float> QuantizedTensor::getScales() const {
+	return _scales;
+}
+
+const Tensor QuantizedTensor::toTensor() const {
+	Tensor result = Tensor(_shape);
+	float* data = result.getDataPtr();
+
+	uint32_t channels = 1;
+	uint32_t inner_size = _size;
+	if (QUANTIZED_PER_TENSOR != _channel_axis) {
+		channels = _shape[_channel_axis];
+		inner_size = 1;
+		for (uint32_t i{ _channel_axis + 1 }; i < _shape.size(); ++i) {
+			inner_size *= _shape[i];
+		}
+	}
+
+	for (uint32_t i{ 0 }; i < _size; ++i) {
+		data[i] = _data[i] * _scales[(i / inner_size) % channels];
+	}
+
+	return result;
+}
+
+float QuantizedTensor::calibrateScale(const Tensor& tensor) {
+	const float* data = tensor.getDataPtr();
+	float max_abs{ 0.0f };
+
+	for (uint32_t i{ 0 }; i < tensor.getSize(); ++i) {
+		max_abs = std::max(max_abs, fabsf(data[i]));
+	}
+
+	return max_abs > 0.0f ? max_abs / QUANTIZED_MAX_VALUE : 1.0f;
+}
+
+const Tensor QuantizedTensor::dotProductTranspose(const QuantizedTensor& tensor, const QuantizedTensor& other) {
+	// tensor (n x k) with one scale, other (m x k) with one scale per row
+	if ((tensor._shape.size() != 2) || (other._shape.size() != 2)) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	if (tensor._shape[1] != other._shape[1]) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	if ((QUANTIZED_PER_TENSOR != tensor._channel_axis) || (0 != other._channel_axis)) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	uint32_t n = tensor._shape[0];
+	uint32_t m = other._shape[0];
+	uint32_t k = tensor._shape[1];
+
+	Tensor result = Tensor({ n, m });
+	float* r = result.getDataPtr();
+
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		for (uint32_t j{ 0 }; j < m; ++j) {
+			int32_t acc = innerProduct(k, &tensor._data[i * k], &other._data[j * k]);
+			r[i * m + j] = acc * tensor._scales[0] * other._scales[j];
+		}
+	}
+
+	return result;
+}
+
+const Tensor QuantizedTensor::Conv2D(const QuantizedTensor& tensor, const QuantizedTensor& other, const Conv2DParams& params) {
+	// tensor (H x W x C) with one scale, other (KH x KW x C x F) with one scale per filter
+	if ((QUANTIZED_PER_TENSOR != tensor._channel_axis) || (3 != other._channel_axis)) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	Conv2DGeometry g = Tensor::conv2DGeometry(tensor._shape, other._shape, params);
+	uint32_t filters = g.f;
+
+	Tensor result = Tensor({ g.out_h, g.out_w, filters });
+	float* r = result.getDataPtr();
+
+	std::vector<int32_t> acc(result.getSize(), 0);
+	kernels::conv2DDirectKernel<int8_t, int32_t>(g, tensor._data.data(), other._data.data(), acc.data());
+
+	for (uint32_t i{ 0 }; i < acc.size(); i += filters) {
+		for (uint32_t f{ 0 }; f < filters; ++f) {
+			r[i + f] = acc[i + f] * tensor._scales[0] * other._scales[f];
+		}
+	}
+
+	return result;
+}
+
+int8_t QuantizedTensor::quantizeValue(float value, float inv_scale) {
+	float scaled = roundf(value * inv_scale);
+
+	if (scaled > QUANTIZED_MAX_VALUE) {
+		scaled = QUANTIZED_MAX_VALUE;
+	}
+	else if (scaled < -QUANTIZED_MAX_VALUE) {
+		scaled = -QUANTIZED_MAX_VALUE;
+	}
+
+	return static_cast<int8_t>(scaled);
+}
+
+int32_t QuantizedTensor::innerProduct(uint32_t n, const int8_t* v1, const int8_t* v2) {
+	// products are widened to 16 bits and summed in 32 bits, maps to pmaddwd
+	int32_t result{ 0 };
+
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		result += static_cast<int16_t>(v1[i]) * static_cast<int16_t>(v2[i]);
+	}
+
+	return result;
+}
\ No newline at end of file
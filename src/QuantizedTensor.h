@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+
+#include "Tensor.h"
+
+#define QUANTIZED_MAX_VALUE (127)
+#define QUANTIZED_PER_TENSOR (static_cast<uint32_t>(-1))
+
+// Tensor stored as symmetric int8 values, value = data * scale.
+// Scale is either one for the whole tensor or one per index of the channel axis.
+class QuantizedTensor {
+public:
+	QuantizedTensor(const Tensor& tensor, uint32_t channel_axis);
+	QuantizedTensor(const Tensor& tensor, float scale);
+	QuantizedTensor();
+
+	std::vector<uint32_t> getShape() const;
+	uint32_t getSize() const;
+	std::vector<float> getScales() const;
+	const Tensor toTensor() const;
+
+	static float calibrateScale(const Tensor& tensor);
+	static const Tensor dotProductTranspose(const QuantizedTensor& tensor, const QuantizedTensor& other);
+	static const Tensor Conv2D(const QuantizedTensor& tensor, const QuantizedTensor& other, const Conv2DParams& params = Conv2DParams());
+
+private:
+	std::vector<uint32_t> _shape;
+	uint32_t _size;
+	uint32_t _channel_axis;
+	std::vector<float> _scales;
+	std::vector<int8_t, TrackingAllocator<int8_t> > _data;
+
+	static int8_t quantizeValue(float value, float inv_scale);
+	static int32_t innerProduct(uint32_t n, const int8_t* v1, const int8_t* v2);
+};
\ No newline at end of file
@@ -1,4 +1,148 @@
 #include "Tensor.h"
+#include "TensorKernels.h"
+#include "ThreadPool.h"
+
+#include <functional>
+
+template <typename Op>
+void Tensor::broadcastOperation(const Tensor& a, const Tensor& b, Tensor& result, Op op) {
+	// strides of broadcast axes are 0, adjacent axes contiguous in both operands are merged
+	uint32_t dim = result._shape.size();
+	std::vector<uint32_t> shape;
+	std::vector<uint32_t> strides_a;
+	std::vector<uint32_t> strides_b;
+	uint32_t stride_a = 1;
+	uint32_t stride_b = 1;
+
+	for (int32_t i{ static_cast<int32_t>(dim) - 1 }; i >= 0; --i) {
+		int32_t i_a = i - static_cast<int32_t>(dim - a._shape.size());
+		int32_t i_b = i - static_cast<int32_t>(dim - b._shape.size());
+		uint32_t size_a = i_a >= 0 ? a._shape[i_a] : 1;
+		uint32_t size_b = i_b >= 0 ? b._shape[i_b] : 1;
+
+		if (1 == result._shape[i]) {
+			continue;
+		}
+
+		uint32_t s_a = 1 == size_a ? 0 : stride_a;
+		uint32_t s_b = 1 == size_b ? 0 : stride_b;
+		stride_a *= size_a;
+		stride_b *= size_b;
+
+		if (!shape.empty() &&
+			(s_a == strides_a.back() * shape.back()) &&
+			(s_b == strides_b.back() * shape.back())) {
+			shape.back() *= result._shape[i];
+			continue;
+		}
+
+		shape.push_back(result._shape[i]);
+		strides_a.push_back(s_a);
+		strides_b.push_back(s_b);
+	}
+
+	if (shape.empty()) {
+		shape.push_back(1);
+		strides_a.push_back(0);
+		strides_b.push_back(0);
+	}
+
+	std::reverse(shape.begin(), shape.end());
+	std::reverse(strides_a.begin(), strides_a.end());
+	std::reverse(strides_b.begin(), strides_b.end());
+
+	kernels::broadcastBinaryKernel(shape.size(), shape.data(), strides_a.data(), a._data.data(),
+								   strides_b.data(), b._data.data(), result._data.data(), op);
+}
+
+template <typename Op>
+void Tensor::reduceParallel(uint32_t outer, uint32_t n, uint32_t inner, const float* v, float* r, Op op) {
+	// v viewed as (outer x n x inner) reduced to r (outer x inner), work is split over outer or inner axis
+	ThreadPool& pool = ThreadPool::getDefault();
+
+	if (1 == inner && 1 == outer && n >= REDUCE_PARALLEL_MIN_WORK) {
+		uint32_t chunk = (n / pool.getThreadsCount() + REDUCE_ACCUMULATORS_COUNT) & ~(REDUCE_ACCUMULATORS_COUNT - 1);
+		uint32_t chunks_count = (n + chunk - 1) / chunk;
+		std::vector<float> partial(chunks_count);
+
+		pool.parallelFor(0, chunks_count, 1, [&](uint32_t begin, uint32_t end) {
+			for (uint32_t c{ begin }; c < end; ++c) {
+				partial[c] = kernels::pairwiseReduceKernel(std::min(chunk, n - c * chunk), v + c * chunk, op);
+			}
+		});
+		r[0] = kernels::pairwiseReduceKernel(chunks_count, partial.data(), op);
+	}
+	else if (1 == inner || outer >= pool.getThreadsCount()) {
+		uint32_t min_chunk = std::max(REDUCE_PARALLEL_MIN_WORK / (n * inner), 1u);
+
+		pool.parallelFor(0, outer, min_chunk, [&](uint32_t begin, uint32_t end) {
+			kernels::reduceKernel(end - begin, n, inner, inner, v + begin * n * inner, r + begin * inner, op);
+		});
+	}
+	else {
+		uint32_t min_chunk = std::max(REDUCE_PARALLEL_MIN_WORK / (outer * n), REDUCE_ACCUMULATORS_COUNT);
+
+		pool.parallelFor(0, inner, min_chunk, [&](uint32_t begin, uint32_t end) {
+			kernels::reduceKernel(outer, n, end - begin, inner, v + begin, r + begin, op);
+		});
+	}
+}
+
+template <typename Op>
+const Tensor Tensor::reduce(const std::vector<uint32_t>& axes, Op op) const {
+	uint32_t dim = this->_shape.size();
+	std::vector<bool> reduced(dim, false);
+
+	for (auto axis : axes) {
+		if (axis >= dim || reduced[axis]) {
+			printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+		}
+		reduced[axis] = true;
+	}
+
+	if (axes.empty()) {
+		return *this;
+	}
+
+	Tensor result;
+	const Tensor* source = this;
+
+	// groups of adjacent reduced axes are reduced starting from the last one, so indices of earlier axes stay valid
+	for (uint32_t end{ dim }; end > 0;) {
+		if (!reduced[end - 1]) {
+			--end;
+			continue;
+		}
+
+		uint32_t begin = end - 1;
+		while (begin > 0 && reduced[begin - 1]) {
+			--begin;
+		}
+
+		const std::vector<uint32_t> shape = source->_shape;
+		std::vector<uint32_t> step_shape(shape.begin(), shape.begin() + begin);
+		step_shape.insert(step_shape.end(), shape.begin() + end, shape.end());
+		if (step_shape.empty()) {
+			// all axes reduced, result has the shape of Tensor()
+			step_shape.push_back(1);
+		}
+		Tensor step_result = Tensor(step_shape);
+
+		uint32_t outer = shapeSize(std::vector<uint32_t>(shape.begin(), shape.begin() + begin));
+		uint32_t inner = shapeSize(std::vector<uint32_t>(shape.begin() + end, shape.end()));
+		uint32_t n = source->_size / (outer * inner);
+
+		reduceParallel(outer, n, inner, source->_data.data(), step_result._data.data(), op);
+
+		result._shape.swap(step_result._shape);
+		result._data.swap(step_result._data);
+		result._size = step_result._size;
+		source = &result;
+		end = begin;
+	}
+
+	return result;
+}
 
 Tensor::Tensor(const std::vector<uint32_t>& shape) {
 	_shape = shape;
@@ -34,6 +178,12 @@ Tensor::Tensor() {
 Tensor::~Tensor() {
 }
 
+void Tensor::release() {
+	_size = 1;
+	_shape = { 1 };
+	std::vector<float, TrackingAllocator<float> >(1, 0.0f).swap(_data);
+}
+
 uint32_t Tensor::getDim() const {
 	return _shape.size();
 }
@@ -47,7 +197,15 @@ std::vector<uint32_t> Tensor::getShape() const {
 }
 
 std::vector<float> Tensor::getData() const {
-	return _data;
+	return std::vector<float>(_data.begin(), _data.end());
+}
+
+const float* Tensor::getDataPtr() const {
+	return _data.data();
+}
+
+float* Tensor::getDataPtr() {
+	return _data.data();
 }
 
 float Tensor::getValue(const std::vector<uint32_t>& idx) const {
@@ -91,7 +249,7 @@ void Tensor::setValues(const std::vector<float>& values) {
 	if (this->_data.size() != values.size()) {
 		printf("EXCEPTION %d: %d %d\n", __LINE__, this->_data.size(), values.size()); throw std::invalid_argument(""); // exception
 	}
-	this->_data = values;
+	this->_data.assign(values.begin(), values.end());
 }
 
 Tensor Tensor::getSubTensor(const std::vector<uint32_t>& axes) const {
@@ -437,56 +595,143 @@ const Tensor Tensor::operator-() const {
 }
 
 const Tensor Tensor::operator+(const Tensor& other) const {
-	Tensor result = *this;
-	
+	std::vector<uint32_t> result_shape;
+
+	if (!this->validateShapeBroadcast(other, result_shape)) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	Tensor result = Tensor(result_shape);
+
 	#ifndef SSE
-	result += other;
-	#else
-	if (this->_size == other._size) {
+	broadcastOperation(*this, other, result, std::plus<float>());
+	#else	// SSE
+	if (result._size != this->_size) {
+		broadcastOperation(*this, other, result, std::plus<float>());
+	}
+	else if (this->_size == other._size) {
 		SSE_vector_add(this->_size, this->_data.data(), other._data.data(), result._data.data());
 	}
 	else if (1 == other._size) {
 		SSE_tensor_add_scalar(this->_size, this->_data.data(), other._data.data(), result._data.data());
 	}
-	else if (this->validateShapeReversed(other)) {
+	else if ((this->_shape.size() >= other._shape.size()) && this->validateShapeReversed(other)) {
 		SSE_tensor_add(this->_size, this->_data.data(), other._size, other._data.data(), result._data.data());
-	} else {
-		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
 	}
-	#endif
+	else {
+		broadcastOperation(*this, other, result, std::plus<float>());
+	}
+	#endif	// SSE
 
 	return result;
 }
 
 const Tensor Tensor::operator-(const Tensor& other) const {
-	Tensor result = *this;
-	result -= other;
+	std::vector<uint32_t> result_shape;
+
+	if (!this->validateShapeBroadcast(other, result_shape)) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	Tensor result = Tensor(result_shape);
+
+	#ifndef SSE
+	broadcastOperation(*this, other, result, std::minus<float>());
+	#else	// SSE
+	if (result._size != this->_size) {
+		broadcastOperation(*this, other, result, std::minus<float>());
+	}
+	else if (this->_size == other._size) {
+		SSE_vector_sub(this->_size, this->_data.data(), other._data.data(), result._data.data());
+	}
+	else if (1 == other._size) {
+		SSE_tensor_sub_scalar(this->_size, this->_data.data(), other._data.data(), result._data.data());
+	}
+	else if ((this->_shape.size() >= other._shape.size()) && this->validateShapeReversed(other)) {
+		SSE_tensor_sub(this->_size, this->_data.data(), other._size, other._data.data(), result._data.data());
+	}
+	else {
+		broadcastOperation(*this, other, result, std::minus<float>());
+	}
+	#endif	// SSE
+
 	return result;
 }
 
 const Tensor Tensor::operator*(const Tensor& other) const {
-	Tensor result = *this;
-	result *= other;
+	std::vector<uint32_t> result_shape;
+
+	if (!this->validateShapeBroadcast(other, result_shape)) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	Tensor result = Tensor(result_shape);
+
+	#ifndef SSE
+	broadcastOperation(*this, other, result, std::multiplies<float>());
+	#else	// SSE
+	if (result._size != this->_size) {
+		broadcastOperation(*this, other, result, std::multiplies<float>());
+	}
+	else if (this->_size == other._size) {
+		SSE_vector_mul(this->_size, this->_data.data(), other._data.data(), result._data.data());
+	}
+	else if (1 == other._size) {
+		SSE_tensor_mul_scalar(this->_size, this->_data.data(), other._data.data(), result._data.data());
+	}
+	else if ((this->_shape.size() >= other._shape.size()) && this->validateShapeReversed(other)) {
+		SSE_tensor_mul(this->_size, this->_data.data(), other._size, other._data.data(), result._data.data());
+	}
+	else {
+		broadcastOperation(*this, other, result, std::multiplies<float>());
+	}
+	#endif	// SSE
+
 	return result;
 }
 
 const Tensor Tensor::operator/(const Tensor& other) const {
-	Tensor result = *this;
-	result /= other;
+	std::vector<uint32_t> result_shape;
+
+	if (!this->validateShapeBroadcast(other, result_shape)) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	Tensor result = Tensor(result_shape);
+
+	#ifndef SSE
+	broadcastOperation(*this, other, result, std::divides<float>());
+	#else	// SSE
+	if (result._size != this->_size) {
+		broadcastOperation(*this, other, result, std::divides<float>());
+	}
+	else if (this->_size == other._size) {
+		SSE_vector_div(this->_size, this->_data.data(), other._data.data(), result._data.data());
+	}
+	else if (1 == other._size) {
+		SSE_tensor_div_scalar(this->_size, this->_data.data(), other._data.data(), result._data.data());
+	}
+	else if ((this->_shape.size() >= other._shape.size()) && this->validateShapeReversed(other)) {
+		SSE_tensor_div(this->_size, this->_data.data(), other._size, other._data.data(), result._data.data());
+	}
+	else {
+		broadcastOperation(*this, other, result, std::divides<float>());
+	}
+	#endif	// SSE
+
 	return result;
 }
 
 Tensor& Tensor::operator+=(const Tensor& other) {
-	if (((this->_shape.size() < other._shape.size()) ||
-		 (!this->validateShapeReversed(other))) &&
-		(1 != other._size)) {
+	std::vector<uint32_t> result_shape;
+
+	if ((!this->validateShapeBroadcast(other, result_shape)) ||
+		(shapeSize(result_shape) != this->_size)) {
 		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
 	}
 
 	#ifndef SSE
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		this->_data[i] += other._data[i % other._size];
-	}
+	broadcastOperation(*this, other, *this, std::plus<float>());
 	#else	// SSE
 	if (this->_size == other._size) {
 		SSE_vector_add(this->_size, this->_data.data(), other._data.data(), this->_data.data());
@@ -494,10 +739,11 @@ Tensor& Tensor::operator+=(const Tensor& other) {
 	else if (1 == other._size) {
 		SSE_tensor_add_scalar(this->_size, this->_data.data(), other._data.data(), this->_data.data());
 	}
-	else if (this->validateShapeReversed(other)) {
+	else if ((this->_shape.size() >= other._shape.size()) && this->validateShapeReversed(other)) {
 		SSE_tensor_add(this->_size, this->_data.data(), other._size, other._data.data(), this->_data.data());
-	} else {
-		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	else {
+		broadcastOperation(*this, other, *this, std::plus<float>());
 	}
 	#endif	// SSE
 
@@ -505,16 +751,15 @@ Tensor& Tensor::operator+=(const Tensor& other) {
 }
 
 Tensor& Tensor::operator-=(const Tensor& other) {
-	if (((this->_shape.size() < other._shape.size()) ||
-		 (!this->validateShape(other))) &&
-		(1 != other._size)) {
+	std::vector<uint32_t> result_shape;
+
+	if ((!this->validateShapeBroadcast(other, result_shape)) ||
+		(shapeSize(result_shape) != this->_size)) {
 		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
 	}
 
 	#ifndef SSE
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		this->_data[i] -= other._data[i % other._size];
-	}
+	broadcastOperation(*this, other, *this, std::minus<float>());
 	#else	// SSE
 	if (this->_size == other._size) {
 		SSE_vector_sub(this->_size, this->_data.data(), other._data.data(), this->_data.data());
@@ -522,10 +767,11 @@ Tensor& Tensor::operator-=(const Tensor& other) {
 	else if (1 == other._size) {
 		SSE_tensor_sub_scalar(this->_size, this->_data.data(), other._data.data(), this->_data.data());
 	}
-	else if (this->validateShapeReversed(other)) {
+	else if ((this->_shape.size() >= other._shape.size()) && this->validateShapeReversed(other)) {
 		SSE_tensor_sub(this->_size, this->_data.data(), other._size, other._data.data(), this->_data.data());
-	} else {
-		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	else {
+		broadcastOperation(*this, other, *this, std::minus<float>());
 	}
 	#endif	// SSE
 
@@ -533,16 +779,15 @@ Tensor& Tensor::operator-=(const Tensor& other) {
 }
 
 Tensor& Tensor::operator*=(const Tensor& other) {
-	if (((this->_shape.size() < other._shape.size()) ||
-		 (!this->validateShape(other))) &&
-		(1 != other._size)) {
+	std::vector<uint32_t> result_shape;
+
+	if ((!this->validateShapeBroadcast(other, result_shape)) ||
+		(shapeSize(result_shape) != this->_size)) {
 		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
 	}
 
 	#ifndef SSE
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		this->_data[i] *= other._data[i % other._size];
-	}
+	broadcastOperation(*this, other, *this, std::multiplies<float>());
 	#else	// SSE
 	if (this->_size == other._size) {
 		SSE_vector_mul(this->_size, this->_data.data(), other._data.data(), this->_data.data());
@@ -550,10 +795,11 @@ Tensor& Tensor::operator*=(const Tensor& other) {
 	else if (1 == other._size) {
 		SSE_tensor_mul_scalar(this->_size, this->_data.data(), other._data.data(), this->_data.data());
 	}
-	else if (this->validateShapeReversed(other)) {
+	else if ((this->_shape.size() >= other._shape.size()) && this->validateShapeReversed(other)) {
 		SSE_tensor_mul(this->_size, this->_data.data(), other._size, other._data.data(), this->_data.data());
-	} else {
-		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	else {
+		broadcastOperation(*this, other, *this, std::multiplies<float>());
 	}
 	#endif	// SSE
 
@@ -561,16 +807,15 @@ Tensor& Tensor::operator*=(const Tensor& other) {
 }
 
 Tensor& Tensor::operator/=(const Tensor& other) {
-	if (((this->_shape.size() < other._shape.size()) ||
-		 (!this->validateShape(other))) &&
-		(1 != other._size)) {
+	std::vector<uint32_t> result_shape;
+
+	if ((!this->validateShapeBroadcast(other, result_shape)) ||
+		(shapeSize(result_shape) != this->_size)) {
 		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
 	}
 
 	#ifndef SSE
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		this->_data[i] /= other._data[i % other._size];
-	}
+	broadcastOperation(*this, other, *this, std::divides<float>());
 	#else	// SSE
 	if (this->_size == other._size) {
 		SSE_vector_div(this->_size, this->_data.data(), other._data.data(), this->_data.data());
@@ -578,10 +823,11 @@ Tensor& Tensor::operator/=(const Tensor& other) {
 	else if (1 == other._size) {
 		SSE_tensor_div_scalar(this->_size, this->_data.data(), other._data.data(), this->_data.data());
 	}
-	else if (this->validateShapeReversed(other)) {
+	else if ((this->_shape.size() >= other._shape.size()) && this->validateShapeReversed(other)) {
 		SSE_tensor_div(this->_size, this->_data.data(), other._size, other._data.data(), this->_data.data());
-	} else {
-		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	else {
+		broadcastOperation(*this, other, *this, std::divides<float>());
 	}
 	#endif	// SSE
 
@@ -589,35 +835,27 @@ Tensor& Tensor::operator/=(const Tensor& other) {
 }
 
 const Tensor Tensor::operator>(const Tensor& other) const {
-	uint32_t i = 0;
+	std::vector<uint32_t> result_shape;
 
-	if ((this->_shape.size() < other._shape.size()) ||
-		!this->validateShape(other)) {
+	if (!this->validateShapeBroadcast(other, result_shape)) {
 		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
 	}
 
-	Tensor result = *this;
-
-	for (i = 0; i < this->_size; ++i) {
-		result._data[i] = this->_data[i] > other._data[i % other._size] ? 1.0f: 0.0f;
-	}
+	Tensor result = Tensor(result_shape);
+	broadcastOperation(*this, other, result, [](float a, float b) { return a > b ? 1.0f : 0.0f; });
 
 	return result;
 }
 
 const Tensor Tensor::operator<(const Tensor& other) const {
-	uint32_t i = 0;
+	std::vector<uint32_t> result_shape;
 
-	if ((this->_shape.size() < other._shape.size()) ||
-		!this->validateShape(other)) {
+	if (!this->validateShapeBroadcast(other, result_shape)) {
 		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
 	}
 
-	Tensor result = *this;
-
-	for (i = 0; i < this->_size; ++i) {
-		result._data[i] = this->_data[i] < other._data[i % other._size] ? 1.0f: 0.0f;
-	}
+	Tensor result = Tensor(result_shape);
+	broadcastOperation(*this, other, result, [](float a, float b) { return a < b ? 1.0f : 0.0f; });
 
 	return result;
 }
@@ -897,6 +1135,81 @@ const Tensor Tensor::dotProductTranspose(const Tensor& other) const {
 	return result;
 }
 
+const Tensor Tensor::dotProduct(const Tensor& other, bool transpose_this, bool transpose_other) const {
+	if ((this->_shape.size() != 2) || (other._shape.size() != 2)) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	// op(this) is n x k, op(other) is k x m
+	uint32_t n = transpose_this ? this->_shape[1] : this->_shape[0];
+	uint32_t k = transpose_this ? this->_shape[0] : this->_shape[1];
+	uint32_t m = transpose_other ? other._shape[0] : other._shape[1];
+
+	if (k != (transpose_other ? other._shape[1] : other._shape[0])) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	if (!transpose_this && transpose_other) {
+		return this->dotProductTranspose(other);
+	}
+
+	if (transpose_this && transpose_other) {
+		// (A^T B^T) = (B A)^T
+		return other.dotProduct(*this, false, false).transpose();
+	}
+
+	Tensor result = Tensor({ n, m });
+
+	#ifdef SSE
+	// SSE matrix product reads both operands row by row, operands are transposed by the blocked kernel
+	// into per-thread scratch buffers, which keep their capacity between calls
+	static thread_local std::vector<float> this_scratch;
+	static thread_local std::vector<float> other_scratch;
+
+	const float* a_rows = this->_data.data();
+	if (transpose_this) {
+		this_scratch.resize(this->_size);
+		transposeKernel(this->_shape[0], this->_shape[1], this->_data.data(), this_scratch.data());
+		a_rows = this_scratch.data();
+	}
+	other_scratch.resize(other._size);
+	transposeKernel(other._shape[0], other._shape[1], other._data.data(), other_scratch.data());
+
+	SSE_tensor_dot_product_transpose(n, m, k, a_rows, other_scratch.data(), result._data.data());
+
+	return result;
+	#endif	// SSE
+
+	const float* a = this->_data.data();
+	const float* b = other._data.data();
+	float* r = result._data.data();
+
+	if (!transpose_this) {
+		// r[i,j] += a[i,p] * b[p,j], inner loop runs over contiguous rows of b and r
+		for (uint32_t i = 0; i < n; ++i) {
+			for (uint32_t p = 0; p < k; ++p) {
+				float a_ip = a[i * k + p];
+				for (uint32_t j = 0; j < m; ++j) {
+					r[i * m + j] += a_ip * b[p * m + j];
+				}
+			}
+		}
+	}
+	else {
+		// r[i,j] += a[p,i] * b[p,j], both operands read row by row
+		for (uint32_t p = 0; p < k; ++p) {
+			for (uint32_t i = 0; i < n; ++i) {
+				float a_pi = a[p * n + i];
+				for (uint32_t j = 0; j < m; ++j) {
+					r[i * m + j] += a_pi * b[p * m + j];
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
 const Tensor Tensor::tensorProduct(const Tensor& other) const {
 	std::vector<uint32_t> result_shape = this->_shape;
 	result_shape.insert(result_shape.end(), other._shape.begin(), other._shape.end());
@@ -946,29 +1259,125 @@ const Tensor Tensor::flatten(uint32_t from_axis) const {
 	return result;
 }
 
-const Tensor Tensor::Conv2D(const Tensor& other) const {
-	if (this->_shape[2] != other._shape[2]) {
+Conv2DGeometry Tensor::conv2DGeometry(const std::vector<uint32_t>& input_shape, const std::vector<uint32_t>& filter_shape, const Conv2DParams& params) {
+	if ((3 != input_shape.size()) || (4 != filter_shape.size()) || (input_shape[2] != filter_shape[2])) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	if ((0 == params.stride) || (0 == params.dilation) || (0 == filter_shape[0]) || (0 == filter_shape[1])) {
 		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
 	}
 
-	std::vector<uint32_t> result_shape = {this->_shape[0] - (other._shape[0] - 1),
-										  this->_shape[1] - (other._shape[1] - 1),
-										  other._shape[3]};
+	Conv2DGeometry g;
+	g.h = input_shape[0];
+	g.w = input_shape[1];
+	g.c = input_shape[2];
+	g.f = filter_shape[3];
+	g.filter_h = filter_shape[0];
+	g.filter_w = filter_shape[1];
+	g.stride = params.stride;
+	g.dilation = params.dilation;
+
+	// input extent covered by one dilated filter
+	uint32_t span_h = (g.filter_h - 1) * g.dilation + 1;
+	uint32_t span_w = (g.filter_w - 1) * g.dilation + 1;
+
+	if (ConvPadding::Same == params.padding) {
+		// output covers every stride-th input pixel, odd padding puts the extra zero at the bottom and right
+		g.out_h = (g.h + g.stride - 1) / g.stride;
+		g.out_w = (g.w + g.stride - 1) / g.stride;
+		uint32_t covered_h = (g.out_h - 1) * g.stride + span_h;
+		uint32_t covered_w = (g.out_w - 1) * g.stride + span_w;
+		g.padding_top = (covered_h > g.h) ? (covered_h - g.h) / 2 : 0;
+		g.padding_left = (covered_w > g.w) ? (covered_w - g.w) / 2 : 0;
+		return g;
+	}
+
+	g.padding_top = (ConvPadding::Explicit == params.padding) ? params.padding_h : 0;
+	g.padding_left = (ConvPadding::Explicit == params.padding) ? params.padding_w : 0;
+	uint32_t padded_h = g.h + 2 * g.padding_top;
+	uint32_t padded_w = g.w + 2 * g.padding_left;
+	if ((padded_h < span_h) || (padded_w < span_w)) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+	g.out_h = (padded_h - span_h) / g.stride + 1;
+	g.out_w = (padded_w - span_w) / g.stride + 1;
 
-	Tensor result = Tensor(result_shape);
+	return g;
+}
 
-	for (uint32_t i{ 0 }; i < result_shape[0]; ++i) {
-		for (uint32_t j{ 0 }; j < result_shape[1]; ++j) {
-			for (uint32_t k{ 0 }; k < result_shape[2]; ++k) {
-				Tensor sub_tensor_this = this->getSubTensor({ { i, i + other._shape[0] },
-										  					 { j, j + other._shape[1] },
-															 {} });
-				Tensor sub_tensor_other = other.getSubTensor({ WHOLE_AXIS, WHOLE_AXIS, WHOLE_AXIS, k});
+const Tensor Tensor::Conv2D(const Tensor& other, const Conv2DParams& params) const {
+	Conv2DGeometry g = conv2DGeometry(this->_shape, other._shape, params);
 
-				result.setValue((sub_tensor_this * sub_tensor_other).sum(), { i, j, k});
-			}
-		}
+	Tensor result = Tensor({ g.out_h, g.out_w, g.f });
+
+	kernels::conv2DDirectKernel<float, float>(g, this->_data.data(), other._data.data(), result._data.data());
+
+	return result;
+}
+
+const Tensor Tensor::Conv2DIm2col(const Tensor& other, const Conv2DParams& params) const {
+	// patches of the input as rows of a matrix, the convolution is one matrix product with the filters
+	Conv2DGeometry g = conv2DGeometry(this->_shape, other._shape, params);
+	uint32_t patch_size = g.filter_h * g.filter_w * g.c;
+
+	Tensor cols = Tensor({ g.out_h * g.out_w, patch_size });
+	kernels::im2colKernel<float>(g, this->_data.data(), cols._data.data());
+
+	// filters as rows, the product runs over contiguous patch and filter rows (SSE kernel when enabled)
+	Tensor weights = other.reshape({ patch_size, g.f }).transpose();
+
+	return cols.dotProductTranspose(weights).reshape({ g.out_h, g.out_w, g.f });
+}
+
+const Tensor Tensor::Conv2DWinograd(const Tensor& transformed_weights, const Conv2DParams& params) const {
+	// 3x3 convolution with filters transformed by winogradFilter
+	if ((3 != this->_shape.size()) || (3 != transformed_weights._shape.size()) || (16 != transformed_weights._shape[0])) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
 	}
+	if ((1 != params.stride) || (1 != params.dilation)) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	Conv2DGeometry g = conv2DGeometry(this->_shape, { 3, 3, transformed_weights._shape[1], transformed_weights._shape[2] }, params);
+
+	Tensor result = Tensor({ g.out_h, g.out_w, g.f });
+
+	kernels::winogradConv2DKernel<float>(g, this->_data.data(), transformed_weights._data.data(), result._data.data());
+
+	return result;
+}
+
+const Tensor Tensor::Conv2DFFT(const Tensor& other, const Conv2DParams& params) const {
+	// correlation as a product of spectra, the cost barely depends on the filter size
+	if ((1 != params.stride) || (1 != params.dilation)) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	Conv2DGeometry g = conv2DGeometry(this->_shape, other._shape, params);
+
+	uint32_t grid_h, grid_w;
+	kernels::fftConv2DGridSize(g, grid_h, grid_w);
+	RealFFT2D fft = RealFFT2D(grid_h, grid_w);
+
+	std::vector<Complex> spectra(fft.getBinsCount() * g.c * g.f);
+	kernels::fftFilterTransformKernel(g, fft, other._data.data(), spectra.data());
+
+	Tensor result = Tensor({ g.out_h, g.out_w, g.f });
+
+	kernels::fftConv2DKernel(g, fft, this->_data.data(), spectra.data(), result._data.data());
+
+	return result;
+}
+
+const Tensor Tensor::winogradFilter(const Tensor& weights) {
+	// (3 x 3 x c x f) filters to (16 x c x f) transformed filters
+	if ((4 != weights._shape.size()) || (3 != weights._shape[0]) || (3 != weights._shape[1])) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	Tensor result = Tensor({ 16, weights._shape[2], weights._shape[3] });
+
+	kernels::winogradFilterTransformKernel<float>(weights._shape[2], weights._shape[3], weights._data.data(), result._data.data());
 
 	return result;
 }
@@ -978,6 +1387,9 @@ const Tensor Tensor::sum(uint32_t axis) const {
 		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
 	}
 
+	#ifndef SSE
+	return this->reduce({ axis }, std::plus<float>());
+	#else 	// SSE
 	std::vector<uint32_t> result_shape;
 
 	for (uint32_t i = 0; i < this->_shape.size() ; ++i) {
@@ -985,6 +1397,9 @@ const Tensor Tensor::sum(uint32_t axis) const {
 			result_shape.push_back(this->_shape[i]);
 		}
 	}
+	if (result_shape.empty()) {
+		result_shape.push_back(1);
+	}
 
 	Tensor result(result_shape);
 
@@ -992,27 +1407,81 @@ const Tensor Tensor::sum(uint32_t axis) const {
 	for (uint32_t i{ axis + 1 }; i < this->_shape.size() ; ++i) {
 		d_i *= this->_shape[i];
 	}
-	#ifndef SSE
 
-	uint32_t d_j = axis == this->_shape.size() - 1 ? this->_shape[this->_shape.size()  - 1] : 1;
-
-	uint32_t d_k = d_i * this->_shape[axis];
-
-	for (uint32_t k{ 0 }; k < this->_size / d_k; ++k) {
-		for (uint32_t j{ 0 }; j < d_i; ++j) {
-			for (uint32_t i{ 0 }; i < this->_shape[axis] ; ++i) {
-				result._data[j + d_i * k] += this->_data[d_i * i + d_j * j + d_k * k];
-			}
-		}
-	}
-	#else 	// SSE
 	if (axis == this->_shape.size() - 1) {
 		SSE_tensor_last_axis_sum(this->_size / (d_i * this->_shape[axis]), this->_shape[axis], this->_data.data(), result._data.data());
 	}
 	else {
 		SSE_tensor_axis_sum(this->_size / (d_i * this->_shape[axis]), d_i, this->_shape[axis], this->_data.data(), result._data.data());
 	}
+
+	return result;
 	#endif	// SSE
+}
+
+const Tensor Tensor::sum(const std::vector<uint32_t>& axes) const {
+	return this->reduce(axes, std::plus<float>());
+}
+
+const Tensor Tensor::max(const std::vector<uint32_t>& axes) const {
+	return this->reduce(axes, [](float a, float b) { return a > b ? a : b; });
+}
+
+const Tensor Tensor::min(const std::vector<uint32_t>& axes) const {
+	return this->reduce(axes, [](float a, float b) { return a < b ? a : b; });
+}
+
+const Tensor Tensor::mean(const std::vector<uint32_t>& axes) const {
+	Tensor result = this->reduce(axes, std::plus<float>());
+	result *= static_cast<float>(result._size) / this->_size;
+	return result;
+}
+
+const Tensor Tensor::variance(const std::vector<uint32_t>& axes) const {
+	// two passes, deviations from the mean are squared and averaged
+	std::vector<uint32_t> mean_shape = this->_shape;
+	for (auto axis : axes) {
+		if (axis >= mean_shape.size()) {
+			printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+		}
+		mean_shape[axis] = 1;
+	}
+
+	Tensor deviations = *this - this->mean(axes).reshape(mean_shape);
+	deviations *= deviations;
+
+	return deviations.mean(axes);
+}
+
+const Tensor Tensor::argmax(uint32_t axis) const {
+	if (axis >= this->_shape.size()) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	std::vector<uint32_t> result_shape = this->_shape;
+	result_shape.erase(result_shape.begin() + axis);
+	if (result_shape.empty()) {
+		result_shape.push_back(1);
+	}
+	Tensor result = Tensor(result_shape);
+
+	uint32_t n = this->_shape[axis];
+	uint32_t inner = shapeSize(std::vector<uint32_t>(this->_shape.begin() + axis + 1, this->_shape.end()));
+	uint32_t outer = this->_size / (n * inner);
+	const float* v = this->_data.data();
+	float* r = result._data.data();
+
+	ThreadPool& pool = ThreadPool::getDefault();
+	if (1 == inner || outer >= pool.getThreadsCount()) {
+		pool.parallelFor(0, outer, std::max(REDUCE_PARALLEL_MIN_WORK / (n * inner), 1u), [&](uint32_t begin, uint32_t end) {
+			kernels::argmaxKernel(end - begin, n, inner, inner, v + begin * n * inner, r + begin * inner);
+		});
+	}
+	else {
+		pool.parallelFor(0, inner, std::max(REDUCE_PARALLEL_MIN_WORK / (outer * n), REDUCE_ACCUMULATORS_COUNT), [&](uint32_t begin, uint32_t end) {
+			kernels::argmaxKernel(outer, n, end - begin, inner, v + begin, r + begin);
+		});
+	}
 
 	return result;
 }
@@ -1021,9 +1490,7 @@ float Tensor::sum() const {
 	float result{ 0.0f };
 	
 	#ifndef SSE
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		result += this->_data[i];
-	}
+	reduceParallel(1, this->_size, 1, this->_data.data(), &result, std::plus<float>());
 	#else 	// SSE
 	SSE_tensor_sum(this->_size, this->_data.data(), &result);
 	#endif	// SSE
@@ -1032,13 +1499,17 @@ float Tensor::sum() const {
 }
 
 float Tensor::max() const {
-	float result = _data[0];
+	float result{ 0.0f };
 
-	for (auto value : _data) {
-		if (value > result) {
-			result = value;
-		}
-	}
+	reduceParallel(1, this->_size, 1, this->_data.data(), &result, [](float a, float b) { return a > b ? a : b; });
+
+	return result;
+}
+
+float Tensor::min() const {
+	float result{ 0.0f };
+
+	reduceParallel(1, this->_size, 1, this->_data.data(), &result, [](float a, float b) { return a < b ? a : b; });
 
 	return result;
 }
@@ -1050,6 +1521,14 @@ float Tensor::average() const {
 
 }
 
+float Tensor::variance() const {
+	float mean = this->average();
+	Tensor deviations = *this - mean;
+	deviations *= deviations;
+
+	return deviations.average();
+}
+
 const Tensor Tensor::transpose() const {
 	if (this->_shape.size()  != 2) {
 		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
@@ -1059,15 +1538,154 @@ const Tensor Tensor::transpose() const {
 
 	Tensor result = Tensor(result_shape);
 
-	for (uint32_t i = 0; i < result_shape[0]; ++i) {
-		for (uint32_t j = 0; j < result_shape[1]; ++j) {
-			result._data[i * result_shape[1] + j] = this->_data[j * result_shape[0] + i];
+	transposeKernel(this->_shape[0], this->_shape[1], this->_data.data(), result._data.data());
+
+	return result;
+}
+
+Tensor& Tensor::transposeInPlace() {
+	if (this->_shape.size()  != 2) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	uint32_t n = this->_shape[0];
+	uint32_t m = this->_shape[1];
+	float* data = this->_data.data();
+
+	if (n == m) {
+		// swap blocks above the diagonal with blocks below it
+		for (uint32_t ib = 0; ib < n; ib += TRANSPOSE_BLOCK_SIZE) {
+			uint32_t i_end = std::min(ib + TRANSPOSE_BLOCK_SIZE, n);
+			for (uint32_t jb = ib; jb < n; jb += TRANSPOSE_BLOCK_SIZE) {
+				uint32_t j_end = std::min(jb + TRANSPOSE_BLOCK_SIZE, n);
+				for (uint32_t i = ib; i < i_end; ++i) {
+					for (uint32_t j = (ib == jb ? i + 1 : jb); j < j_end; ++j) {
+						std::swap(data[i * n + j], data[j * n + i]);
+					}
+				}
+			}
 		}
 	}
+	else {
+		// follow the cycles of the permutation idx -> (idx % m) * n + idx / m
+		std::vector<bool> visited(this->_size, false);
+
+		for (uint32_t start = 1; start + 1 < this->_size; ++start) {
+			if (visited[start]) {
+				continue;
+			}
+
+			uint32_t idx = start;
+			float value = data[start];
+
+			do {
+				uint32_t next = (idx % m) * n + idx / m;
+				std::swap(value, data[next]);
+				visited[next] = true;
+				idx = next;
+			} while (idx != start);
+		}
+	}
+
+	this->_shape = { m, n };
+
+	return *this;
+}
+
+const Tensor Tensor::permute(const std::vector<uint32_t>& axes) const {
+	uint32_t dim = this->_shape.size();
+
+	if (axes.size() != dim) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	std::vector<bool> used(dim, false);
+	for (auto axis : axes) {
+		if (axis >= dim || used[axis]) {
+			printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+		}
+		used[axis] = true;
+	}
+
+	std::vector<uint32_t> strides(dim, 1);
+	for (int32_t i{ static_cast<int32_t>(dim) - 2 }; i >= 0; --i) {
+		strides[i] = strides[i + 1] * this->_shape[i + 1];
+	}
+
+	std::vector<uint32_t> result_shape(dim);
+	std::vector<uint32_t> result_strides(dim);
+	for (uint32_t i{ 0 }; i < dim; ++i) {
+		result_shape[i] = this->_shape[axes[i]];
+		result_strides[i] = strides[axes[i]];
+	}
+
+	Tensor result = Tensor(result_shape);
+
+	if (dim >= 2 && axes[dim - 1] == dim - 2 && axes[dim - 2] == dim - 1) {
+		bool batched_transpose = true;
+		for (uint32_t i{ 0 }; i + 2 < dim; ++i) {
+			batched_transpose &= (axes[i] == i);
+		}
+		if (batched_transpose) {
+			// only the two last axes are swapped, transpose each matrix separately
+			uint32_t n = this->_shape[dim - 2];
+			uint32_t m = this->_shape[dim - 1];
+			for (uint32_t b{ 0 }; b < this->_size / (n * m); ++b) {
+				transposeKernel(n, m, this->_data.data() + b * n * m, result._data.data() + b * n * m);
+			}
+			return result;
+		}
+	}
+
+	switch (dim) {
+		case 1:
+			kernels::stridedCopyKernel<1>(result_shape.data(), result_strides.data(), this->_data.data(), result._data.data());
+			break;
+		case 2:
+			kernels::stridedCopyKernel<2>(result_shape.data(), result_strides.data(), this->_data.data(), result._data.data());
+			break;
+		case 3:
+			kernels::stridedCopyKernel<3>(result_shape.data(), result_strides.data(), this->_data.data(), result._data.data());
+			break;
+		case 4:
+			kernels::stridedCopyKernel<4>(result_shape.data(), result_strides.data(), this->_data.data(), result._data.data());
+			break;
+		default:
+			permuteGeneric(result_shape, result_strides, result);
+			break;
+	}
 
 	return result;
 }
 
+void Tensor::permuteGeneric(const std::vector<uint32_t>& result_shape, const std::vector<uint32_t>& result_strides, Tensor& result) const {
+	// walk the result in order, inner loop runs over its last axis
+	uint32_t dim = result_shape.size();
+	uint32_t inner_size = result_shape[dim - 1];
+	uint32_t inner_stride = result_strides[dim - 1];
+	std::vector<uint32_t> index(dim, 0);
+	uint32_t offset = 0;
+
+	for (uint32_t r{ 0 }; r < this->_size; r += inner_size) {
+		const float* src = this->_data.data() + offset;
+		float* dst = result._data.data() + r;
+		for (uint32_t j{ 0 }; j < inner_size; ++j) {
+			dst[j] = src[j * inner_stride];
+		}
+
+		// increment index
+		for (int32_t i{ static_cast<int32_t>(dim) - 2 }; i >= 0; --i) {
+			++index[i];
+			offset += result_strides[i];
+			if (index[i] < result_shape[i]) {
+				break;
+			}
+			offset -= index[i] * result_strides[i];
+			index[i] = 0;
+		}
+	}
+}
+
 const Tensor Tensor::slice(uint32_t axis, uint32_t start_idx, uint32_t end_idx) const {
 	if (start_idx >= end_idx) {
 		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
@@ -1199,6 +1817,16 @@ const Tensor Tensor::reshape(std::vector<uint32_t> new_shape) const {
 	return result;
 }
 
+Tensor& Tensor::reshapeInPlace(std::vector<uint32_t> new_shape) {
+	if (shapeSize(new_shape) != this->_size) {
+		printf("EXCEPTION %d\n", __LINE__); throw std::invalid_argument(""); // exception
+	}
+
+	this->_shape = new_shape;
+
+	return *this;
+}
+
 void Tensor::print() const {
 	printf("Tensor({ ");
 	for (uint32_t i{ 0 }; i < this->_shape.size(); ++i) {
@@ -1207,26 +1835,31 @@ void Tensor::print() const {
 	printf("})\n");
 }
 
-bool Tensor::validateShape(const Tensor& other) const {
-	uint32_t i = 0;
-	uint32_t min_dim = 0;
+bool Tensor::validateShapeBroadcast(const Tensor& other, std::vector<uint32_t>& result_shape) const {
+	// shapes are aligned from the last axis, each pair of sizes has to be equal or one of them 1
+	uint32_t dim = std::max(this->_shape.size(), other._shape.size());
+	result_shape.assign(dim, 1);
 
-	if (this->_shape.size() < other._shape.size() ) {
-		min_dim = this->_shape.size();
-	}
-	else {
-		min_dim = other._shape.size();
-	}
-	
-	for (i = 0; i < min_dim; ++i) {
-		if (this->_shape[i] != other._shape[i]) {
+	for (uint32_t i{ 0 }; i < dim; ++i) {
+		uint32_t a = i < this->_shape.size() ? this->_shape[this->_shape.size() - 1 - i] : 1;
+		uint32_t b = i < other._shape.size() ? other._shape[other._shape.size() - 1 - i] : 1;
+		if ((a != b) && (1 != a) && (1 != b)) {
 			return false;
 		}
+		result_shape[dim - 1 - i] = std::max(a, b);
 	}
 
 	return true;
 }
 
+uint32_t Tensor::shapeSize(const std::vector<uint32_t>& shape) {
+	uint32_t size = 1;
+	for (auto s : shape) {
+		size *= s;
+	}
+	return size;
+}
+
 bool Tensor::validateShapeReversed(const Tensor& other) const {
 	uint32_t i = 0;
 	uint32_t min_dim = 0;
@@ -1245,4 +1878,36 @@ bool Tensor::validateShapeReversed(const Tensor& other) const {
 	}
 
 	return true;
+}
+
+void Tensor::transposeKernel(uint32_t n, uint32_t m, const float* v, float* r) {
+	// r (m x n) = v (n x m) transposed, tile by tile so both sides stay in cache
+	for (uint32_t ib{ 0 }; ib < n; ib += TRANSPOSE_BLOCK_SIZE) {
+		uint32_t i_end = std::min(ib + TRANSPOSE_BLOCK_SIZE, n);
+		for (uint32_t jb{ 0 }; jb < m; jb += TRANSPOSE_BLOCK_SIZE) {
+			uint32_t j_end = std::min(jb + TRANSPOSE_BLOCK_SIZE, m);
+			uint32_t i_start = ib;
+
+			#ifdef SSE
+			uint32_t i_vec = (i_end - ib) & ~3u;
+			uint32_t j_vec = (j_end - jb) & ~3u;
+
+			SSE_tensor_transpose_block(i_vec, j_vec, m, n, &v[ib * m + jb], &r[jb * n + ib]);
+
+			// columns left over on the right of the vectorized part
+			for (uint32_t i{ ib }; i < ib + i_vec; ++i) {
+				for (uint32_t j{ jb + j_vec }; j < j_end; ++j) {
+					r[j * n + i] = v[i * m + j];
+				}
+			}
+			i_start = ib + i_vec;
+			#endif	// SSE
+
+			for (uint32_t i{ i_start }; i < i_end; ++i) {
+				for (uint32_t j{ jb }; j < j_end; ++j) {
+					r[j * n + i] = v[i * m + j];
+				}
+			}
+		}
+	}
 }
\ No newline at end of file
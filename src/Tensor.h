@@ -8,6 +8,9 @@
 #include <ctime>
 #include <algorithm>
 #include <cstdio>
+#include <stdexcept>
+
+#include "MemoryTracker.h"
 
 #ifdef SSE
 	#ifndef WIN
@@ -36,6 +39,8 @@
 		#define SSE_tensor_last_axis_sum			_SSE_tensor_last_axis_sum
 
 		#define SSE_tensor_dot_product_transpose	_SSE_tensor_dot_product_transpose
+
+		#define SSE_tensor_transpose_block			_SSE_tensor_transpose_block
 	#endif
 	
 	extern "C" {
@@ -64,10 +69,14 @@
 		void SSE_tensor_last_axis_sum(const uint32_t n, const uint32_t k, const float* v, float* r);
 
 		void SSE_tensor_dot_product_transpose(const uint32_t n, const uint32_t m, const uint32_t k, const float* v1, const float *v2, float *r);
+
+		void SSE_tensor_transpose_block(const uint32_t n, const uint32_t m, const uint32_t v_stride, const uint32_t r_stride, const float* v, float* r);
 	}
 #endif
 
 #define WHOLE_AXIS (static_cast<uint32_t>(-1))
+#define TRANSPOSE_BLOCK_SIZE (32u)
+#define REDUCE_PARALLEL_MIN_WORK (1u << 15)
 
 enum Padding : uint8_t {
 	Left = 0x01,
@@ -75,6 +84,38 @@ enum Padding : uint8_t {
 	Both = 0x03,
 };
 
+enum class ConvPadding : uint8_t {
+	Valid,
+	Same,
+	Explicit
+};
+
+struct Conv2DParams {
+	uint32_t stride{ 1 };
+	uint32_t dilation{ 1 };
+	ConvPadding padding{ ConvPadding::Valid };
+	// zeros on each side for explicit padding
+	uint32_t padding_h{ 0 };
+	uint32_t padding_w{ 0 };
+};
+
+// Convolution of one (h x w x c) sample with (filter_h x filter_w x c x f) filters, padding is virtual:
+// zeros before the first row and column are counted in padding_top and padding_left, taps outside the input are skipped.
+struct Conv2DGeometry {
+	uint32_t h;
+	uint32_t w;
+	uint32_t c;
+	uint32_t f;
+	uint32_t filter_h;
+	uint32_t filter_w;
+	uint32_t stride;
+	uint32_t dilation;
+	uint32_t padding_top;
+	uint32_t padding_left;
+	uint32_t out_h;
+	uint32_t out_w;
+};
+
 class Tensor {
 public:
 	Tensor(const std::vector<uint32_t>& shape);
@@ -87,9 +128,13 @@ public:
 	uint32_t getDim() const;
 	uint32_t getSize() const;
 	std::vector<float> getData() const;
+	const float* getDataPtr() const;
+	float* getDataPtr();
 	float getValue(const std::vector<uint32_t>& idx = { 0 }) const;
 	void setValue(float value, const std::vector<uint32_t>& idx = { 0 });
 	void setValues(const std::vector<float>& values);
+	// frees the storage, assignment keeps capacity, tensor becomes the default one-element tensor
+	void release();
 	Tensor getSubTensor(const std::vector<uint32_t>& axes) const;
 	Tensor getSubTensor(const std::vector<std::vector<uint32_t> >& ranges) const;
 	void setValuesOfSubTensor(const std::vector<uint32_t>& axes, const Tensor& other);
@@ -122,27 +167,57 @@ public:
 	const Tensor operator<(float other) const;
 	const Tensor dotProduct(const Tensor& other) const;
 	const Tensor dotProductTranspose(const Tensor& other) const;
+	const Tensor dotProduct(const Tensor& other, bool transpose_this, bool transpose_other) const;
 	const Tensor tensorProduct(const Tensor& other) const;
 	const Tensor applyFunction(float (*function)(float)) const;
 	const Tensor flatten(uint32_t from_axis=0) const;
-	const Tensor Conv2D(const Tensor& other) const;
+	const Tensor Conv2D(const Tensor& other, const Conv2DParams& params=Conv2DParams()) const;
+	const Tensor Conv2DIm2col(const Tensor& other, const Conv2DParams& params=Conv2DParams()) const;
+	// stride 1 and dilation 1 only
+	const Tensor Conv2DWinograd(const Tensor& transformed_weights, const Conv2DParams& params=Conv2DParams()) const;
+	// stride 1 and dilation 1 only, filter spectra are computed on every call
+	const Tensor Conv2DFFT(const Tensor& other, const Conv2DParams& params=Conv2DParams()) const;
+	// input (h x w x c), filters (filter_h x filter_w x c x f)
+	static Conv2DGeometry conv2DGeometry(const std::vector<uint32_t>& input_shape, const std::vector<uint32_t>& filter_shape, const Conv2DParams& params);
+	static const Tensor winogradFilter(const Tensor& weights);
 	const Tensor sum(uint32_t axis) const;
+	const Tensor sum(const std::vector<uint32_t>& axes) const;
+	const Tensor max(const std::vector<uint32_t>& axes) const;
+	const Tensor min(const std::vector<uint32_t>& axes) const;
+	const Tensor mean(const std::vector<uint32_t>& axes) const;
+	const Tensor variance(const std::vector<uint32_t>& axes) const;
+	const Tensor argmax(uint32_t axis) const;
 	float sum() const;
 	float max() const;
+	float min() const;
 	float average() const;
+	float variance() const;
 	const Tensor transpose() const;
+	Tensor& transposeInPlace();
+	const Tensor permute(const std::vector<uint32_t>& axes) const;
 	const Tensor slice(uint32_t axis, uint32_t start_idx, uint32_t end_idx) const;
 	const Tensor shuffle() const;
 	const Tensor shuffle(uint32_t *pattern) const;
 	const Tensor reshape(std::vector<uint32_t> new_shape) const;
+	Tensor& reshapeInPlace(std::vector<uint32_t> new_shape);
 
 	void print() const;
 
 private:
 	std::vector<uint32_t> _shape;
 	uint32_t _size;
-	std::vector<float> _data;
+	std::vector<float, TrackingAllocator<float> > _data;
 
-	bool validateShape(const Tensor& other) const;
+	bool validateShapeBroadcast(const Tensor& other, std::vector<uint32_t>& result_shape) const;
 	bool validateShapeReversed(const Tensor& other) const;
+
+	static uint32_t shapeSize(const std::vector<uint32_t>& shape);
+	template <typename Op>
+	const Tensor reduce(const std::vector<uint32_t>& axes, Op op) const;
+	template <typename Op>
+	static void reduceParallel(uint32_t outer, uint32_t n, uint32_t inner, const float* v, float* r, Op op);
+	template <typename Op>
+	static void broadcastOperation(const Tensor& a, const Tensor& b, Tensor& result, Op op);
+	static void transposeKernel(uint32_t n, uint32_t m, const float* v, float* r);
+	void permuteGeneric(const std::vector<uint32_t>& result_shape, const std::vector<uint32_t>& result_strides, Tensor& result) const;
 };
\ No newline at end of file
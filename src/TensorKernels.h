@@ -0,0 +1,1031 @@
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+
+#include "Tensor.h"
+#include "FFT.h"
+
+// Compile-time specialised kernels used by Tensor and layers.
+// Template parameters equal to 0 mean the size is only known at runtime,
+// non-zero values let the compiler fully unroll loops for small fixed sizes.
+namespace kernels {
+
+template <typename T, typename Op>
+inline void binaryKernel(uint32_t n, const T* v1, const T* v2, T* r, Op op) {
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		r[i] = op(v1[i], v2[i]);
+	}
+}
+
+template <typename T, typename Op>
+inline void repeatedBinaryKernel(uint32_t n1, const T* v1, uint32_t n2, const T* v2, T* r, Op op) {
+	// v2 is repeated over v1, same as v2[i % n2] without division in the inner loop
+	for (uint32_t b{ 0 }; b < n1; b += n2) {
+		binaryKernel(std::min(n2, n1 - b), v1 + b, v2, r + b, op);
+	}
+}
+
+template <typename T, typename Op>
+inline void scalarBinaryKernel(uint32_t n, const T* v, T s, T* r, Op op) {
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		r[i] = op(v[i], s);
+	}
+}
+
+template <typename T, typename Op>
+inline void broadcastBinaryKernel(uint32_t rank, const uint32_t* shape, const uint32_t* strides1, const T* v1, const uint32_t* strides2, const T* v2, T* r, Op op) {
+	// r is written in order, broadcast dimensions of v1 and v2 have stride 0
+	uint32_t n = shape[rank - 1];
+	uint32_t s1 = strides1[rank - 1];
+	uint32_t s2 = strides2[rank - 1];
+	uint32_t size = n;
+	for (uint32_t i{ 0 }; i + 1 < rank; ++i) {
+		size *= shape[i];
+	}
+
+	std::vector<uint32_t> index(rank, 0);
+	uint32_t offset1 = 0;
+	uint32_t offset2 = 0;
+
+	for (uint32_t b{ 0 }; b < size; b += n) {
+		const T* p1 = v1 + offset1;
+		const T* p2 = v2 + offset2;
+		T* pr = r + b;
+
+		if (1 == s1 && 1 == s2) {
+			binaryKernel(n, p1, p2, pr, op);
+		}
+		else if (1 == s1 && 0 == s2) {
+			scalarBinaryKernel(n, p1, *p2, pr, op);
+		}
+		else if (0 == s1 && 1 == s2) {
+			T value = *p1;
+			for (uint32_t i{ 0 }; i < n; ++i) {
+				pr[i] = op(value, p2[i]);
+			}
+		}
+		else {
+			for (uint32_t i{ 0 }; i < n; ++i) {
+				pr[i] = op(p1[i * s1], p2[i * s2]);
+			}
+		}
+
+		// increment index of outer dimensions
+		for (int32_t i{ static_cast<int32_t>(rank) - 2 }; i >= 0; --i) {
+			++index[i];
+			offset1 += strides1[i];
+			offset2 += strides2[i];
+			if (index[i] < shape[i]) {
+				break;
+			}
+			offset1 -= index[i] * strides1[i];
+			offset2 -= index[i] * strides2[i];
+			index[i] = 0;
+		}
+	}
+}
+
+#define DENSE_KERNEL_BLOCK_SIZE (64u)
+
+template <typename T, typename Activation>
+inline void denseKernel(uint32_t n, uint32_t m, uint32_t k, const T* x, const T* weights, const T* biases, T* r) {
+	// r (n x m) = activation(x (n x k) . weights (m x k)^T + biases (m)), bias and activation applied
+	// while the result is still in registers, weights are processed in blocks of rows kept in cache
+	for (uint32_t jb{ 0 }; jb < m; jb += DENSE_KERNEL_BLOCK_SIZE) {
+		uint32_t j_end = std::min(jb + DENSE_KERNEL_BLOCK_SIZE, m);
+		for (uint32_t i{ 0 }; i < n; ++i) {
+			const T* x_row = x + i * k;
+			for (uint32_t j{ jb }; j < j_end; ++j) {
+				const T* w_row = weights + j * k;
+				T acc[8] = { 0 };
+				uint32_t l{ 0 };
+				for (; l + 8 <= k; l += 8) {
+					for (uint32_t a{ 0 }; a < 8; ++a) {
+						acc[a] += x_row[l + a] * w_row[l + a];
+					}
+				}
+				for (; l < k; ++l) {
+					acc[0] += x_row[l] * w_row[l];
+				}
+				T sum = ((acc[0] + acc[4]) + (acc[1] + acc[5])) + ((acc[2] + acc[6]) + (acc[3] + acc[7]));
+				r[i * m + j] = Activation::forward(sum + biases[j]);
+			}
+		}
+	}
+}
+
+template <typename T, typename Activation>
+inline void biasActivationKernel(uint32_t n, uint32_t m, const T* biases, T* r) {
+	// r (n x m) = activation(r + biases (m)) in one pass
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		T* row = r + i * m;
+		for (uint32_t j{ 0 }; j < m; ++j) {
+			row[j] = Activation::forward(row[j] + biases[j]);
+		}
+	}
+}
+
+template <typename T, typename Activation>
+inline void activationKernel(uint32_t n, const T* x, T* r) {
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		r[i] = Activation::forward(x[i]);
+	}
+}
+
+template <typename T, typename Activation>
+inline void activationBackwardKernel(uint32_t n, const T* y, const T* dx, T* r) {
+	// gradient through activation computed from its output
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		r[i] = dx[i] * Activation::derivative(y[i]);
+	}
+}
+
+#define REDUCE_PAIRWISE_BLOCK_SIZE (128u)
+#define REDUCE_ACCUMULATORS_COUNT (8u)
+
+template <typename T, typename Op>
+inline T pairwiseReduceKernel(uint32_t n, const T* v, Op op) {
+	// blocks use independent accumulators, blocks are combined pairwise
+	if (n > REDUCE_PAIRWISE_BLOCK_SIZE) {
+		uint32_t half = (n / 2) & ~(REDUCE_ACCUMULATORS_COUNT - 1);
+		return op(pairwiseReduceKernel(half, v, op), pairwiseReduceKernel(n - half, v + half, op));
+	}
+
+	if (n < REDUCE_ACCUMULATORS_COUNT) {
+		T result = v[0];
+		for (uint32_t i{ 1 }; i < n; ++i) {
+			result = op(result, v[i]);
+		}
+		return result;
+	}
+
+	T acc[REDUCE_ACCUMULATORS_COUNT];
+	for (uint32_t j{ 0 }; j < REDUCE_ACCUMULATORS_COUNT; ++j) {
+		acc[j] = v[j];
+	}
+	uint32_t i{ REDUCE_ACCUMULATORS_COUNT };
+	for (; i + REDUCE_ACCUMULATORS_COUNT <= n; i += REDUCE_ACCUMULATORS_COUNT) {
+		for (uint32_t j{ 0 }; j < REDUCE_ACCUMULATORS_COUNT; ++j) {
+			acc[j] = op(acc[j], v[i + j]);
+		}
+	}
+	for (uint32_t j{ 0 }; i < n; ++i, ++j) {
+		acc[j] = op(acc[j], v[i]);
+	}
+	for (uint32_t width{ REDUCE_ACCUMULATORS_COUNT / 2 }; width > 0; width /= 2) {
+		for (uint32_t j{ 0 }; j < width; ++j) {
+			acc[j] = op(acc[j], acc[j + width]);
+		}
+	}
+	return acc[0];
+}
+
+template <typename T, typename Op>
+inline void pairwiseReduceRowsKernel(uint32_t n, uint32_t inner, uint32_t stride, const T* v, T* r, T* buffer, Op op) {
+	// r = reduction of n rows of length inner placed every stride elements,
+	// buffer needs inner elements for each halving of n
+	if (n > REDUCE_ACCUMULATORS_COUNT) {
+		uint32_t half = n / 2;
+		pairwiseReduceRowsKernel(half, inner, stride, v, r, buffer + inner, op);
+		pairwiseReduceRowsKernel(n - half, inner, stride, v + half * stride, buffer, buffer + inner, op);
+		binaryKernel(inner, r, buffer, r, op);
+		return;
+	}
+
+	std::copy(v, v + inner, r);
+	for (uint32_t i{ 1 }; i < n; ++i) {
+		binaryKernel(inner, r, v + i * stride, r, op);
+	}
+}
+
+template <typename T, typename Op>
+inline void reduceKernel(uint32_t outer, uint32_t n, uint32_t inner, uint32_t stride, const T* v, T* r, Op op) {
+	// v viewed as (outer x n x stride), reduces axis n for first inner elements of the last axis,
+	// r viewed as (outer x stride)
+	if (1 == inner && 1 == stride) {
+		for (uint32_t o{ 0 }; o < outer; ++o) {
+			r[o] = pairwiseReduceKernel(n, v + o * n, op);
+		}
+		return;
+	}
+
+	std::vector<T> buffer(inner * 32);
+	for (uint32_t o{ 0 }; o < outer; ++o) {
+		pairwiseReduceRowsKernel(n, inner, stride, v + o * n * stride, r + o * stride, buffer.data(), op);
+	}
+}
+
+template <typename T>
+inline void argmaxKernel(uint32_t outer, uint32_t n, uint32_t inner, uint32_t stride, const T* v, T* r) {
+	// index of first maximal value along axis n, v viewed as (outer x n x stride), r as (outer x stride)
+	std::vector<T> max_values(inner);
+
+	for (uint32_t o{ 0 }; o < outer; ++o) {
+		const T* v_o = v + o * n * stride;
+		T* r_o = r + o * stride;
+
+		if (1 == inner) {
+			uint32_t max_idx{ 0 };
+			for (uint32_t i{ 1 }; i < n; ++i) {
+				max_idx = v_o[i * stride] > v_o[max_idx * stride] ? i : max_idx;
+			}
+			r_o[0] = static_cast<T>(max_idx);
+			continue;
+		}
+
+		std::copy(v_o, v_o + inner, max_values.begin());
+		std::fill(r_o, r_o + inner, static_cast<T>(0));
+		for (uint32_t i{ 1 }; i < n; ++i) {
+			const T* row = v_o + i * stride;
+			for (uint32_t k{ 0 }; k < inner; ++k) {
+				bool greater = row[k] > max_values[k];
+				max_values[k] = greater ? row[k] : max_values[k];
+				r_o[k] = greater ? static_cast<T>(i) : r_o[k];
+			}
+		}
+	}
+}
+
+template <uint32_t Rank, typename T>
+inline void stridedCopyKernel(const uint32_t* shape, const uint32_t* strides, const T* v, T* r) {
+	// r is written in order, v is read with given strides
+	if constexpr (1 == Rank) {
+		for (uint32_t i{ 0 }; i < shape[0]; ++i) {
+			r[i] = v[i * strides[0]];
+		}
+	}
+	else {
+		uint32_t r_stride = 1;
+		for (uint32_t i{ 1 }; i < Rank; ++i) {
+			r_stride *= shape[i];
+		}
+		for (uint32_t i{ 0 }; i < shape[0]; ++i) {
+			stridedCopyKernel<Rank - 1>(shape + 1, strides + 1, v + i * strides[0], r + i * r_stride);
+		}
+	}
+}
+
+inline void conv2DTapsRange(int32_t origin, uint32_t size, uint32_t taps, uint32_t dilation, uint32_t& begin, uint32_t& end) {
+	// filter taps t with 0 <= origin + t * dilation < size, origin is negative inside the padding
+	int32_t d = static_cast<int32_t>(dilation);
+	int32_t first = (origin < 0) ? (-origin + d - 1) / d : 0;
+	int32_t last = (static_cast<int32_t>(size) > origin) ? (static_cast<int32_t>(size) - origin + d - 1) / d : 0;
+	end = static_cast<uint32_t>(std::min(static_cast<int32_t>(taps), last));
+	begin = std::min(static_cast<uint32_t>(first), end);
+}
+
+#define CONV2D_TILE_WIDTH (4u)
+
+template <typename T, typename Acc>
+inline void conv2DTileKernel(const Conv2DGeometry& g, uint32_t tile_w, int32_t y0, int32_t x0,
+							 uint32_t kh_begin, uint32_t kh_end, uint32_t kw_begin, uint32_t kw_end,
+							 const T* x, const T* weights, Acc* r) {
+	// tile_w output pixels of one row with the first window at input (y0, x0), taps in the given ranges are inside
+	// the input for all pixels, r zero initialized, the pixel values stay in registers and every filter row is loaded
+	// once for the whole tile, the inner loop runs over contiguous output channels
+	const uint32_t f = g.f;
+	const uint32_t step = g.stride * g.c;
+
+	for (uint32_t kh{ kh_begin }; kh < kh_end; ++kh) {
+		for (uint32_t kw{ kw_begin }; kw < kw_end; ++kw) {
+			const T* x_pixel = x + ((y0 + static_cast<int32_t>(kh * g.dilation)) * static_cast<int32_t>(g.w) + x0 + static_cast<int32_t>(kw * g.dilation)) * static_cast<int32_t>(g.c);
+			const T* w_pixel = weights + (kh * g.filter_w + kw) * g.c * f;
+			for (uint32_t ch{ 0 }; ch < g.c; ++ch) {
+				const T* w_row = w_pixel + ch * f;
+				if (CONV2D_TILE_WIDTH == tile_w) {
+					Acc x_0 = static_cast<Acc>(x_pixel[ch]);
+					Acc x_1 = static_cast<Acc>(x_pixel[step + ch]);
+					Acc x_2 = static_cast<Acc>(x_pixel[2 * step + ch]);
+					Acc x_3 = static_cast<Acc>(x_pixel[3 * step + ch]);
+					Acc* r_0 = r;
+					Acc* r_1 = r + f;
+					Acc* r_2 = r + 2 * f;
+					Acc* r_3 = r + 3 * f;
+					for (uint32_t k{ 0 }; k < f; ++k) {
+						Acc w_value = static_cast<Acc>(w_row[k]);
+						r_0[k] += x_0 * w_value;
+						r_1[k] += x_1 * w_value;
+						r_2[k] += x_2 * w_value;
+						r_3[k] += x_3 * w_value;
+					}
+				}
+				else {
+					for (uint32_t t{ 0 }; t < tile_w; ++t) {
+						Acc x_value = static_cast<Acc>(x_pixel[t * step + ch]);
+						Acc* r_pixel = r + t * f;
+						for (uint32_t k{ 0 }; k < f; ++k) {
+							r_pixel[k] += x_value * static_cast<Acc>(w_row[k]);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+inline void conv2DInnerColumns(const Conv2DGeometry& g, uint32_t& begin, uint32_t& end) {
+	// output columns whose whole window lies inside the input width
+	uint32_t span = (g.filter_w - 1) * g.dilation;
+	begin = std::min((g.padding_left + g.stride - 1) / g.stride, g.out_w);
+	end = (g.w + g.padding_left > span) ? std::min((g.w + g.padding_left - span - 1) / g.stride + 1, g.out_w) : 0;
+	end = std::max(begin, end);
+}
+
+template <typename T, typename Acc>
+inline void conv2DDirectKernel(const Conv2DGeometry& g, const T* x, const T* weights, Acc* r) {
+	// x (h x w x c), weights (filter_h x filter_w x c x f), r (out_h x out_w x f) zero initialized,
+	// inner columns are computed in register tiles, border columns pixel by pixel with clipped filters
+	uint32_t inner_begin, inner_end;
+	conv2DInnerColumns(g, inner_begin, inner_end);
+
+	for (uint32_t i{ 0 }; i < g.out_h; ++i) {
+		int32_t y0 = static_cast<int32_t>(i * g.stride) - static_cast<int32_t>(g.padding_top);
+		uint32_t kh_begin, kh_end;
+		conv2DTapsRange(y0, g.h, g.filter_h, g.dilation, kh_begin, kh_end);
+		Acc* r_row = r + i * g.out_w * g.f;
+
+		for (uint32_t j{ 0 }; j < g.out_w;) {
+			int32_t x0 = static_cast<int32_t>(j * g.stride) - static_cast<int32_t>(g.padding_left);
+			uint32_t tile_w{ 1 };
+			uint32_t kw_begin{ 0 };
+			uint32_t kw_end{ g.filter_w };
+			if ((j >= inner_begin) && (j < inner_end)) {
+				tile_w = std::min(CONV2D_TILE_WIDTH, inner_end - j);
+			}
+			else {
+				conv2DTapsRange(x0, g.w, g.filter_w, g.dilation, kw_begin, kw_end);
+			}
+			conv2DTileKernel<T, Acc>(g, tile_w, y0, x0, kh_begin, kh_end, kw_begin, kw_end, x, weights, r_row + j * g.f);
+			j += tile_w;
+		}
+	}
+}
+
+template <typename T>
+inline void conv2DBackwardInputKernel(const Conv2DGeometry& g, const T* dy, const T* weights_t, T* dx) {
+	// dy (out_h x out_w x f), weights_t (filter_h x filter_w x f x c) filters with swapped channel axes,
+	// dx (h x w x c) accumulates, the inner loop runs over contiguous input channels
+	const uint32_t c = g.c;
+
+	for (uint32_t i{ 0 }; i < g.out_h; ++i) {
+		int32_t y0 = static_cast<int32_t>(i * g.stride) - static_cast<int32_t>(g.padding_top);
+		uint32_t kh_begin, kh_end;
+		conv2DTapsRange(y0, g.h, g.filter_h, g.dilation, kh_begin, kh_end);
+
+		for (uint32_t j{ 0 }; j < g.out_w; ++j) {
+			int32_t x0 = static_cast<int32_t>(j * g.stride) - static_cast<int32_t>(g.padding_left);
+			uint32_t kw_begin, kw_end;
+			conv2DTapsRange(x0, g.w, g.filter_w, g.dilation, kw_begin, kw_end);
+			const T* dy_pixel = dy + (i * g.out_w + j) * g.f;
+
+			for (uint32_t kh{ kh_begin }; kh < kh_end; ++kh) {
+				for (uint32_t kw{ kw_begin }; kw < kw_end; ++kw) {
+					T* dx_pixel = dx + ((y0 + static_cast<int32_t>(kh * g.dilation)) * static_cast<int32_t>(g.w) + x0 + static_cast<int32_t>(kw * g.dilation)) * static_cast<int32_t>(c);
+					const T* w_pixel = weights_t + (kh * g.filter_w + kw) * g.f * c;
+					for (uint32_t k{ 0 }; k < g.f; ++k) {
+						T dy_value = dy_pixel[k];
+						const T* w_row = w_pixel + k * c;
+						for (uint32_t ch{ 0 }; ch < c; ++ch) {
+							dx_pixel[ch] += dy_value * w_row[ch];
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+template <typename T>
+inline void conv2DBackwardWeightsKernel(const Conv2DGeometry& g, const T* x, const T* dy, T* weights_d, T* biases_d) {
+	// x (h x w x c), dy (out_h x out_w x f), weights_d (filter_h x filter_w x c x f) and biases_d (f) accumulate,
+	// the inner loop runs over contiguous output channels
+	const uint32_t f = g.f;
+
+	for (uint32_t i{ 0 }; i < g.out_h; ++i) {
+		int32_t y0 = static_cast<int32_t>(i * g.stride) - static_cast<int32_t>(g.padding_top);
+		uint32_t kh_begin, kh_end;
+		conv2DTapsRange(y0, g.h, g.filter_h, g.dilation, kh_begin, kh_end);
+
+		for (uint32_t j{ 0 }; j < g.out_w; ++j) {
+			int32_t x0 = static_cast<int32_t>(j * g.stride) - static_cast<int32_t>(g.padding_left);
+			uint32_t kw_begin, kw_end;
+			conv2DTapsRange(x0, g.w, g.filter_w, g.dilation, kw_begin, kw_end);
+			const T* dy_pixel = dy + (i * g.out_w + j) * f;
+
+			for (uint32_t k{ 0 }; k < f; ++k) {
+				biases_d[k] += dy_pixel[k];
+			}
+
+			for (uint32_t kh{ kh_begin }; kh < kh_end; ++kh) {
+				for (uint32_t kw{ kw_begin }; kw < kw_end; ++kw) {
+					const T* x_pixel = x + ((y0 + static_cast<int32_t>(kh * g.dilation)) * static_cast<int32_t>(g.w) + x0 + static_cast<int32_t>(kw * g.dilation)) * static_cast<int32_t>(g.c);
+					T* wd_pixel = weights_d + (kh * g.filter_w + kw) * g.c * f;
+					for (uint32_t ch{ 0 }; ch < g.c; ++ch) {
+						T x_value = x_pixel[ch];
+						T* wd_row = wd_pixel + ch * f;
+						for (uint32_t k{ 0 }; k < f; ++k) {
+							wd_row[k] += x_value * dy_pixel[k];
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+template <typename T>
+inline void im2colKernel(const Conv2DGeometry& g, const T* x, T* cols) {
+	// x (h x w x c), cols (out_h * out_w x filter_h * filter_w * c), one patch per row, taps in the padding are zeros
+	const uint32_t c = g.c;
+	const uint32_t patch_size = g.filter_h * g.filter_w * c;
+
+	for (uint32_t i{ 0 }; i < g.out_h; ++i) {
+		int32_t y0 = static_cast<int32_t>(i * g.stride) - static_cast<int32_t>(g.padding_top);
+		uint32_t kh_begin, kh_end;
+		conv2DTapsRange(y0, g.h, g.filter_h, g.dilation, kh_begin, kh_end);
+
+		for (uint32_t j{ 0 }; j < g.out_w; ++j) {
+			int32_t x0 = static_cast<int32_t>(j * g.stride) - static_cast<int32_t>(g.padding_left);
+			uint32_t kw_begin, kw_end;
+			conv2DTapsRange(x0, g.w, g.filter_w, g.dilation, kw_begin, kw_end);
+			T* col = cols + (i * g.out_w + j) * patch_size;
+
+			if ((kh_begin > 0) || (kh_end < g.filter_h) || (kw_begin > 0) || (kw_end < g.filter_w)) {
+				std::fill(col, col + patch_size, static_cast<T>(0));
+			}
+			for (uint32_t kh{ kh_begin }; kh < kh_end; ++kh) {
+				for (uint32_t kw{ kw_begin }; kw < kw_end; ++kw) {
+					const T* x_pixel = x + ((y0 + static_cast<int32_t>(kh * g.dilation)) * static_cast<int32_t>(g.w) + x0 + static_cast<int32_t>(kw * g.dilation)) * static_cast<int32_t>(c);
+					std::copy(x_pixel, x_pixel + c, col + (kh * g.filter_w + kw) * c);
+				}
+			}
+		}
+	}
+}
+
+template <typename T>
+inline void depthwiseConv2DKernel(const Conv2DGeometry& g, const T* x, const T* weights, const T* biases, T* r) {
+	// x (h x w x c), weights (filter_h x filter_w x c) one filter per channel, r (out_h x out_w x c) starts from biases,
+	// the inner loop runs over contiguous channels of one NHWC pixel
+	const uint32_t c = g.c;
+
+	for (uint32_t i{ 0 }; i < g.out_h; ++i) {
+		int32_t y0 = static_cast<int32_t>(i * g.stride) - static_cast<int32_t>(g.padding_top);
+		uint32_t kh_begin, kh_end;
+		conv2DTapsRange(y0, g.h, g.filter_h, g.dilation, kh_begin, kh_end);
+
+		for (uint32_t j{ 0 }; j < g.out_w; ++j) {
+			int32_t x0 = static_cast<int32_t>(j * g.stride) - static_cast<int32_t>(g.padding_left);
+			uint32_t kw_begin, kw_end;
+			conv2DTapsRange(x0, g.w, g.filter_w, g.dilation, kw_begin, kw_end);
+			T* r_pixel = r + (i * g.out_w + j) * c;
+			std::copy(biases, biases + c, r_pixel);
+
+			for (uint32_t kh{ kh_begin }; kh < kh_end; ++kh) {
+				for (uint32_t kw{ kw_begin }; kw < kw_end; ++kw) {
+					const T* x_pixel = x + ((y0 + static_cast<int32_t>(kh * g.dilation)) * static_cast<int32_t>(g.w) + x0 + static_cast<int32_t>(kw * g.dilation)) * static_cast<int32_t>(c);
+					const T* w_pixel = weights + (kh * g.filter_w + kw) * c;
+					for (uint32_t ch{ 0 }; ch < c; ++ch) {
+						r_pixel[ch] += x_pixel[ch] * w_pixel[ch];
+					}
+				}
+			}
+		}
+	}
+}
+
+template <typename T>
+inline void depthwiseConv2DBackwardKernel(const Conv2DGeometry& g, const T* x, const T* dy, const T* weights,
+										  T* dx, T* weights_d, T* biases_d) {
+	// x and dx (h x w x c), dy (out_h x out_w x c), weights and weights_d (filter_h x filter_w x c),
+	// dx, weights_d and biases_d accumulate, both gradients are computed in one pass over the taps
+	const uint32_t c = g.c;
+
+	for (uint32_t i{ 0 }; i < g.out_h; ++i) {
+		int32_t y0 = static_cast<int32_t>(i * g.stride) - static_cast<int32_t>(g.padding_top);
+		uint32_t kh_begin, kh_end;
+		conv2DTapsRange(y0, g.h, g.filter_h, g.dilation, kh_begin, kh_end);
+
+		for (uint32_t j{ 0 }; j < g.out_w; ++j) {
+			int32_t x0 = static_cast<int32_t>(j * g.stride) - static_cast<int32_t>(g.padding_left);
+			uint32_t kw_begin, kw_end;
+			conv2DTapsRange(x0, g.w, g.filter_w, g.dilation, kw_begin, kw_end);
+			const T* dy_pixel = dy + (i * g.out_w + j) * c;
+
+			for (uint32_t ch{ 0 }; ch < c; ++ch) {
+				biases_d[ch] += dy_pixel[ch];
+			}
+
+			for (uint32_t kh{ kh_begin }; kh < kh_end; ++kh) {
+				for (uint32_t kw{ kw_begin }; kw < kw_end; ++kw) {
+					int32_t offset = ((y0 + static_cast<int32_t>(kh * g.dilation)) * static_cast<int32_t>(g.w) + x0 + static_cast<int32_t>(kw * g.dilation)) * static_cast<int32_t>(c);
+					const T* x_pixel = x + offset;
+					T* dx_pixel = dx + offset;
+					const T* w_pixel = weights + (kh * g.filter_w + kw) * c;
+					T* wd_pixel = weights_d + (kh * g.filter_w + kw) * c;
+					for (uint32_t ch{ 0 }; ch < c; ++ch) {
+						dx_pixel[ch] += dy_pixel[ch] * w_pixel[ch];
+						wd_pixel[ch] += dy_pixel[ch] * x_pixel[ch];
+					}
+				}
+			}
+		}
+	}
+}
+
+#define WINOGRAD_TILE_BLOCK_SIZE (32u)
+
+template <typename T>
+inline void winogradFilterTransformKernel(uint32_t c, uint32_t f, const T* weights, T* u) {
+	// weights (3 x 3 x c x f), u (16 x c x f) = G g G^T of F(2x2, 3x3) for every channel and filter
+	const uint32_t cf = c * f;
+	const T half = static_cast<T>(0.5);
+
+	for (uint32_t idx{ 0 }; idx < cf; ++idx) {
+		T g[3][3];
+		for (uint32_t kh{ 0 }; kh < 3; ++kh) {
+			for (uint32_t kw{ 0 }; kw < 3; ++kw) {
+				g[kh][kw] = weights[(kh * 3 + kw) * cf + idx];
+			}
+		}
+
+		T gg[4][3];
+		for (uint32_t j{ 0 }; j < 3; ++j) {
+			gg[0][j] = g[0][j];
+			gg[1][j] = (g[0][j] + g[1][j] + g[2][j]) * half;
+			gg[2][j] = (g[0][j] - g[1][j] + g[2][j]) * half;
+			gg[3][j] = g[2][j];
+		}
+
+		for (uint32_t i{ 0 }; i < 4; ++i) {
+			u[(i * 4 + 0) * cf + idx] = gg[i][0];
+			u[(i * 4 + 1) * cf + idx] = (gg[i][0] + gg[i][1] + gg[i][2]) * half;
+			u[(i * 4 + 2) * cf + idx] = (gg[i][0] - gg[i][1] + gg[i][2]) * half;
+			u[(i * 4 + 3) * cf + idx] = gg[i][2];
+		}
+	}
+}
+
+template <typename T>
+inline void winogradConv2DKernel(const Conv2DGeometry& g, const T* x, const T* u, T* r) {
+	// x (h x w x c), u (16 x c x f) transformed filters, r (out_h x out_w x f), 3x3 filters with stride and dilation 1
+	// 2x2 output tiles take 16 multiplications per channel and filter instead of 36,
+	// tiles are processed in blocks so transformed inputs stay in cache for the 16 products
+	const uint32_t h = g.h;
+	const uint32_t w = g.w;
+	const uint32_t c = g.c;
+	const uint32_t f = g.f;
+	const uint32_t out_h = g.out_h;
+	const uint32_t out_w = g.out_w;
+	const uint32_t tiles_w = (out_w + 1) / 2;
+	const uint32_t tiles_count = ((out_h + 1) / 2) * tiles_w;
+	const uint32_t block = WINOGRAD_TILE_BLOCK_SIZE;
+
+	std::vector<T> v(16 * block * c);
+	std::vector<T> m(16 * block * f);
+	std::vector<T> zeros(c, static_cast<T>(0));
+
+	for (uint32_t tb{ 0 }; tb < tiles_count; tb += block) {
+		uint32_t tiles = std::min(block, tiles_count - tb);
+
+		// V = B^T d B
+		for (uint32_t t{ 0 }; t < tiles; ++t) {
+			uint32_t y0 = ((tb + t) / tiles_w) * 2;
+			uint32_t x0 = ((tb + t) % tiles_w) * 2;
+
+			// padding is read from the zeros row
+			const T* p[4][4];
+			for (uint32_t a{ 0 }; a < 4; ++a) {
+				for (uint32_t b{ 0 }; b < 4; ++b) {
+					int32_t row = static_cast<int32_t>(y0 + a) - static_cast<int32_t>(g.padding_top);
+					int32_t col = static_cast<int32_t>(x0 + b) - static_cast<int32_t>(g.padding_left);
+					bool inside = (row >= 0) && (row < static_cast<int32_t>(h)) && (col >= 0) && (col < static_cast<int32_t>(w));
+					p[a][b] = inside ? x + (row * static_cast<int32_t>(w) + col) * static_cast<int32_t>(c) : zeros.data();
+				}
+			}
+
+			for (uint32_t ch{ 0 }; ch < c; ++ch) {
+				T bd[4][4];
+				for (uint32_t b{ 0 }; b < 4; ++b) {
+					bd[0][b] = p[0][b][ch] - p[2][b][ch];
+					bd[1][b] = p[1][b][ch] + p[2][b][ch];
+					bd[2][b] = p[2][b][ch] - p[1][b][ch];
+					bd[3][b] = p[1][b][ch] - p[3][b][ch];
+				}
+				for (uint32_t a{ 0 }; a < 4; ++a) {
+					v[((a * 4 + 0) * block + t) * c + ch] = bd[a][0] - bd[a][2];
+					v[((a * 4 + 1) * block + t) * c + ch] = bd[a][1] + bd[a][2];
+					v[((a * 4 + 2) * block + t) * c + ch] = bd[a][2] - bd[a][1];
+					v[((a * 4 + 3) * block + t) * c + ch] = bd[a][1] - bd[a][3];
+				}
+			}
+		}
+
+		// M = V . U for each of 16 tile positions
+		for (uint32_t k{ 0 }; k < 16; ++k) {
+			for (uint32_t t{ 0 }; t < tiles; ++t) {
+				T* m_row = m.data() + (k * block + t) * f;
+				const T* v_row = v.data() + (k * block + t) * c;
+				std::fill(m_row, m_row + f, static_cast<T>(0));
+				for (uint32_t ch{ 0 }; ch < c; ++ch) {
+					T v_value = v_row[ch];
+					const T* u_row = u + (k * c + ch) * f;
+					for (uint32_t o{ 0 }; o < f; ++o) {
+						m_row[o] += v_value * u_row[o];
+					}
+				}
+			}
+		}
+
+		// Y = A^T M A
+		for (uint32_t t{ 0 }; t < tiles; ++t) {
+			uint32_t y0 = ((tb + t) / tiles_w) * 2;
+			uint32_t x0 = ((tb + t) % tiles_w) * 2;
+			uint32_t rows = std::min(2u, out_h - y0);
+			uint32_t cols = std::min(2u, out_w - x0);
+
+			for (uint32_t o{ 0 }; o < f; ++o) {
+				T am[2][4];
+				for (uint32_t b{ 0 }; b < 4; ++b) {
+					T m0 = m[((0 * 4 + b) * block + t) * f + o];
+					T m1 = m[((1 * 4 + b) * block + t) * f + o];
+					T m2 = m[((2 * 4 + b) * block + t) * f + o];
+					T m3 = m[((3 * 4 + b) * block + t) * f + o];
+					am[0][b] = m0 + m1 + m2;
+					am[1][b] = m1 - m2 - m3;
+				}
+				for (uint32_t a{ 0 }; a < rows; ++a) {
+					T y[2] = { am[a][0] + am[a][1] + am[a][2], am[a][1] - am[a][2] - am[a][3] };
+					for (uint32_t b{ 0 }; b < cols; ++b) {
+						r[((y0 + a) * out_w + x0 + b) * f + o] = y[b];
+					}
+				}
+			}
+		}
+	}
+}
+
+inline void fftConv2DGridSize(const Conv2DGeometry& g, uint32_t& grid_h, uint32_t& grid_w) {
+	// the grid holds the padded input without circular wrap into the outputs, stride and dilation 1
+	grid_h = FFT::fastSize(std::max(g.padding_top + g.h, g.out_h + g.filter_h - 1));
+	grid_w = FFT::fastSize(std::max(g.padding_left + g.w, g.out_w + g.filter_w - 1));
+}
+
+inline void fftFilterTransformKernel(const Conv2DGeometry& g, const RealFFT2D& fft, const float* weights, Complex* spectra) {
+	// weights (filter_h x filter_w x c x f), spectra (bins x c x f) conjugated and scaled by the inverse transform
+	// normalization, so a correlation is a product of spectra followed by an unnormalized inverse transform
+	const uint32_t grid_w = fft.getWidth();
+	const uint32_t bins = fft.getBinsCount();
+	const uint32_t cf = g.c * g.f;
+	const float scale = 1.0f / (static_cast<float>(fft.getHeight()) * grid_w);
+
+	std::vector<float> grid(fft.getHeight() * grid_w, 0.0f);
+	std::vector<Complex> spectrum(bins);
+
+	for (uint32_t idx{ 0 }; idx < cf; ++idx) {
+		for (uint32_t kh{ 0 }; kh < g.filter_h; ++kh) {
+			for (uint32_t kw{ 0 }; kw < g.filter_w; ++kw) {
+				grid[kh * grid_w + kw] = weights[(kh * g.filter_w + kw) * cf + idx];
+			}
+		}
+		fft.forward(grid.data(), spectrum.data(), 0, g.filter_h);
+		for (uint32_t b{ 0 }; b < bins; ++b) {
+			spectra[b * cf + idx] = std::conj(spectrum[b]) * scale;
+		}
+	}
+}
+
+inline void fftConv2DKernel(const Conv2DGeometry& g, const RealFFT2D& fft, const float* x, const Complex* spectra, float* r) {
+	// x (h x w x c), spectra from fftFilterTransformKernel, r (out_h x out_w x f) overwritten, stride and dilation 1,
+	// every channel is transformed once, every output channel is a sum of c spectra products per bin and one inverse
+	// transform, the padding is the zero part of the grid
+	const uint32_t c = g.c;
+	const uint32_t f = g.f;
+	const uint32_t grid_w = fft.getWidth();
+	const uint32_t bins = fft.getBinsCount();
+
+	std::vector<float> grid(fft.getHeight() * grid_w, 0.0f);
+	std::vector<Complex> spectrum(bins);
+	std::vector<Complex> x_spectra(bins * c);
+	std::vector<Complex> r_spectra(bins * f);
+
+	for (uint32_t ch{ 0 }; ch < c; ++ch) {
+		for (uint32_t i{ 0 }; i < g.h; ++i) {
+			float* grid_row = grid.data() + (g.padding_top + i) * grid_w + g.padding_left;
+			const float* x_row = x + i * g.w * c + ch;
+			for (uint32_t j{ 0 }; j < g.w; ++j) {
+				grid_row[j] = x_row[j * c];
+			}
+		}
+		fft.forward(grid.data(), spectrum.data(), g.padding_top, g.padding_top + g.h);
+		for (uint32_t b{ 0 }; b < bins; ++b) {
+			x_spectra[b * c + ch] = spectrum[b];
+		}
+	}
+
+	// complex products on real and imaginary parts, std::complex products check for infinities and do not vectorize
+	const float* xs = reinterpret_cast<const float*>(x_spectra.data());
+	const float* ws = reinterpret_cast<const float*>(spectra);
+	float* rs = reinterpret_cast<float*>(r_spectra.data());
+	std::fill(r_spectra.begin(), r_spectra.end(), Complex(0.0f, 0.0f));
+	for (uint32_t b{ 0 }; b < bins; ++b) {
+		float* r_bin = rs + 2 * b * f;
+		for (uint32_t ch{ 0 }; ch < c; ++ch) {
+			float x_re = xs[2 * (b * c + ch)];
+			float x_im = xs[2 * (b * c + ch) + 1];
+			const float* w_row = ws + 2 * (b * c + ch) * f;
+			for (uint32_t k{ 0 }; k < f; ++k) {
+				float w_re = w_row[2 * k];
+				float w_im = w_row[2 * k + 1];
+				r_bin[2 * k] += x_re * w_re - x_im * w_im;
+				r_bin[2 * k + 1] += x_re * w_im + x_im * w_re;
+			}
+		}
+	}
+
+	for (uint32_t k{ 0 }; k < f; ++k) {
+		for (uint32_t b{ 0 }; b < bins; ++b) {
+			spectrum[b] = r_spectra[b * f + k];
+		}
+		fft.inverse(spectrum.data(), grid.data(), g.out_h);
+		for (uint32_t i{ 0 }; i < g.out_h; ++i) {
+			const float* grid_row = grid.data() + i * grid_w;
+			float* r_row = r + i * g.out_w * f + k;
+			for (uint32_t j{ 0 }; j < g.out_w; ++j) {
+				r_row[j * f] = grid_row[j];
+			}
+		}
+	}
+}
+
+template <typename T, uint32_t P>
+inline void maxPool2DKernel(uint32_t n, uint32_t h, uint32_t w, uint32_t c, uint32_t pool_size, const T* x, T* r) {
+	// x (n x h x w x c), r (n x h/p x w/p x c)
+	const uint32_t p = P ? P : pool_size;
+	const uint32_t out_h = h / p;
+	const uint32_t out_w = w / p;
+
+	for (uint32_t b{ 0 }; b < n; ++b) {
+		for (uint32_t i{ 0 }; i < out_h; ++i) {
+			for (uint32_t j{ 0 }; j < out_w; ++j) {
+				T* out = r + ((b * out_h + i) * out_w + j) * c;
+				const T* window = x + ((b * h + i * p) * w + j * p) * c;
+				std::copy(window, window + c, out);
+				for (uint32_t ph{ 0 }; ph < p; ++ph) {
+					for (uint32_t pw{ 0 }; pw < p; ++pw) {
+						const T* pixel = window + (ph * w + pw) * c;
+						for (uint32_t ch{ 0 }; ch < c; ++ch) {
+							out[ch] = pixel[ch] > out[ch] ? pixel[ch] : out[ch];
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+template <typename T, uint32_t P>
+inline void averagePool2DKernel(uint32_t n, uint32_t h, uint32_t w, uint32_t c, uint32_t pool_size, const T* x, T* r) {
+	// x (n x h x w x c), r (n x h/p x w/p x c)
+	const uint32_t p = P ? P : pool_size;
+	const uint32_t out_h = h / p;
+	const uint32_t out_w = w / p;
+	const T scale = static_cast<T>(1) / static_cast<T>(p * p);
+
+	for (uint32_t b{ 0 }; b < n; ++b) {
+		for (uint32_t i{ 0 }; i < out_h; ++i) {
+			for (uint32_t j{ 0 }; j < out_w; ++j) {
+				T* out = r + ((b * out_h + i) * out_w + j) * c;
+				const T* window = x + ((b * h + i * p) * w + j * p) * c;
+				std::fill(out, out + c, static_cast<T>(0));
+				for (uint32_t ph{ 0 }; ph < p; ++ph) {
+					for (uint32_t pw{ 0 }; pw < p; ++pw) {
+						const T* pixel = window + (ph * w + pw) * c;
+						for (uint32_t ch{ 0 }; ch < c; ++ch) {
+							out[ch] += pixel[ch];
+						}
+					}
+				}
+				for (uint32_t ch{ 0 }; ch < c; ++ch) {
+					out[ch] *= scale;
+				}
+			}
+		}
+	}
+}
+
+template <typename T, uint32_t P>
+inline void maxPool2DBackwardKernel(uint32_t n, uint32_t h, uint32_t w, uint32_t c, uint32_t pool_size, const T* x, const T* dx, T* r) {
+	// gradient of each window goes to its maximal values, split equally between them
+	const uint32_t p = P ? P : pool_size;
+	const uint32_t out_h = h / p;
+	const uint32_t out_w = w / p;
+	std::vector<T> max_values(c);
+	std::vector<T> counts(c);
+
+	for (uint32_t b{ 0 }; b < n; ++b) {
+		for (uint32_t i{ 0 }; i < out_h; ++i) {
+			for (uint32_t j{ 0 }; j < out_w; ++j) {
+				const T* d = dx + ((b * out_h + i) * out_w + j) * c;
+				const uint32_t window_offset = ((b * h + i * p) * w + j * p) * c;
+				std::copy(x + window_offset, x + window_offset + c, max_values.begin());
+				std::fill(counts.begin(), counts.end(), static_cast<T>(0));
+				for (uint32_t ph{ 0 }; ph < p; ++ph) {
+					for (uint32_t pw{ 0 }; pw < p; ++pw) {
+						const T* pixel = x + window_offset + (ph * w + pw) * c;
+						for (uint32_t ch{ 0 }; ch < c; ++ch) {
+							max_values[ch] = pixel[ch] > max_values[ch] ? pixel[ch] : max_values[ch];
+						}
+					}
+				}
+				for (uint32_t ph{ 0 }; ph < p; ++ph) {
+					for (uint32_t pw{ 0 }; pw < p; ++pw) {
+						const T* pixel = x + window_offset + (ph * w + pw) * c;
+						for (uint32_t ch{ 0 }; ch < c; ++ch) {
+							counts[ch] += pixel[ch] == max_values[ch] ? static_cast<T>(1) : static_cast<T>(0);
+						}
+					}
+				}
+				for (uint32_t ph{ 0 }; ph < p; ++ph) {
+					for (uint32_t pw{ 0 }; pw < p; ++pw) {
+						const T* pixel = x + window_offset + (ph * w + pw) * c;
+						T* out = r + window_offset + (ph * w + pw) * c;
+						for (uint32_t ch{ 0 }; ch < c; ++ch) {
+							out[ch] = pixel[ch] == max_values[ch] ? d[ch] / counts[ch] : static_cast<T>(0);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+template <typename T, uint32_t P>
+inline void averagePool2DBackwardKernel(uint32_t n, uint32_t h, uint32_t w, uint32_t c, uint32_t pool_size, const T* x, const T* dx, T* r) {
+	// gradient of each window is split proportionally to input values
+	const uint32_t p = P ? P : pool_size;
+	const uint32_t out_h = h / p;
+	const uint32_t out_w = w / p;
+	const T scale = static_cast<T>(1) / static_cast<T>(p * p);
+	std::vector<T> averages(c);
+
+	for (uint32_t b{ 0 }; b < n; ++b) {
+		for (uint32_t i{ 0 }; i < out_h; ++i) {
+			for (uint32_t j{ 0 }; j < out_w; ++j) {
+				const T* d = dx + ((b * out_h + i) * out_w + j) * c;
+				const uint32_t window_offset = ((b * h + i * p) * w + j * p) * c;
+				std::fill(averages.begin(), averages.end(), static_cast<T>(0));
+				for (uint32_t ph{ 0 }; ph < p; ++ph) {
+					for (uint32_t pw{ 0 }; pw < p; ++pw) {
+						const T* pixel = x + window_offset + (ph * w + pw) * c;
+						for (uint32_t ch{ 0 }; ch < c; ++ch) {
+							averages[ch] += pixel[ch];
+						}
+					}
+				}
+				for (uint32_t ch{ 0 }; ch < c; ++ch) {
+					averages[ch] *= scale;
+				}
+				for (uint32_t ph{ 0 }; ph < p; ++ph) {
+					for (uint32_t pw{ 0 }; pw < p; ++pw) {
+						const T* pixel = x + window_offset + (ph * w + pw) * c;
+						T* out = r + window_offset + (ph * w + pw) * c;
+						for (uint32_t ch{ 0 }; ch < c; ++ch) {
+							out[ch] = pixel[ch] / averages[ch] * d[ch];
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+template <typename T>
+inline void channelMomentsKernel(uint32_t n, uint32_t c, const T* x, T* mean, T* variance) {
+	// mean and variance (c) of x (n x c) in a single pass, the inner loop runs over contiguous channels,
+	// values are shifted by the first row so the sum of squares does not cancel out
+	std::fill(mean, mean + c, static_cast<T>(0));
+	std::fill(variance, variance + c, static_cast<T>(0));
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		const T* row = x + i * c;
+		for (uint32_t ch{ 0 }; ch < c; ++ch) {
+			T d = row[ch] - x[ch];
+			mean[ch] += d;
+			variance[ch] += d * d;
+		}
+	}
+	for (uint32_t ch{ 0 }; ch < c; ++ch) {
+		T m = mean[ch] / n;
+		mean[ch] = x[ch] + m;
+		variance[ch] = std::max(variance[ch] / n - m * m, static_cast<T>(0));
+	}
+}
+
+template <typename T>
+inline void channelScaleShiftKernel(uint32_t n, uint32_t c, const T* x, const T* scale, const T* shift, T* r) {
+	// r (n x c) = x * scale (c) + shift (c), r may be x
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		const T* row = x + i * c;
+		T* out = r + i * c;
+		for (uint32_t ch{ 0 }; ch < c; ++ch) {
+			out[ch] = row[ch] * scale[ch] + shift[ch];
+		}
+	}
+}
+
+template <typename T>
+inline void batchNormBackwardKernel(uint32_t n, uint32_t c, const T* x, const T* dy, const T* mean, const T* inv_std,
+									const T* gamma, T* dx, T* gamma_d, T* beta_d) {
+	// dx = gamma * inv_std * (dy - mean(dy) - x_hat * mean(dy * x_hat)), gamma and beta gradients are accumulated
+	std::vector<T> sum_dy(c, static_cast<T>(0));
+	std::vector<T> sum_dy_x_hat(c, static_cast<T>(0));
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		const T* row = x + i * c;
+		const T* d = dy + i * c;
+		for (uint32_t ch{ 0 }; ch < c; ++ch) {
+			sum_dy[ch] += d[ch];
+			sum_dy_x_hat[ch] += d[ch] * (row[ch] - mean[ch]) * inv_std[ch];
+		}
+	}
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		const T* row = x + i * c;
+		const T* d = dy + i * c;
+		T* out = dx + i * c;
+		for (uint32_t ch{ 0 }; ch < c; ++ch) {
+			T x_hat = (row[ch] - mean[ch]) * inv_std[ch];
+			out[ch] = gamma[ch] * inv_std[ch] * (d[ch] - (sum_dy[ch] + x_hat * sum_dy_x_hat[ch]) / n);
+		}
+	}
+	for (uint32_t ch{ 0 }; ch < c; ++ch) {
+		gamma_d[ch] += sum_dy_x_hat[ch];
+		beta_d[ch] += sum_dy[ch];
+	}
+}
+
+// stateless random value of a counter, counters are hashed independently so loops over them vectorize
+inline uint32_t counterRandom(uint32_t key, uint32_t counter) {
+	uint32_t x = counter * 0x9e3779b9u + key;
+	x ^= x >> 16;
+	x *= 0x7feb352du;
+	x ^= x >> 15;
+	x *= 0x846ca68bu;
+	x ^= x >> 16;
+	return x;
+}
+
+#define DROPOUT_MASK_BLOCK_SIZE (256u)
+
+inline void dropoutMaskKernel(uint32_t n, uint32_t key, uint32_t threshold, uint32_t* mask, uint32_t offset = 0) {
+	// bit i of the mask keeps value offset + i, random values below threshold are dropped,
+	// a block of random values is drawn in one vectorized loop before its bits are packed
+	uint32_t keep[DROPOUT_MASK_BLOCK_SIZE];
+	for (uint32_t start{ 0 }; start < n; start += DROPOUT_MASK_BLOCK_SIZE) {
+		for (uint32_t i{ 0 }; i < DROPOUT_MASK_BLOCK_SIZE; ++i) {
+			keep[i] = (counterRandom(key, offset + start + i) >= threshold) ? ~0u : 0u;
+		}
+		uint32_t words = std::min(DROPOUT_MASK_BLOCK_SIZE, n - start + 31) / 32;
+		for (uint32_t w{ 0 }; w < words; ++w) {
+			uint32_t bits{ 0 };
+			for (uint32_t b{ 0 }; b < 32; ++b) {
+				bits |= keep[w * 32 + b] & (1u << b);
+			}
+			mask[start / 32 + w] = bits;
+		}
+	}
+}
+
+template <typename T>
+inline void dropoutKernel(uint32_t n, const uint32_t* mask, T scale, const T* x, T* r) {
+	// r = x * mask * scale, r may be x, every 4 bits of the mask select a row of multipliers
+	// so the mask is applied without branches
+	T multipliers[16][4];
+	for (uint32_t v{ 0 }; v < 16; ++v) {
+		for (uint32_t b{ 0 }; b < 4; ++b) {
+			multipliers[v][b] = ((v >> b) & 1u) ? scale : static_cast<T>(0);
+		}
+	}
+	for (uint32_t i{ 0 }; i < n / 4 * 4; i += 4) {
+		const T* m = multipliers[(mask[i / 32] >> (i % 32)) & 15u];
+		for (uint32_t b{ 0 }; b < 4; ++b) {
+			r[i + b] = x[i + b] * m[b];
+		}
+	}
+	for (uint32_t i{ n / 4 * 4 }; i < n; ++i) {
+		r[i] = x[i] * multipliers[(mask[i / 32] >> (i % 32)) & 1u][0];
+	}
+}
+
+template <typename T>
+inline void dropoutInPlaceKernel(uint32_t n, uint32_t key, uint32_t threshold, T scale, T* x) {
+	// mask bits of a block are drawn right before they are applied, no mask is kept between passes
+	uint32_t mask[DROPOUT_MASK_BLOCK_SIZE / 32];
+	for (uint32_t start{ 0 }; start < n; start += DROPOUT_MASK_BLOCK_SIZE) {
+		uint32_t count = std::min(DROPOUT_MASK_BLOCK_SIZE, n - start);
+		dropoutMaskKernel(count, key, threshold, mask, start);
+		dropoutKernel<T>(count, mask, scale, x + start, x + start);
+	}
+}
+
+}	// namespace kernels
\ No newline at end of file
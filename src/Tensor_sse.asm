@@ -24,6 +24,8 @@ global _SSE_tensor_last_axis_sum
 
 global _SSE_tensor_dot_product_transpose
 
+global _SSE_tensor_transpose_block
+
 section .data
 
 section .text
@@ -1329,4 +1331,98 @@ _SSE_tensor_dot_product_transpose:
 	pop 	edi
 	pop		ebp
 
+	ret
+
+; void SSE_tensor_transpose_block(const uint32_t n, const uint32_t m, const uint32_t v_stride, const uint32_t r_stride, const float* v, float* r);
+;	n - rows of the block (multiple of 4)
+;	m - columns of the block (multiple of 4)
+;	v_stride - row length of the tensor containing v
+;	r_stride - row length of the tensor containing r
+;	v - source block
+;	r - result block (r[j,i] = v[i,j]), transposed in 4x4 tiles
+_SSE_tensor_transpose_block:
+	push	ebp
+	push	edi
+	push	esi
+	push	ebx
+
+	mov		ebp, esp
+
+	mov		ecx, [ebp+20]		; n		uint32
+	;			 [ebp+24]		; m		uint32
+	mov		ebx, [ebp+28]		; v_stride	uint32
+	shl		ebx, 2				; v row size in bytes
+	mov		edx, [ebp+32]		; r_stride	uint32
+	shl		edx, 2				; r row size in bytes
+	mov		eax, [ebp+36]		; v		float* (array)
+	mov		edi, [ebp+40]		; r		float* (array)
+
+.row_loop:
+	cmp		ecx, 4
+	jl		.end
+
+	sub		ecx, 4
+
+	push	ecx
+	push	eax
+	push	edi
+
+	mov		ecx, [ebp+24]		; m
+
+.col_loop:
+	cmp		ecx, 4
+	jl		.col_end
+
+	sub		ecx, 4
+
+	movups	xmm0, [eax]			; a0 a1 a2 a3
+	movups	xmm1, [eax + ebx]	; b0 b1 b2 b3
+	lea		esi, [eax + 2*ebx]
+	movups	xmm2, [esi]			; c0 c1 c2 c3
+	movups	xmm3, [esi + ebx]	; d0 d1 d2 d3
+
+	movaps	xmm4, xmm0
+	unpcklps	xmm4, xmm1		; a0 b0 a1 b1
+	unpckhps	xmm0, xmm1		; a2 b2 a3 b3
+	movaps	xmm5, xmm2
+	unpcklps	xmm5, xmm3		; c0 d0 c1 d1
+	unpckhps	xmm2, xmm3		; c2 d2 c3 d3
+
+	movaps	xmm1, xmm4
+	movlhps	xmm4, xmm5			; a0 b0 c0 d0
+	movhlps	xmm5, xmm1			; a1 b1 c1 d1
+	movaps	xmm3, xmm0
+	movlhps	xmm0, xmm2			; a2 b2 c2 d2
+	movhlps	xmm2, xmm3			; a3 b3 c3 d3
+
+	movups	[edi], xmm4
+	movups	[edi + edx], xmm5
+	lea		esi, [edi + 2*edx]
+	movups	[esi], xmm0
+	movups	[esi + edx], xmm2
+
+	add		eax, 16				; next 4 columns of v
+	lea		edi, [edi + 4*edx]	; next 4 rows of r
+
+	jmp		.col_loop
+
+.col_end:
+	pop		edi
+	pop		eax
+	pop		ecx
+
+	lea		eax, [eax + 4*ebx]	; next 4 rows of v
+	add		edi, 16				; next 4 columns of r
+
+	jmp		.row_loop
+
+.end:
+
+	mov     esp, ebp
+
+	pop		ebx
+	pop		esi
+	pop 	edi
+	pop		ebp
+
 	ret
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "ThreadPool.h"
+
+static thread_local bool t_in_parallel_region{ false };
+
+ThreadPool::ThreadPool(uint32_t threads_count) {
+	startWorkers(threads_count);
+}
+
+ThreadPool::~ThreadPool() {
+	stopWorkers();
+}
+
+uint32_t ThreadPool::getThreadsCount() const {
+	// workers and the calling thread
+	return _workers.size() + 1;
+}
+
+void ThreadPool::setThreadsCount(uint32_t threads_count) {
+	std::lock_guard<std::mutex> call_lock(_call_mutex);
+
+	stopWorkers();
+	startWorkers(threads_count);
+}
+
+void ThreadPool::parallelFor(uint32_t begin, uint32_t end, uint32_t min_chunk, const std::function<void(uint32_t, uint32_t)>& function) {
+	if (begin >= end) {
+		return;
+	}
+
+	uint32_t n = end - begin;
+	uint32_t chunks_count = std::min(getThreadsCount(), (n + min_chunk - 1) / std::max(min_chunk, 1u));
+
+	if ((chunks_count <= 1) || t_in_parallel_region) {
+		function(begin, end);
+		return;
+	}
+
+	// other thread is already using workers, do the work inline
+	std::unique_lock<std::mutex> call_lock(_call_mutex, std::try_to_lock);
+	if (!call_lock.owns_lock()) {
+		function(begin, end);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_function = &function;
+		_begin = begin;
+		_end = end;
+		_chunk = (n + chunks_count - 1) / chunks_count;
+		_chunks_count = (n + _chunk - 1) / _chunk;
+		_next_chunk = 0;
+		_done_chunks = 0;
+		++_generation;
+	}
+	_work_cv.notify_all();
+
+	t_in_parallel_region = true;
+	runChunks();
+	t_in_parallel_region = false;
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	_done_cv.wait(lock, [this] { return (_done_chunks == _chunks_count) && (0 == _active_workers); });
+	_function = nullptr;
+}
+
+ThreadPool& ThreadPool::getDefault() {
+	static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 1u));
+	return pool;
+}
+
+void ThreadPool::startWorkers(uint32_t threads_count) {
+	_stop = false;
+	for (uint32_t i{ 1 }; i < threads_count; ++i) {
+		_workers.emplace_back(&ThreadPool::workerLoop, this);
+	}
+}
+
+void ThreadPool::stopWorkers() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_work_cv.notify_all();
+
+	for (auto& worker : _workers) {
+		worker.join();
+	}
+	_workers.clear();
+}
+
+void ThreadPool::workerLoop() {
+	uint64_t generation{ 0 };
+	t_in_parallel_region = true;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_work_cv.wait(lock, [this, generation] { return _stop || (_generation != generation); });
+			if (_stop) {
+				return;
+			}
+			generation = _generation;
+			if (nullptr == _function) {
+				continue;
+			}
+			++_active_workers;
+		}
+
+		runChunks();
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			--_active_workers;
+		}
+		_done_cv.notify_all();
+	}
+}
+
+void ThreadPool::runChunks() {
+	uint32_t done{ 0 };
+
+	for (uint32_t c = _next_chunk++; c < _chunks_count; c = _next_chunk++) {
+		uint32_t chunk_begin = _begin + c * _chunk;
+		uint32_t chunk_end = std::min(chunk_begin + _chunk, _end);
+		(*_function)(chunk_begin, chunk_end);
+		++done;
+	}
+
+	if (done > 0) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_done_chunks += done;
+	}
+	_done_cv.notify_all();
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+// Persistent worker threads used to split outer loops of tensor kernels.
+// The calling thread takes part in the work, nested calls run inline.
+class ThreadPool {
+public:
+	explicit ThreadPool(uint32_t threads_count);
+	~ThreadPool();
+
+	uint32_t getThreadsCount() const;
+	void setThreadsCount(uint32_t threads_count);
+	void parallelFor(uint32_t begin, uint32_t end, uint32_t min_chunk, const std::function<void(uint32_t, uint32_t)>& function);
+
+	static ThreadPool& getDefault();
+
+private:
+	std::vector<std::thread> _workers;
+	std::mutex _mutex;
+	std::mutex _call_mutex;
+	std::condition_variable _work_cv;
+	std::condition_variable _done_cv;
+
+	const std::function<void(uint32_t, uint32_t)>* _function{ nullptr };
+	uint32_t _begin{ 0 };
+	uint32_t _end{ 0 };
+	uint32_t _chunk{ 1 };
+	uint32_t _chunks_count{ 0 };
+	std::atomic<uint32_t> _next_chunk{ 0 };
+	uint32_t _done_chunks{ 0 };
+	uint32_t _active_workers{ 0 };
+	uint64_t _generation{ 0 };
+	bool _stop{ false };
+
+	void startWorkers(uint32_t threads_count);
+	void stopWorkers();
+	void workerLoop();
+	void runChunks();
+};
\ No newline at end of file
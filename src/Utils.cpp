@@ -3,6 +3,10 @@
 double g_time{ 0.0 };
 
 uint32_t* genPermutation(uint32_t n) {
+	return genPermutation(n, static_cast<uint32_t>(time(NULL)));
+}
+
+uint32_t* genPermutation(uint32_t n, uint32_t seed) {
 	uint32_t i = 0;
 	uint32_t j = 0;
 	uint32_t tmp;
@@ -15,7 +19,7 @@ uint32_t* genPermutation(uint32_t n) {
 		result[i] = i;
 	}
 
-	srand(time(NULL));
+	srand(seed);
 
 	inversionsCount = 2 * n + rand() % n;
 
@@ -47,5 +51,5 @@ float randUniform(float a, float b) {
 }
 
 double perf_counter_ns() {
-	return (long double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	return (long double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 }
\ No newline at end of file
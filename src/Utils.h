@@ -11,6 +11,7 @@ extern double g_time;
 #define LOG_TIME {printf("%s - %d : %.6f\n", __FILE__, __LINE__, perf_counter_ns() - g_time); g_time = perf_counter_ns(); }
 
 uint32_t* genPermutation(uint32_t n);
+uint32_t* genPermutation(uint32_t n, uint32_t seed);
 float randNormalDistribution();
 float randUniform(float a=0, float b=1);
 double perf_counter_ns();
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "HardwareCounters.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+    #include <unistd.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <linux/perf_event.h>
+#endif
+
+#ifdef __linux__
+struct EventConfig {
+    uint32_t type;
+    uint64_t config;
+};
+
+// FP_ARITH_INST_RETIRED is event 0xC7, umask selects scalar / packed single precision
+static const EventConfig EVENT_CONFIGS[] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_RAW, 0x02C7 },
+    { PERF_TYPE_RAW, 0x08C7 },
+    { PERF_TYPE_RAW, 0x20C7 },
+    { PERF_TYPE_RAW, 0x80C7 },
+};
+
+static bool isIntelCpu() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_cpu_is("intel");
+#else
+    return false;
+#endif
+}
+
+static int openEvent(const EventConfig& event_config) {
+    // raw event codes are only meaningful on Intel
+    if ((PERF_TYPE_RAW == event_config.type) && !isIntelCpu()) {
+        return -1;
+    }
+
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event_config.type;
+    attr.config = event_config.config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // calling thread on any CPU
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+}
+#endif
+
+HardwareCounters::HardwareCounters() {
+    for (uint32_t i = 0; i < EVENTS_COUNT; ++i) {
+#ifdef __linux__
+        _fds[i] = openEvent(EVENT_CONFIGS[i]);
+#else
+        _fds[i] = -1;
+#endif
+        _values[i] = 0.0;
+    }
+}
+
+HardwareCounters::~HardwareCounters() {
+#ifdef __linux__
+    for (uint32_t i = 0; i < EVENTS_COUNT; ++i) {
+        if (_fds[i] >= 0) {
+            close(_fds[i]);
+        }
+    }
+#endif
+}
+
+bool HardwareCounters::isOpened(HardwareEvent event) const {
+    return _fds[static_cast<uint32_t>(event)] >= 0;
+}
+
+void HardwareCounters::start() {
+#ifdef __linux__
+    for (uint32_t i = 0; i < EVENTS_COUNT; ++i) {
+        if (_fds[i] >= 0) {
+            ioctl(_fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+void HardwareCounters::stop() {
+#ifdef __linux__
+    for (uint32_t i = 0; i < EVENTS_COUNT; ++i) {
+        if (_fds[i] >= 0) {
+            ioctl(_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    for (uint32_t i = 0; i < EVENTS_COUNT; ++i) {
+        // value, time enabled, time running
+        uint64_t data[3] = { 0, 0, 0 };
+        _values[i] = 0.0;
+        if ((_fds[i] >= 0) && (read(_fds[i], data, sizeof(data)) == sizeof(data)) && (data[2] > 0)) {
+            _values[i] = static_cast<double>(data[0]) * data[1] / data[2];
+        }
+    }
+#endif
+}
+
+double HardwareCounters::getValue(HardwareEvent event) const {
+    return _values[static_cast<uint32_t>(event)];
+}
+
+bool HardwareCounters::isEnabled() {
+    static const bool enabled = [] {
+        const char* value = getenv("NN_PERF_COUNTERS");
+        return (value != nullptr) && (strcmp(value, "1") == 0);
+    }();
+    return enabled;
+}
+
+double HardwareCounters::getPeakGflops() {
+    static const double peak = [] {
+        const char* value = getenv("NN_PEAK_GFLOPS");
+        return (value != nullptr) ? atof(value) : 0.0;
+    }();
+    return peak;
+}
+
+HardwareCountersScope::HardwareCountersScope(benchmark::State& state) : _state(state) {
+    if (!HardwareCounters::isEnabled()) {
+        return;
+    }
+
+    _counters.reset(new HardwareCounters());
+    if (!_counters->isOpened(HardwareEvent::Cycles)) {
+        static bool warned = false;
+        if (!warned) {
+            printf("hardware counters are not available: perf_event_open failed, check /proc/sys/kernel/perf_event_paranoid\n");
+            warned = true;
+        }
+        _counters.reset();
+        return;
+    }
+
+    _start = std::chrono::steady_clock::now();
+    _counters->start();
+}
+
+HardwareCountersScope::~HardwareCountersScope() {
+    if (!_counters) {
+        return;
+    }
+
+    _counters->stop();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+
+    double cycles = _counters->getValue(HardwareEvent::Cycles);
+    double instructions = _counters->getValue(HardwareEvent::Instructions);
+
+    _state.counters["cycles"] = benchmark::Counter(cycles, benchmark::Counter::kAvgIterations);
+    _state.counters["instructions"] = benchmark::Counter(instructions, benchmark::Counter::kAvgIterations);
+    // ratios are computed per thread, averaged over threads
+    _state.counters["IPC"] = benchmark::Counter(cycles > 0.0 ? instructions / cycles : 0.0, benchmark::Counter::kAvgThreads);
+
+    if (_counters->isOpened(HardwareEvent::L1DMisses)) {
+        _state.counters["L1D_misses"] = benchmark::Counter(_counters->getValue(HardwareEvent::L1DMisses), benchmark::Counter::kAvgIterations);
+    }
+    if (_counters->isOpened(HardwareEvent::LLCMisses)) {
+        _state.counters["LLC_misses"] = benchmark::Counter(_counters->getValue(HardwareEvent::LLCMisses), benchmark::Counter::kAvgIterations);
+    }
+
+    if (_counters->isOpened(HardwareEvent::FPScalar)) {
+        double scalar = _counters->getValue(HardwareEvent::FPScalar);
+        double packed_128 = _counters->getValue(HardwareEvent::FPPacked128);
+        double packed_256 = _counters->getValue(HardwareEvent::FPPacked256);
+        double packed_512 = _counters->getValue(HardwareEvent::FPPacked512);
+        double instructions_fp = scalar + packed_128 + packed_256 + packed_512;
+        double flops = scalar + 4.0 * packed_128 + 8.0 * packed_256 + 16.0 * packed_512;
+
+        _state.counters["hw_GFLOP"] = benchmark::Counter(flops * 1e-9, benchmark::Counter::kIsRate);
+        _state.counters["vectorized"] = benchmark::Counter(instructions_fp > 0.0 ? (instructions_fp - scalar) / instructions_fp : 0.0, benchmark::Counter::kAvgThreads);
+
+        double peak = HardwareCounters::getPeakGflops();
+        if ((peak > 0.0) && (seconds > 0.0)) {
+            // threads add up to the achieved machine throughput
+            _state.counters["peak_pct"] = benchmark::Counter(100.0 * flops * 1e-9 / seconds / peak);
+        }
+    }
+}
\ No newline at end of file
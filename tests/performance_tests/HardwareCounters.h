@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <benchmark/benchmark.h>
+
+enum class HardwareEvent : uint8_t {
+    Cycles,
+    Instructions,
+    L1DMisses,
+    LLCMisses,
+    FPScalar,
+    FPPacked128,
+    FPPacked256,
+    FPPacked512,
+    Count
+};
+
+// Counters of the calling thread read with Linux perf_event_open, thread pool workers are not included.
+// FP events are Intel FP_ARITH_INST_RETIRED (single precision), events the CPU
+// or kernel does not allow stay closed and are not reported.
+class HardwareCounters {
+public:
+    HardwareCounters();
+    ~HardwareCounters();
+
+    HardwareCounters(const HardwareCounters&) = delete;
+    HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+    bool isOpened(HardwareEvent event) const;
+    void start();
+    void stop();
+    // value scaled by enabled / running time when events were multiplexed
+    double getValue(HardwareEvent event) const;
+
+    // counters are read only when NN_PERF_COUNTERS=1 is set
+    static bool isEnabled();
+    // machine peak from NN_PEAK_GFLOPS, 0 when unknown
+    static double getPeakGflops();
+
+private:
+    static constexpr uint32_t EVENTS_COUNT = static_cast<uint32_t>(HardwareEvent::Count);
+
+    int _fds[EVENTS_COUNT];
+    double _values[EVENTS_COUNT];
+};
+
+// Measures hardware counters until destroyed and reports them as benchmark counters:
+// per iteration cycles, instructions and cache misses, IPC, fp32 GFLOP/s counted by
+// the CPU, share of packed FP instructions and percent of NN_PEAK_GFLOPS.
+class HardwareCountersScope {
+public:
+    explicit HardwareCountersScope(benchmark::State& state);
+    ~HardwareCountersScope();
+
+private:
+    benchmark::State& _state;
+    std::unique_ptr<HardwareCounters> _counters;
+    std::chrono::steady_clock::time_point _start;
+};
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "src/ThreadPool.h"
+#include "src/MemoryTracker.h"
+#include "tests/performance_tests/HardwareCounters.h"
+
+#define FLOAT_BYTES (static_cast<double>(sizeof(float)))
+
+// Reports work done per iteration as rates: items/s, bytes/s and GFLOP/s.
+inline void setCounters(benchmark::State& state, double items, double bytes, double flops) {
+    state.SetItemsProcessed(static_cast<int64_t>(items * state.iterations()));
+    state.SetBytesProcessed(static_cast<int64_t>(bytes * state.iterations()));
+    state.counters["GFLOP"] = benchmark::Counter(flops * 1e-9 * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+// Resizes the default thread pool for one benchmark run and restores it afterwards.
+class ThreadsCountScope {
+public:
+    explicit ThreadsCountScope(uint32_t threads_count) : _threads_count(ThreadPool::getDefault().getThreadsCount()) {
+        ThreadPool::getDefault().setThreadsCount(threads_count);
+    }
+
+    ~ThreadsCountScope() {
+        ThreadPool::getDefault().setThreadsCount(_threads_count);
+    }
+
+private:
+    uint32_t _threads_count;
+};
+
+// Tracks tensor allocations until destroyed and reports them per iteration, peak is in bytes above the starting point.
+class MemoryCountersScope {
+public:
+    explicit MemoryCountersScope(benchmark::State& state) : _state(state) {
+        MemoryTracker::reset();
+        MemoryTracker::setEnabled(true);
+    }
+
+    ~MemoryCountersScope() {
+        MemoryStats stats = MemoryTracker::getStats();
+        MemoryTracker::setEnabled(false);
+
+        _state.counters["peak_bytes"] = benchmark::Counter(static_cast<double>(stats.peak_bytes), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+        _state.counters["alloc_bytes"] = benchmark::Counter(static_cast<double>(stats.allocated_bytes), benchmark::Counter::kAvgIterations, benchmark::Counter::kIs1024);
+        _state.counters["allocs"] = benchmark::Counter(static_cast<double>(stats.allocations_count), benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    benchmark::State& _state;
+};
+
+static const std::vector<int64_t> THREADS_COUNTS = { 1, 2, 4, 8 };
\ No newline at end of file
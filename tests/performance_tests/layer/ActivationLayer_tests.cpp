@@ -3,67 +3,70 @@
 #include "src/ActivationLayer.h"
 #include "src/Tensor.h"
 #include "src/Utils.h"
+#include "tests/performance_tests/PerformanceTestsUtils.h"
 
-constexpr uint32_t N = 100;
-constexpr uint32_t M = 100;
-
-static void BM_ActivationLayerSigmoidForwardPropagation(benchmark::State& state) {
-    Tensor x = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
-    ActivationLayer layer = ActivationLayer({ M }, ActivationFun::Sigmoid);
+static void activationForwardBenchmark(benchmark::State& state, ActivationFun activation_fun) {
+    uint32_t batch = state.range(0);
+    uint32_t m = state.range(1);
+    Tensor x = Tensor({ batch, m }).applyFunction([](float) { return randNormalDistribution(); });
+    ActivationLayer layer = ActivationLayer({ m }, activation_fun);
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
         Tensor c = layer.forwardPropagation(x);
     }
+
+    double n = x.getSize();
+    setCounters(state, batch, 2.0 * n * FLOAT_BYTES, n);
 }
 
-static void BM_ActivationLayerSigmoidBackwardPropagation(benchmark::State& state) {
-    Tensor dx = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
-    ActivationLayer layer = ActivationLayer({ M }, ActivationFun::Sigmoid);
+static void activationBackwardBenchmark(benchmark::State& state, ActivationFun activation_fun) {
+    uint32_t batch = state.range(0);
+    uint32_t m = state.range(1);
+    Tensor x = Tensor({ batch, m }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor dx = Tensor({ batch, m }).applyFunction([](float) { return randNormalDistribution(); });
+    ActivationLayer layer = ActivationLayer({ m }, activation_fun);
 
+    layer.forwardPropagation(x);
+
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
         Tensor c = layer.backwardPropagation(dx);
     }
+
+    double n = x.getSize();
+    setCounters(state, batch, 3.0 * n * FLOAT_BYTES, 2.0 * n);
 }
 
-static void BM_ActivationLayerReLUForwardPropagation(benchmark::State& state) {
-    Tensor x = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
-    ActivationLayer layer = ActivationLayer({ M }, ActivationFun::ReLU);
+static void BM_ActivationLayerSigmoidForwardPropagation(benchmark::State& state) {
+    activationForwardBenchmark(state, ActivationFun::Sigmoid);
+}
 
-    for (auto _ : state) {
-        Tensor c = layer.forwardPropagation(x);
-    }
+static void BM_ActivationLayerSigmoidBackwardPropagation(benchmark::State& state) {
+    activationBackwardBenchmark(state, ActivationFun::Sigmoid);
 }
 
-static void BM_ActivationLayerReLUBackwardPropagation(benchmark::State& state) {
-    Tensor dx = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
-    ActivationLayer layer = ActivationLayer({ M }, ActivationFun::ReLU);
+static void BM_ActivationLayerReLUForwardPropagation(benchmark::State& state) {
+    activationForwardBenchmark(state, ActivationFun::ReLU);
+}
 
-    for (auto _ : state) {
-        Tensor c = layer.backwardPropagation(dx);
-    }
+static void BM_ActivationLayerReLUBackwardPropagation(benchmark::State& state) {
+    activationBackwardBenchmark(state, ActivationFun::ReLU);
 }
 
 static void BM_ActivationLayerLeakyReLUForwardPropagation(benchmark::State& state) {
-    Tensor x = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
-    ActivationLayer layer = ActivationLayer({ M }, ActivationFun::LeakyReLU);
-
-    for (auto _ : state) {
-        Tensor c = layer.forwardPropagation(x);
-    }
+    activationForwardBenchmark(state, ActivationFun::LeakyReLU);
 }
 
 static void BM_ActivationLayerLeakyReLUBackwardPropagation(benchmark::State& state) {
-    Tensor dx = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
-    ActivationLayer layer = ActivationLayer({ M }, ActivationFun::LeakyReLU);
-
-    for (auto _ : state) {
-        Tensor c = layer.backwardPropagation(dx);
-    }
+    activationBackwardBenchmark(state, ActivationFun::LeakyReLU);
 }
 
-BENCHMARK(BM_ActivationLayerSigmoidForwardPropagation);
-BENCHMARK(BM_ActivationLayerSigmoidBackwardPropagation);
-BENCHMARK(BM_ActivationLayerReLUForwardPropagation);
-BENCHMARK(BM_ActivationLayerReLUBackwardPropagation);
-BENCHMARK(BM_ActivationLayerLeakyReLUForwardPropagation);
-BENCHMARK(BM_ActivationLayerLeakyReLUBackwardPropagation);
\ No newline at end of file
+#define ACTIVATION_ARGS ArgsProduct({ { 1, 32, 256 }, { 128, 1024 } })->ArgNames({ "batch", "m" })
+
+BENCHMARK(BM_ActivationLayerSigmoidForwardPropagation)->ACTIVATION_ARGS;
+BENCHMARK(BM_ActivationLayerSigmoidBackwardPropagation)->ACTIVATION_ARGS;
+BENCHMARK(BM_ActivationLayerReLUForwardPropagation)->ACTIVATION_ARGS;
+BENCHMARK(BM_ActivationLayerReLUBackwardPropagation)->ACTIVATION_ARGS;
+BENCHMARK(BM_ActivationLayerLeakyReLUForwardPropagation)->ACTIVATION_ARGS;
+BENCHMARK(BM_ActivationLayerLeakyReLUBackwardPropagation)->ACTIVATION_ARGS;
\ No newline at end of file
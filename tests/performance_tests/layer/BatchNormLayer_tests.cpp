@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include "src/BatchNormLayer.h"
+#include "src/Conv2DLayer.h"
+#include "src/NeuralNetwork.h"
+#include "src/Tensor.h"
+#include "src/Utils.h"
+#include "tests/performance_tests/PerformanceTestsUtils.h"
+
+static void BM_BatchNormLayerForwardPropagation(benchmark::State& state) {
+    uint32_t batch = state.range(0);
+    uint32_t size = state.range(1);
+    uint32_t channels = state.range(2);
+    Tensor x = Tensor({ batch, size, size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    BatchNormLayer layer = BatchNormLayer({ size, size, channels });
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = layer.forwardPropagation(x);
+    }
+
+    // statistics pass and normalization pass
+    double values = double(batch) * size * size * channels;
+    setCounters(state, batch, 3.0 * values * FLOAT_BYTES, 5.0 * values);
+}
+
+static void BM_BatchNormLayerBackwardPropagation(benchmark::State& state) {
+    uint32_t batch = state.range(0);
+    uint32_t size = state.range(1);
+    uint32_t channels = state.range(2);
+    Tensor x = Tensor({ batch, size, size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor dx = Tensor({ batch, size, size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    BatchNormLayer layer = BatchNormLayer({ size, size, channels });
+
+    layer.initCachedGradient();
+    layer.forwardPropagation(x);
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = layer.backwardPropagation(dx);
+    }
+
+    double values = double(batch) * size * size * channels;
+    setCounters(state, batch, 5.0 * values * FLOAT_BYTES, 10.0 * values);
+}
+
+static void BM_Conv2DBatchNormInference(benchmark::State& state) {
+    bool folded = state.range(0);
+    uint32_t batch = state.range(1);
+    uint32_t size = state.range(2);
+    uint32_t channels = state.range(3);
+    Tensor x = Tensor({ batch, size, size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Conv2DLayer layer_1 = Conv2DLayer({ size, size, channels }, channels, 3);
+    BatchNormLayer layer_2 = BatchNormLayer(layer_1);
+    NeuralNetwork nn = NeuralNetwork(layer_1, layer_2, CostFun::BinaryCrossentropy);
+    nn.setLayersFusion(folded);
+    ExecutionContext context;
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        const Tensor& c = nn.predict(x, context);
+        benchmark::DoNotOptimize(c.getDataPtr());
+    }
+
+    state.SetLabel(folded ? "folded" : "separate");
+    double values = double(batch) * size * size * channels;
+    setCounters(state, batch, 2.0 * values * FLOAT_BYTES, 2.0 * values * 9 * channels);
+}
+
+#define BATCH_NORM_ARGS_NAMES ArgNames({ "batch", "size", "channels" })
+
+BENCHMARK(BM_BatchNormLayerForwardPropagation)->ArgsProduct({ { 1, 10 }, { 16, 32 }, { 16, 64 } })->BATCH_NORM_ARGS_NAMES;
+BENCHMARK(BM_BatchNormLayerBackwardPropagation)->ArgsProduct({ { 1, 10 }, { 16, 32 }, { 16, 64 } })->BATCH_NORM_ARGS_NAMES;
+BENCHMARK(BM_Conv2DBatchNormInference)->ArgsProduct({ { 0, 1 }, { 10 }, { 32 }, { 16 } })->ArgNames({ "folded", "batch", "size", "channels" });
\ No newline at end of file
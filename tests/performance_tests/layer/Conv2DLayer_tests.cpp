@@ -3,31 +3,119 @@
 #include "src/Conv2DLayer.h"
 #include "src/Tensor.h"
 #include "src/Utils.h"
+#include "tests/performance_tests/PerformanceTestsUtils.h"
 
-constexpr uint32_t N = 10;
-constexpr uint32_t M = 32;
+static void conv2DLayerCounters(benchmark::State& state, uint32_t batch, uint32_t size, uint32_t channels, uint32_t filters, double convolutions_count=1.0) {
+    // direct convolution operations, so algorithms with fewer multiplications show higher rates
+    double pixels = double(batch) * size * size;
+    double bytes = (pixels * (channels + filters) + 9.0 * channels * filters) * FLOAT_BYTES;
+    setCounters(state, batch, bytes, convolutions_count * 2.0 * pixels * filters * 9.0 * channels);
+}
+
+static void conv2DLayerForwardBenchmark(benchmark::State& state, ConvAlgorithm algorithm) {
+    uint32_t batch = state.range(0);
+    uint32_t size = state.range(1);
+    uint32_t channels = state.range(2);
+    uint32_t filters = state.range(3);
+    Tensor x = Tensor({ batch, size, size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Conv2DLayer layer = Conv2DLayer({ size, size, channels }, filters, 3);
+    layer.setAlgorithm(algorithm);
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = layer.forwardPropagation(x);
+    }
+
+    conv2DLayerCounters(state, batch, size, channels, filters);
+}
 
 static void BM_Conv2DLayerForwardPropagation(benchmark::State& state) {
-    Tensor x = Tensor({ N, M, M, 3 }).applyFunction([](float) { return randNormalDistribution(); });
-    Conv2DLayer layer = Conv2DLayer({ M, M, 3 }, 5, 3);
+    conv2DLayerForwardBenchmark(state, ConvAlgorithm::Auto);
+}
+
+static void BM_Conv2DLayerDirectForwardPropagation(benchmark::State& state) {
+    conv2DLayerForwardBenchmark(state, ConvAlgorithm::Direct);
+}
+
+static void BM_Conv2DLayerIm2colForwardPropagation(benchmark::State& state) {
+    conv2DLayerForwardBenchmark(state, ConvAlgorithm::Im2col);
+}
 
+static void BM_Conv2DLayerWinogradForwardPropagation(benchmark::State& state) {
+    conv2DLayerForwardBenchmark(state, ConvAlgorithm::Winograd);
+}
+
+static void BM_Conv2DLayerStridedForwardPropagation(benchmark::State& state) {
+    // stride 2 replaces a unit stride convolution followed by 2x2 subsampling
+    uint32_t batch = state.range(0);
+    uint32_t size = state.range(1);
+    uint32_t channels = state.range(2);
+    uint32_t filters = state.range(3);
+    Tensor x = Tensor({ batch, size, size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Conv2DLayer layer = Conv2DLayer({ size, size, channels }, filters, 3, { 2, 1, ConvPadding::Same });
+
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
         Tensor c = layer.forwardPropagation(x);
     }
+
+    // a quarter of the unit stride outputs
+    conv2DLayerCounters(state, batch, size, channels, filters, 0.25);
+}
+
+static void BM_Conv2DLayerFilterSizeForwardPropagation(benchmark::State& state) {
+    // direct, im2col and FFT against the filter size, shows where Auto should switch to FFT
+    ConvAlgorithm algorithm = static_cast<ConvAlgorithm>(state.range(0));
+    uint32_t size = state.range(1);
+    uint32_t filter_size = state.range(2);
+    uint32_t channels = 16;
+    uint32_t filters = 16;
+    Tensor x = Tensor({ 1, size, size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Conv2DLayer layer = Conv2DLayer({ size, size, channels }, filters, filter_size);
+    layer.setAlgorithm(algorithm);
+    state.SetLabel(ConvAlgorithm::FFT == layer.getAlgorithm() ? "fft" : (ConvAlgorithm::Im2col == layer.getAlgorithm() ? "im2col" : "direct"));
+
+    Tensor c;
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        layer.infer(x, c);
+    }
+
+    // direct convolution operations
+    double pixels = double(size) * size;
+    double bytes = (pixels * (channels + filters) + double(filter_size) * filter_size * channels * filters) * FLOAT_BYTES;
+    setCounters(state, 1, bytes, 2.0 * pixels * filters * filter_size * filter_size * channels);
 }
 
 static void BM_Conv2DLayerBackwardPropagation(benchmark::State& state) {
-    Tensor x = Tensor({ N, M, M, 3 }).applyFunction([](float) { return randNormalDistribution(); });
-    Tensor dx = Tensor({ N, M, M, 5 }).applyFunction([](float) { return randNormalDistribution(); });
-    Conv2DLayer layer = Conv2DLayer({ M, M, 3 }, 5, 3);
+    uint32_t batch = state.range(0);
+    uint32_t size = state.range(1);
+    uint32_t channels = state.range(2);
+    uint32_t filters = state.range(3);
+    Tensor x = Tensor({ batch, size, size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor dx = Tensor({ batch, size, size, filters }).applyFunction([](float) { return randNormalDistribution(); });
+    Conv2DLayer layer = Conv2DLayer({ size, size, channels }, filters, 3);
     
     layer.initCachedGradient();
     layer.forwardPropagation(x);
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
         Tensor c = layer.backwardPropagation(dx);
     }
+
+    // input gradient and weights gradient
+    conv2DLayerCounters(state, batch, size, channels, filters, 2.0);
 }
 
-BENCHMARK(BM_Conv2DLayerForwardPropagation);
-BENCHMARK(BM_Conv2DLayerBackwardPropagation);
\ No newline at end of file
+#define CONV2D_ARGS_NAMES ArgNames({ "batch", "size", "channels", "filters" })
+
+BENCHMARK(BM_Conv2DLayerForwardPropagation)->ArgsProduct({ { 1, 10 }, { 16, 32 }, { 3, 16 }, { 8, 32 } })->CONV2D_ARGS_NAMES;
+BENCHMARK(BM_Conv2DLayerDirectForwardPropagation)->ArgsProduct({ { 1, 10 }, { 16, 32 }, { 3, 16 }, { 8, 32 } })->CONV2D_ARGS_NAMES;
+BENCHMARK(BM_Conv2DLayerIm2colForwardPropagation)->ArgsProduct({ { 1, 10 }, { 16, 32 }, { 3, 16 }, { 8, 32 } })->CONV2D_ARGS_NAMES;
+BENCHMARK(BM_Conv2DLayerWinogradForwardPropagation)->ArgsProduct({ { 1, 10 }, { 16, 32 }, { 3, 16 }, { 8, 32 } })->CONV2D_ARGS_NAMES;
+BENCHMARK(BM_Conv2DLayerStridedForwardPropagation)->ArgsProduct({ { 1, 10 }, { 16, 32 }, { 3, 16 }, { 8, 32 } })->CONV2D_ARGS_NAMES;
+BENCHMARK(BM_Conv2DLayerFilterSizeForwardPropagation)->ArgsProduct({
+    { static_cast<int64_t>(ConvAlgorithm::Direct), static_cast<int64_t>(ConvAlgorithm::Im2col), static_cast<int64_t>(ConvAlgorithm::FFT), static_cast<int64_t>(ConvAlgorithm::Auto) },
+    { 16, 32, 64 }, { 3, 5, 7, 9, 11 } })->ArgNames({ "algorithm", "size", "filter_size" });
+BENCHMARK(BM_Conv2DLayerBackwardPropagation)->ArgsProduct({ { 1, 4 }, { 16 }, { 3 }, { 8 } })->CONV2D_ARGS_NAMES;
\ No newline at end of file
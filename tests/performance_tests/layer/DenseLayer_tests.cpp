@@ -1,33 +1,103 @@
 #include <benchmark/benchmark.h>
 
 #include "src/DenseLayer.h"
+#include "src/ActivationLayer.h"
 #include "src/Tensor.h"
 #include "src/Utils.h"
+#include "tests/performance_tests/PerformanceTestsUtils.h"
 
-constexpr uint32_t N = 100;
-constexpr uint32_t M = 100;
+static void denseCounters(benchmark::State& state, uint32_t batch, uint32_t m, uint32_t neurons, double products_count=1.0) {
+    double bytes = (double(batch) * m + double(m) * neurons + neurons + double(batch) * neurons) * FLOAT_BYTES;
+    setCounters(state, batch, bytes, products_count * 2.0 * batch * m * neurons);
+}
 
 static void BM_DenseLayerForwardPropagation(benchmark::State& state) {
-    Tensor x = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
-    DenseLayer layer = DenseLayer({ M }, M);
+    uint32_t batch = state.range(0);
+    uint32_t m = state.range(1);
+    Tensor x = Tensor({ batch, m }).applyFunction([](float) { return randNormalDistribution(); });
+    DenseLayer layer = DenseLayer({ m }, m);
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
         Tensor c = layer.forwardPropagation(x);
     }
+
+    denseCounters(state, batch, m, m);
 }
 
 static void BM_DenseLayerBackwardPropagation(benchmark::State& state) {
-    Tensor x = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
-    Tensor dx = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
-    DenseLayer layer = DenseLayer({ M }, M);
+    uint32_t batch = state.range(0);
+    uint32_t m = state.range(1);
+    Tensor x = Tensor({ batch, m }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor dx = Tensor({ batch, m }).applyFunction([](float) { return randNormalDistribution(); });
+    DenseLayer layer = DenseLayer({ m }, m);
     
     layer.initCachedGradient();
     layer.forwardPropagation(x);
 
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = layer.backwardPropagation(dx);
+    }
+
+    // input gradient and weights gradient products
+    denseCounters(state, batch, m, m, 2.0);
+}
+
+static void BM_DenseLayerWithActivationLayerForwardPropagation(benchmark::State& state) {
+    uint32_t batch = state.range(0);
+    uint32_t m = state.range(1);
+    Tensor x = Tensor({ batch, m }).applyFunction([](float) { return randNormalDistribution(); });
+    DenseLayer layer = DenseLayer({ m }, m);
+    ActivationLayer activation_layer = ActivationLayer(layer, ActivationFun::ReLU);
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = activation_layer.forwardPropagation(layer.forwardPropagation(x));
+    }
+
+    denseCounters(state, batch, m, m);
+}
+
+static void BM_DenseLayerFusedActivationForwardPropagation(benchmark::State& state) {
+    uint32_t batch = state.range(0);
+    uint32_t m = state.range(1);
+    Tensor x = Tensor({ batch, m }).applyFunction([](float) { return randNormalDistribution(); });
+    DenseLayer layer = DenseLayer({ m }, m);
+
+    layer.fuseActivation(ActivationFun::ReLU);
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = layer.forwardPropagation(x);
+    }
+
+    denseCounters(state, batch, m, m);
+}
+
+static void BM_DenseLayerFusedActivationBackwardPropagation(benchmark::State& state) {
+    uint32_t batch = state.range(0);
+    uint32_t m = state.range(1);
+    Tensor x = Tensor({ batch, m }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor dx = Tensor({ batch, m }).applyFunction([](float) { return randNormalDistribution(); });
+    DenseLayer layer = DenseLayer({ m }, m);
+
+    layer.fuseActivation(ActivationFun::ReLU);
+    layer.initCachedGradient();
+    layer.forwardPropagation(x);
+
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
         Tensor c = layer.backwardPropagation(dx);
     }
+
+    denseCounters(state, batch, m, m, 2.0);
 }
 
-BENCHMARK(BM_DenseLayerForwardPropagation);
-BENCHMARK(BM_DenseLayerBackwardPropagation);
\ No newline at end of file
+#define DENSE_ARGS ArgsProduct({ { 1, 32, 256 }, { 128, 512 } })->ArgNames({ "batch", "m" })
+
+BENCHMARK(BM_DenseLayerForwardPropagation)->DENSE_ARGS;
+BENCHMARK(BM_DenseLayerBackwardPropagation)->DENSE_ARGS;
+BENCHMARK(BM_DenseLayerWithActivationLayerForwardPropagation)->DENSE_ARGS;
+BENCHMARK(BM_DenseLayerFusedActivationForwardPropagation)->DENSE_ARGS;
+BENCHMARK(BM_DenseLayerFusedActivationBackwardPropagation)->DENSE_ARGS;
\ No newline at end of file
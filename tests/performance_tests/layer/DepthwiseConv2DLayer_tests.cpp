@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include "src/DepthwiseConv2DLayer.h"
+#include "src/PointwiseConv2DLayer.h"
+#include "src/Tensor.h"
+#include "src/Utils.h"
+#include "tests/performance_tests/PerformanceTestsUtils.h"
+
+static void BM_DepthwiseConv2DLayerForwardPropagation(benchmark::State& state) {
+    uint32_t batch = state.range(0);
+    uint32_t size = state.range(1);
+    uint32_t channels = state.range(2);
+    Tensor x = Tensor({ batch, size, size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    DepthwiseConv2DLayer layer = DepthwiseConv2DLayer({ size, size, channels }, 3);
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = layer.forwardPropagation(x);
+    }
+
+    double n = x.getSize();
+    setCounters(state, batch, (2.0 * n + 9.0 * channels) * FLOAT_BYTES, 2.0 * n * 9.0);
+}
+
+static void BM_DepthwiseConv2DLayerBackwardPropagation(benchmark::State& state) {
+    uint32_t batch = state.range(0);
+    uint32_t size = state.range(1);
+    uint32_t channels = state.range(2);
+    Tensor x = Tensor({ batch, size, size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor dx = Tensor({ batch, size, size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    DepthwiseConv2DLayer layer = DepthwiseConv2DLayer({ size, size, channels }, 3);
+
+    layer.initCachedGradient();
+    layer.forwardPropagation(x);
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = layer.backwardPropagation(dx);
+    }
+
+    // input gradient and weights gradient
+    double n = x.getSize();
+    setCounters(state, batch, (3.0 * n + 18.0 * channels) * FLOAT_BYTES, 2.0 * 2.0 * n * 9.0);
+}
+
+static void BM_SeparableConv2DForwardPropagation(benchmark::State& state) {
+    // depthwise 3x3 followed by pointwise, same arguments and receptive field as BM_Conv2DLayerForwardPropagation
+    uint32_t batch = state.range(0);
+    uint32_t size = state.range(1);
+    uint32_t channels = state.range(2);
+    uint32_t filters = state.range(3);
+    Tensor x = Tensor({ batch, size, size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    DepthwiseConv2DLayer depthwise = DepthwiseConv2DLayer({ size, size, channels }, 3);
+    PointwiseConv2DLayer pointwise = PointwiseConv2DLayer(depthwise, filters);
+
+    Tensor y;
+    Tensor c;
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        depthwise.infer(x, y);
+        pointwise.infer(y, c);
+    }
+
+    double pixels = double(batch) * size * size;
+    double bytes = (pixels * (2.0 * channels + filters) + 9.0 * channels + channels * filters) * FLOAT_BYTES;
+    setCounters(state, batch, bytes, 2.0 * pixels * channels * (9.0 + filters));
+}
+
+#define DEPTHWISE_CONV2D_ARGS_NAMES ArgNames({ "batch", "size", "channels" })
+
+BENCHMARK(BM_DepthwiseConv2DLayerForwardPropagation)->ArgsProduct({ { 1, 10 }, { 16, 32 }, { 16, 64 } })->DEPTHWISE_CONV2D_ARGS_NAMES;
+BENCHMARK(BM_DepthwiseConv2DLayerBackwardPropagation)->ArgsProduct({ { 1, 10 }, { 16, 32 }, { 16, 64 } })->DEPTHWISE_CONV2D_ARGS_NAMES;
+BENCHMARK(BM_SeparableConv2DForwardPropagation)->ArgsProduct({ { 1, 10 }, { 16, 32 }, { 3, 16 }, { 8, 32 } })->ArgNames({ "batch", "size", "channels", "filters" });
\ No newline at end of file
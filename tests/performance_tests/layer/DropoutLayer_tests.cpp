@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+
+#include "src/DropoutLayer.h"
+#include "src/Tensor.h"
+#include "src/Utils.h"
+#include "tests/performance_tests/PerformanceTestsUtils.h"
+
+static void BM_DropoutLayerForwardPropagation(benchmark::State& state) {
+    uint32_t batch = state.range(0);
+    uint32_t size = state.range(1);
+    Tensor x = Tensor({ batch, size }).applyFunction([](float) { return randNormalDistribution(); });
+    DropoutLayer layer = DropoutLayer({ size }, 0.5f);
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = layer.forwardPropagation(x);
+    }
+
+    // input and output values, mask bits
+    double values = double(batch) * size;
+    setCounters(state, batch, 2.0 * values * FLOAT_BYTES + values / 8.0, values);
+}
+
+static void BM_DropoutLayerBackwardPropagation(benchmark::State& state) {
+    uint32_t batch = state.range(0);
+    uint32_t size = state.range(1);
+    Tensor x = Tensor({ batch, size }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor dx = Tensor({ batch, size }).applyFunction([](float) { return randNormalDistribution(); });
+    DropoutLayer layer = DropoutLayer({ size }, 0.5f);
+
+    layer.forwardPropagation(x);
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = layer.backwardPropagation(dx);
+    }
+
+    double values = double(batch) * size;
+    setCounters(state, batch, 2.0 * values * FLOAT_BYTES + values / 8.0, values);
+}
+
+#define DROPOUT_ARGS_NAMES ArgNames({ "batch", "size" })
+
+BENCHMARK(BM_DropoutLayerForwardPropagation)->ArgsProduct({ { 1, 32 }, { 1024, 16384 } })->DROPOUT_ARGS_NAMES;
+BENCHMARK(BM_DropoutLayerBackwardPropagation)->ArgsProduct({ { 1, 32 }, { 1024, 16384 } })->DROPOUT_ARGS_NAMES;
\ No newline at end of file
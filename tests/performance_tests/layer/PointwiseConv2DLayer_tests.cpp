@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include "src/PointwiseConv2DLayer.h"
+#include "src/Tensor.h"
+#include "src/Utils.h"
+#include "tests/performance_tests/PerformanceTestsUtils.h"
+
+static void pointwiseConv2DLayerCounters(benchmark::State& state, uint32_t batch, uint32_t size, uint32_t channels, uint32_t filters, double products_count=1.0) {
+    double pixels = double(batch) * size * size;
+    double bytes = (pixels * (channels + filters) + channels * filters) * FLOAT_BYTES;
+    setCounters(state, batch, bytes, products_count * 2.0 * pixels * channels * filters);
+}
+
+static void BM_PointwiseConv2DLayerForwardPropagation(benchmark::State& state) {
+    uint32_t batch = state.range(0);
+    uint32_t size = state.range(1);
+    uint32_t channels = state.range(2);
+    uint32_t filters = state.range(3);
+    Tensor x = Tensor({ batch, size, size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    PointwiseConv2DLayer layer = PointwiseConv2DLayer({ size, size, channels }, filters);
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = layer.forwardPropagation(x);
+    }
+
+    pointwiseConv2DLayerCounters(state, batch, size, channels, filters);
+}
+
+static void BM_PointwiseConv2DLayerBackwardPropagation(benchmark::State& state) {
+    uint32_t batch = state.range(0);
+    uint32_t size = state.range(1);
+    uint32_t channels = state.range(2);
+    uint32_t filters = state.range(3);
+    Tensor x = Tensor({ batch, size, size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor dx = Tensor({ batch, size, size, filters }).applyFunction([](float) { return randNormalDistribution(); });
+    PointwiseConv2DLayer layer = PointwiseConv2DLayer({ size, size, channels }, filters);
+
+    layer.initCachedGradient();
+    layer.forwardPropagation(x);
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = layer.backwardPropagation(dx);
+    }
+
+    // input gradient and weights gradient
+    pointwiseConv2DLayerCounters(state, batch, size, channels, filters, 2.0);
+}
+
+#define POINTWISE_CONV2D_ARGS_NAMES ArgNames({ "batch", "size", "channels", "filters" })
+
+BENCHMARK(BM_PointwiseConv2DLayerForwardPropagation)->ArgsProduct({ { 1, 10 }, { 16, 32 }, { 16, 64 }, { 16, 64 } })->POINTWISE_CONV2D_ARGS_NAMES;
+BENCHMARK(BM_PointwiseConv2DLayerBackwardPropagation)->ArgsProduct({ { 1, 10 }, { 16, 32 }, { 16, 64 }, { 16, 64 } })->POINTWISE_CONV2D_ARGS_NAMES;
\ No newline at end of file
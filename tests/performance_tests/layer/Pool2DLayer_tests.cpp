@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include "src/Pool2DLayer.h"
+#include "src/Tensor.h"
+#include "src/Utils.h"
+#include "tests/performance_tests/PerformanceTestsUtils.h"
+
+static void poolForwardBenchmark(benchmark::State& state, PoolMode pool_mode) {
+    uint32_t batch = state.range(0);
+    uint32_t size = state.range(1);
+    uint32_t channels = state.range(2);
+    uint32_t pool_size = state.range(3);
+    Tensor x = Tensor({ batch, size, size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Pool2DLayer layer = Pool2DLayer({ size, size, channels }, pool_size, pool_mode);
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = layer.forwardPropagation(x);
+    }
+
+    double n = x.getSize();
+    setCounters(state, batch, n * (1.0 + 1.0 / (pool_size * pool_size)) * FLOAT_BYTES, n);
+}
+
+static void poolBackwardBenchmark(benchmark::State& state, PoolMode pool_mode) {
+    uint32_t batch = state.range(0);
+    uint32_t size = state.range(1);
+    uint32_t channels = state.range(2);
+    uint32_t pool_size = state.range(3);
+    Tensor x = Tensor({ batch, size, size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor dx = Tensor({ batch, size / pool_size, size / pool_size, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Pool2DLayer layer = Pool2DLayer({ size, size, channels }, pool_size, pool_mode);
+
+    layer.forwardPropagation(x);
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = layer.backwardPropagation(dx);
+    }
+
+    // cached input, cached output, gradient in and gradient out
+    double n = x.getSize();
+    setCounters(state, batch, n * (2.0 + 2.0 / (pool_size * pool_size)) * FLOAT_BYTES, 2.0 * n);
+}
+
+static void BM_Pool2DLayerMaxForwardPropagation(benchmark::State& state) {
+    poolForwardBenchmark(state, PoolMode::Max);
+}
+
+static void BM_Pool2DLayerMaxBackwardPropagation(benchmark::State& state) {
+    poolBackwardBenchmark(state, PoolMode::Max);
+}
+
+static void BM_Pool2DLayerAverageForwardPropagation(benchmark::State& state) {
+    poolForwardBenchmark(state, PoolMode::Average);
+}
+
+static void BM_Pool2DLayerAverageBackwardPropagation(benchmark::State& state) {
+    poolBackwardBenchmark(state, PoolMode::Average);
+}
+
+#define POOL2D_ARGS ArgsProduct({ { 1, 10 }, { 24, 48 }, { 8, 32 }, { 2, 3, 4 } })->ArgNames({ "batch", "size", "channels", "pool" })
+
+BENCHMARK(BM_Pool2DLayerMaxForwardPropagation)->POOL2D_ARGS;
+BENCHMARK(BM_Pool2DLayerMaxBackwardPropagation)->POOL2D_ARGS;
+BENCHMARK(BM_Pool2DLayerAverageForwardPropagation)->POOL2D_ARGS;
+BENCHMARK(BM_Pool2DLayerAverageBackwardPropagation)->POOL2D_ARGS;
\ No newline at end of file
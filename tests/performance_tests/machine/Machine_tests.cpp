@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "tests/performance_tests/PerformanceTestsUtils.h"
+
+// Machine ceilings for the roofline report (generate_performance_report.py --roofline).
+// Both are what plain C++ loops reach with this build's compiler flags.
+
+constexpr uint32_t PEAK_ACCUMULATORS = 64;
+constexpr uint32_t PEAK_REPEATS = 4096;
+
+static void BM_MachinePeakFlops(benchmark::State& state) {
+    // independent accumulators hide multiply-add latency, compiler keeps them in vector registers
+    float acc[PEAK_ACCUMULATORS];
+    for (uint32_t j = 0; j < PEAK_ACCUMULATORS; ++j) {
+        acc[j] = static_cast<float>(j);
+    }
+    const float a = 0.999f;
+    const float b = 0.001f;
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < PEAK_REPEATS; ++i) {
+            for (uint32_t j = 0; j < PEAK_ACCUMULATORS; ++j) {
+                acc[j] = acc[j] * a + b;
+            }
+        }
+        benchmark::DoNotOptimize(acc);
+    }
+
+    setCounters(state, PEAK_ACCUMULATORS * PEAK_REPEATS, 0.0, 2.0 * PEAK_ACCUMULATORS * PEAK_REPEATS);
+}
+
+static void BM_MachinePeakBandwidth(benchmark::State& state) {
+    // STREAM triad, size selects the memory level: L1, L2, L3 or DRAM
+    uint32_t n = state.range(0);
+    std::vector<float> a(n, 0.0f);
+    std::vector<float> b(n, 1.0f);
+    std::vector<float> c(n, 2.0f);
+    const float s = 3.0f;
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        float* a_data = a.data();
+        const float* b_data = b.data();
+        const float* c_data = c.data();
+        for (uint32_t i = 0; i < n; ++i) {
+            a_data[i] = b_data[i] + s * c_data[i];
+        }
+        benchmark::ClobberMemory();
+    }
+
+    setCounters(state, n, 3.0 * n * FLOAT_BYTES, 2.0 * n);
+}
+
+BENCHMARK(BM_MachinePeakFlops)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_MachinePeakBandwidth)->Arg(1 << 11)->Arg(1 << 16)->Arg(1 << 20)->Arg(1 << 24)->ArgName("n")->ThreadRange(1, 8)->UseRealTime();
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include <benchmark/benchmark.h>
+
+#include "src/Tensor.h"
+#include "src/DenseLayer.h"
+#include "src/Conv2DLayer.h"
+#include "src/Pool2DLayer.h"
+#include "src/ActivationLayer.h"
+#include "src/NeuralNetwork.h"
+#include "src/Metrics.h"
+#include "src/Utils.h"
+#include "tests/performance_tests/PerformanceTestsUtils.h"
+
+// Topologies of the real applications, trained and evaluated on synthetic data.
+
+// applications/mnist/mnist_main.cpp, dense model
+struct MnistDenseModel {
+	DenseLayer layer_dense_1 = DenseLayer({ 28, 28, 1 }, 64);
+	ActivationLayer layer_relu_1 = ActivationLayer(layer_dense_1, ActivationFun::LeakyReLU);
+	DenseLayer layer_dense_2 = DenseLayer(layer_relu_1, 64);
+	ActivationLayer layer_relu_2 = ActivationLayer(layer_dense_2, ActivationFun::LeakyReLU);
+	DenseLayer layer_dense_3 = DenseLayer(layer_relu_2, 32);
+	ActivationLayer layer_relu_3 = ActivationLayer(layer_dense_3, ActivationFun::LeakyReLU);
+	DenseLayer layer_dense_4 = DenseLayer(layer_relu_3, 16);
+	ActivationLayer layer_relu_4 = ActivationLayer(layer_dense_4, ActivationFun::LeakyReLU);
+	DenseLayer layer_dense_5 = DenseLayer(layer_relu_4, 10);
+	ActivationLayer layer_sigmoid = ActivationLayer(layer_dense_5, ActivationFun::Sigmoid);
+	NeuralNetwork nn = NeuralNetwork(layer_dense_1, layer_sigmoid, CostFun::BinaryCrossentropy);
+};
+
+// applications/mnist/mnist_main.cpp, conv model
+struct MnistConvModel {
+	Conv2DLayer layer_conv2d_1 = Conv2DLayer({ 28, 28, 1 }, 4, 3);
+	ActivationLayer layer_relu_1 = ActivationLayer(layer_conv2d_1, ActivationFun::LeakyReLU);
+	Pool2DLayer layer_pool2d_1 = Pool2DLayer(layer_relu_1, 2, PoolMode::Max);
+	Conv2DLayer layer_conv2d_2 = Conv2DLayer(layer_pool2d_1, 4, 3);
+	ActivationLayer layer_relu_2 = ActivationLayer(layer_conv2d_2, ActivationFun::LeakyReLU);
+	Pool2DLayer layer_pool2d_2 = Pool2DLayer(layer_relu_2, 2, PoolMode::Max);
+	Conv2DLayer layer_conv2d_3 = Conv2DLayer(layer_pool2d_2, 4, 3);
+	ActivationLayer layer_relu_3 = ActivationLayer(layer_conv2d_3, ActivationFun::LeakyReLU);
+	DenseLayer layer_dense_1 = DenseLayer(layer_relu_3, 32);
+	DenseLayer layer_dense_2 = DenseLayer(layer_dense_1, 10);
+	ActivationLayer layer_sigmoid = ActivationLayer(layer_dense_2, ActivationFun::Sigmoid);
+	NeuralNetwork nn = NeuralNetwork(layer_conv2d_1, layer_sigmoid, CostFun::BinaryCrossentropy);
+};
+
+// src/main.cpp, 100x100x3 conv model
+struct ImageConvModel {
+	Conv2DLayer layer_1 = Conv2DLayer({ 100, 100, 3 }, 8, 3);
+	ActivationLayer layer_2 = ActivationLayer(layer_1, ActivationFun::LeakyReLU);
+	Conv2DLayer layer_3 = Conv2DLayer(layer_2, 16, 3);
+	ActivationLayer layer_4 = ActivationLayer(layer_3, ActivationFun::LeakyReLU);
+	DenseLayer layer_5 = DenseLayer(layer_4, 64);
+	ActivationLayer layer_6 = ActivationLayer(layer_5, ActivationFun::LeakyReLU);
+	DenseLayer layer_7 = DenseLayer(layer_6, 32);
+	ActivationLayer layer_8 = ActivationLayer(layer_7, ActivationFun::LeakyReLU);
+	DenseLayer layer_9 = DenseLayer(layer_8, 16);
+	ActivationLayer layer_10 = ActivationLayer(layer_9, ActivationFun::LeakyReLU);
+	DenseLayer layer_11 = DenseLayer(layer_10, 2);
+	ActivationLayer layer_12 = ActivationLayer(layer_11, ActivationFun::Sigmoid);
+	NeuralNetwork nn = NeuralNetwork(layer_1, layer_12, CostFun::BinaryCrossentropy);
+};
+
+// dataset of a few batches, so data preparation is not always the same slice
+constexpr uint32_t DATASET_BATCHES = 4;
+
+static void makeDataset(const NeuralNetwork& nn, uint32_t samples, Tensor& x, Tensor& y) {
+	std::vector<uint32_t> x_shape = nn.getInputShape();
+	std::vector<uint32_t> y_shape = nn.getOutputShape();
+	x_shape.insert(x_shape.begin(), samples);
+	y_shape.insert(y_shape.begin(), samples);
+
+	x = Tensor(x_shape).applyFunction([](float) { return randUniform(0.0f, 1.0f); });
+	y = Tensor(y_shape);
+
+	// one-hot labels
+	uint32_t classes = y.getSize() / samples;
+	for (uint32_t i = 0; i < samples; ++i) {
+		y.getDataPtr()[i * classes + rand() % classes] = 1.0f;
+	}
+}
+
+template <class Model>
+static void BM_ModelTrain(benchmark::State& state) {
+	uint32_t batch = state.range(0);
+	Model model;
+	NeuralNetwork& nn = model.nn;
+
+	Tensor x, y;
+	makeDataset(nn, batch * DATASET_BATCHES, x, y);
+
+	PhaseTimes phases;
+	uint32_t batch_idx{ 0 };
+	MemoryCountersScope memory_counters(state);
+
+	nn.initLayersCachedGradient();
+	HardwareCountersScope hardware_counters(state);
+	for (auto _ : state) {
+		// same steps and phases as a single batch of NeuralNetwork::fit
+		Stopwatch phase_watch;
+
+		uint32_t batch_start = (batch_idx++ % DATASET_BATCHES) * batch;
+		Tensor batch_x = x.slice(0, batch_start, batch_start + batch);
+		Tensor batch_y = y.slice(0, batch_start, batch_start + batch);
+		phases.data_sec += phase_watch.lap();
+
+		Tensor y_hat = nn.forwardPropagation(batch_x);
+		phases.forward_sec += phase_watch.lap();
+
+		nn.backwardPropagation(y_hat, batch_y);
+		phases.backward_sec += phase_watch.lap();
+
+		nn.updateLayersWeights(0.01f);
+		nn.initLayersCachedGradient();
+		phases.update_sec += phase_watch.lap();
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(batch) * state.iterations());
+	state.counters["data_ms"] = benchmark::Counter(phases.data_sec * 1e3, benchmark::Counter::kAvgIterations);
+	state.counters["forward_ms"] = benchmark::Counter(phases.forward_sec * 1e3, benchmark::Counter::kAvgIterations);
+	state.counters["backward_ms"] = benchmark::Counter(phases.backward_sec * 1e3, benchmark::Counter::kAvgIterations);
+	state.counters["update_ms"] = benchmark::Counter(phases.update_sec * 1e3, benchmark::Counter::kAvgIterations);
+}
+
+template <class Model>
+static void BM_ModelTrainCheckpointed(benchmark::State& state) {
+	// peak memory against step time, budget in percent of activations cached without checkpointing
+	uint32_t batch = state.range(0);
+	uint32_t budget_pct = state.range(1);
+	Model model;
+	NeuralNetwork& nn = model.nn;
+
+	Tensor x, y;
+	makeDataset(nn, batch * DATASET_BATCHES, x, y);
+
+	uint64_t activation_bytes = nn.getActivationMemory(batch);
+	if (budget_pct < 100) {
+		// 0 percent asks for the plan with the least memory
+		nn.setActivationMemoryBudget(std::max<uint64_t>(1, activation_bytes * budget_pct / 100));
+	}
+
+	uint32_t batch_idx{ 0 };
+	MemoryCountersScope memory_counters(state);
+
+	nn.initLayersCachedGradient();
+	HardwareCountersScope hardware_counters(state);
+	for (auto _ : state) {
+		uint32_t batch_start = (batch_idx++ % DATASET_BATCHES) * batch;
+		Tensor batch_x = x.slice(0, batch_start, batch_start + batch);
+		Tensor batch_y = y.slice(0, batch_start, batch_start + batch);
+
+		Tensor y_hat = nn.forwardPropagation(batch_x);
+		nn.backwardPropagation(y_hat, batch_y);
+		nn.updateLayersWeights(0.01f);
+		nn.initLayersCachedGradient();
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(batch) * state.iterations());
+	state.counters["activation_bytes"] = benchmark::Counter(activation_bytes);
+	state.counters["segments"] = benchmark::Counter(std::max<size_t>(1, nn.getCheckpoints().size()));
+}
+
+template <class Model>
+static void BM_ModelPredict(benchmark::State& state) {
+	uint32_t batch = state.range(0);
+	Model model;
+
+	Tensor x, y;
+	makeDataset(model.nn, batch, x, y);
+	MemoryCountersScope memory_counters(state);
+
+	HardwareCountersScope hardware_counters(state);
+	for (auto _ : state) {
+		Tensor y_hat = model.nn.predict(x);
+		benchmark::DoNotOptimize(y_hat.getDataPtr());
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(batch) * state.iterations());
+}
+
+template <class Model>
+static void BM_ModelPredictWithContext(benchmark::State& state) {
+	uint32_t batch = state.range(0);
+	Model model;
+	ExecutionContext context;
+
+	Tensor x, y;
+	makeDataset(model.nn, batch, x, y);
+	MemoryCountersScope memory_counters(state);
+
+	HardwareCountersScope hardware_counters(state);
+	for (auto _ : state) {
+		const Tensor& y_hat = model.nn.predict(x, context);
+		benchmark::DoNotOptimize(y_hat.getDataPtr());
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(batch) * state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_ModelTrain, MnistDenseModel)->ArgName("batch")->Arg(32)->Arg(256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ModelPredict, MnistDenseModel)->ArgName("batch")->Arg(1)->Arg(256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ModelPredictWithContext, MnistDenseModel)->ArgName("batch")->Arg(1)->Arg(256)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_ModelTrain, MnistConvModel)->ArgName("batch")->Arg(8)->Arg(32)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ModelTrainCheckpointed, MnistConvModel)->ArgNames({ "batch", "budget_pct" })->ArgsProduct({ { 32 }, { 100, 50, 25, 0 } })->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ModelPredict, MnistConvModel)->ArgName("batch")->Arg(1)->Arg(256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ModelPredictWithContext, MnistConvModel)->ArgName("batch")->Arg(1)->Arg(256)->Unit(benchmark::kMillisecond);
+
+// backward pass of this model takes seconds per sample, keep the batch tiny
+BENCHMARK_TEMPLATE(BM_ModelTrain, ImageConvModel)->ArgName("batch")->Arg(2)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ModelTrainCheckpointed, ImageConvModel)->ArgNames({ "batch", "budget_pct" })->ArgsProduct({ { 2 }, { 100, 50, 25, 0 } })->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ModelPredict, ImageConvModel)->ArgName("batch")->Arg(1)->Arg(8)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ModelPredictWithContext, ImageConvModel)->ArgName("batch")->Arg(1)->Arg(8)->Unit(benchmark::kMillisecond);
\ No newline at end of file
@@ -5,15 +5,21 @@
 #include "src/ActivationLayer.h"
 #include "src/NeuralNetwork.h"
 #include "src/Utils.h"
+#include "tests/performance_tests/PerformanceTestsUtils.h"
 
 constexpr uint32_t N = 1000;
-constexpr uint32_t M = 100;
+
+static double networkFlops(uint32_t batch) {
+	// dense layers 2 x 16, 16 x 16, 16 x 16, 16 x 2
+	return 2.0 * batch * (2 * 16 + 16 * 16 + 16 * 16 + 16 * 2);
+}
 
 static void BM_NeuralNetworkPredict(benchmark::State& state) {
 	uint32_t i = 0;
+	uint32_t batch = state.range(0);
 
-	Tensor x_test = Tensor({ M, 2 });
-	Tensor y_test = Tensor({ M, 2 });
+	Tensor x_test = Tensor({ batch, 2 });
+	Tensor y_test = Tensor({ batch, 2 });
 
 	srand(time(NULL));
 
@@ -41,18 +47,51 @@ static void BM_NeuralNetworkPredict(benchmark::State& state) {
 
 	auto nn = NeuralNetwork(layer_1, layer_8, CostFun::BinaryCrossentropy);
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
 	    Tensor y_hat = nn.predict(x_test);
     }
+
+	setCounters(state, batch, batch * 4.0 * FLOAT_BYTES, networkFlops(batch));
+}
+
+static void BM_NeuralNetworkPredictWithContext(benchmark::State& state) {
+	// one shared network, every benchmark thread has its own context
+	static Tensor x_test;
+	static DenseLayer layer_1 = DenseLayer({ 2 }, 16);
+	static ActivationLayer layer_2 = ActivationLayer(layer_1, ActivationFun::LeakyReLU);
+	static DenseLayer layer_3 = DenseLayer(layer_2, 16);
+	static ActivationLayer layer_4 = ActivationLayer(layer_3, ActivationFun::LeakyReLU);
+	static DenseLayer layer_5 = DenseLayer(layer_4, 16);
+	static ActivationLayer layer_6 = ActivationLayer(layer_5, ActivationFun::LeakyReLU);
+	static DenseLayer layer_7 = DenseLayer(layer_6, 2);
+	static ActivationLayer layer_8 = ActivationLayer(layer_7, ActivationFun::Sigmoid);
+	static const NeuralNetwork nn = NeuralNetwork(layer_1, layer_8, CostFun::BinaryCrossentropy);
+
+	uint32_t batch = state.range(0);
+	if (0 == state.thread_index()) {
+		x_test = Tensor({ batch, 2 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+	}
+	ExecutionContext context;
+
+	HardwareCountersScope hardware_counters(state);
+	for (auto _ : state) {
+		const Tensor& y_hat = nn.predict(x_test, context);
+		benchmark::DoNotOptimize(y_hat.getDataPtr());
+	}
+
+	setCounters(state, batch, batch * 4.0 * FLOAT_BYTES, networkFlops(batch));
 }
 
 static void BM_NeuralNetworkFit(benchmark::State& state) {
 	uint32_t i = 0;
+	uint32_t batch_size = state.range(0);
+	uint32_t epochs = 20;
 
 	Tensor x_train = Tensor({ N, 2 });
 	Tensor y_train = Tensor({ N, 2 });
-	Tensor x_test = Tensor({ M, 2 });
-	Tensor y_test = Tensor({ M, 2 });
+	Tensor x_test = Tensor({ N / 10, 2 });
+	Tensor y_test = Tensor({ N / 10, 2 });
 
 	srand(time(NULL));
 
@@ -93,10 +132,16 @@ static void BM_NeuralNetworkFit(benchmark::State& state) {
     
 	auto nn = NeuralNetwork(layer_1, layer_8, CostFun::BinaryCrossentropy);
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
-	    nn.fit(x_train, y_train, x_test, y_test, 500, 20, 0.05f, 0);
+	    nn.fit(x_train, y_train, x_test, y_test, batch_size, epochs, 0.05f, 0);
     }
+
+	// forward and backward passes over training samples, roughly three times the forward work
+	double samples = double(N) * epochs;
+	setCounters(state, samples, samples * 4.0 * FLOAT_BYTES, 3.0 * networkFlops(N) * epochs);
 }
 
-BENCHMARK(BM_NeuralNetworkPredict);
-BENCHMARK(BM_NeuralNetworkFit);
\ No newline at end of file
+BENCHMARK(BM_NeuralNetworkPredict)->RangeMultiplier(8)->Range(1, 4096)->ArgName("batch");
+BENCHMARK(BM_NeuralNetworkPredictWithContext)->RangeMultiplier(8)->Range(1, 4096)->ArgName("batch")->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_NeuralNetworkFit)->Arg(50)->Arg(500)->ArgName("batch_size");
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+
+#include "src/HalfTensor.h"
+#include "src/Tensor.h"
+#include "src/Utils.h"
+#include "tests/performance_tests/PerformanceTestsUtils.h"
+
+static void BM_HalfTensorConvertBFloat16(benchmark::State& state) {
+    uint32_t n = state.range(0);
+    Tensor a = Tensor({ n }).applyFunction([](float) { return randNormalDistribution(); });
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        HalfTensor b = HalfTensor(a, DataType::BFloat16);
+        Tensor c = b.toTensor();
+    }
+
+    // float to half and back
+    setCounters(state, n, n * (2.0 * FLOAT_BYTES + 2.0 * sizeof(uint16_t)), 0.0);
+}
+
+static void BM_HalfTensorConvertFloat16(benchmark::State& state) {
+    uint32_t n = state.range(0);
+    Tensor a = Tensor({ n }).applyFunction([](float) { return randNormalDistribution(); });
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        HalfTensor b = HalfTensor(a, DataType::Float16);
+        Tensor c = b.toTensor();
+    }
+
+    setCounters(state, n, n * (2.0 * FLOAT_BYTES + 2.0 * sizeof(uint16_t)), 0.0);
+}
+
+static void BM_HalfTensorDotProductTranspose(benchmark::State& state) {
+    uint32_t m = state.range(0);
+    Tensor a = Tensor({ m, m }).applyFunction([](float) { return randNormalDistribution(); });
+    HalfTensor b = HalfTensor(Tensor({ m, m }).applyFunction([](float) { return randNormalDistribution(); }), DataType::BFloat16);
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = HalfTensor::dotProductTranspose(a, b);
+    }
+
+    setCounters(state, double(m) * m, double(m) * m * (2.0 * FLOAT_BYTES + sizeof(uint16_t)), 2.0 * m * m * m);
+}
+
+BENCHMARK(BM_HalfTensorConvertBFloat16)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->ArgName("n");
+BENCHMARK(BM_HalfTensorConvertFloat16)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->ArgName("n");
+BENCHMARK(BM_HalfTensorDotProductTranspose)->RangeMultiplier(2)->Range(32, 256)->ArgName("m");
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+
+#include "src/QuantizedTensor.h"
+#include "src/Tensor.h"
+#include "src/Utils.h"
+#include "tests/performance_tests/PerformanceTestsUtils.h"
+
+static void BM_QuantizedTensorDotProductTranspose(benchmark::State& state) {
+    uint32_t m = state.range(0);
+    Tensor a = Tensor({ m, m }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor b = Tensor({ m, m }).applyFunction([](float) { return randNormalDistribution(); });
+    QuantizedTensor a_q = QuantizedTensor(a, QuantizedTensor::calibrateScale(a));
+    QuantizedTensor b_q = QuantizedTensor(b, 0u);
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = QuantizedTensor::dotProductTranspose(a_q, b_q);
+    }
+
+    // integer operations are reported in the GFLOP/s counter
+    setCounters(state, double(m) * m, double(m) * m * (2.0 + FLOAT_BYTES), 2.0 * m * m * m);
+}
+
+static void BM_QuantizedTensorConv2D(benchmark::State& state) {
+    uint32_t size = state.range(0);
+    uint32_t channels = state.range(1);
+    uint32_t filters = state.range(2);
+    Tensor a = Tensor({ size + 2, size + 2, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor b = Tensor({ 3, 3, channels, filters }).applyFunction([](float) { return randNormalDistribution(); });
+    QuantizedTensor a_q = QuantizedTensor(a, QuantizedTensor::calibrateScale(a));
+    QuantizedTensor b_q = QuantizedTensor(b, 3u);
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = QuantizedTensor::Conv2D(a_q, b_q);
+    }
+
+    double outputs = double(size) * size * filters;
+    setCounters(state, outputs, a.getSize() + b.getSize() + outputs * FLOAT_BYTES, 2.0 * outputs * 9 * channels);
+}
+
+BENCHMARK(BM_QuantizedTensorDotProductTranspose)->RangeMultiplier(2)->Range(32, 256)->ArgName("m");
+BENCHMARK(BM_QuantizedTensorConv2D)->ArgsProduct({ { 16, 32 }, { 8, 32 }, { 16, 64 } })->ArgNames({ "size", "channels", "filters" });
\ No newline at end of file
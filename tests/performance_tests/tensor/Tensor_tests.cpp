@@ -2,184 +2,398 @@
 
 #include "src/Tensor.h"
 #include "src/Utils.h"
+#include "tests/performance_tests/PerformanceTestsUtils.h"
 
-constexpr uint32_t N = 10000;
-constexpr uint32_t M = 100;
+static Tensor randomTensor(const std::vector<uint32_t>& shape) {
+    return Tensor(shape).applyFunction([](float) { return randNormalDistribution(); });
+}
 
 static void BM_Tensor1D1DDotProduct(benchmark::State& state) {
-    Tensor a = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
-    Tensor b = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
+    uint32_t n = state.range(0);
+    Tensor a = randomTensor({ n });
+    Tensor b = randomTensor({ n });
     
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
         Tensor c = a.dotProduct(b);
     }
+
+    setCounters(state, n, 2.0 * n * FLOAT_BYTES, 2.0 * n);
 }
 
 static void BM_Tensor2D1DDotProduct(benchmark::State& state) {
-    Tensor a = Tensor({ M, N }).applyFunction([](float) { return randNormalDistribution(); });
-    Tensor b = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
+    uint32_t m = state.range(0);
+    uint32_t n = state.range(1);
+    Tensor a = randomTensor({ m, n });
+    Tensor b = randomTensor({ n });
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
         Tensor c = a.dotProduct(b);
     }
+
+    setCounters(state, m, (double(m) * n + n + m) * FLOAT_BYTES, 2.0 * m * n);
 }
 
 static void BM_Tensor2D2DDotProduct(benchmark::State& state) {
-    Tensor a = Tensor({ M, M }).applyFunction([](float) { return randNormalDistribution(); });
-    Tensor b = Tensor({ M, M }).applyFunction([](float) { return randNormalDistribution(); });
+    uint32_t m = state.range(0);
+    Tensor a = randomTensor({ m, m });
+    Tensor b = randomTensor({ m, m });
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
         Tensor c = a.dotProduct(b);
     }
+
+    setCounters(state, double(m) * m, 3.0 * m * m * FLOAT_BYTES, 2.0 * m * m * m);
 }
 
 static void BM_TensorDotProductTranspose(benchmark::State& state) {
-    Tensor a = Tensor({ M, M }).applyFunction([](float) { return randNormalDistribution(); });
-    Tensor b = Tensor({ M, M }).applyFunction([](float) { return randNormalDistribution(); });
+    uint32_t m = state.range(0);
+    Tensor a = randomTensor({ m, m });
+    Tensor b = randomTensor({ m, m });
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
         Tensor c = a.dotProductTranspose(b);
     }
+
+    setCounters(state, double(m) * m, 3.0 * m * m * FLOAT_BYTES, 2.0 * m * m * m);
 }
 
-static void BM_TensorTensorProduct(benchmark::State& state) {
-    Tensor a = Tensor({ M, M }).applyFunction([](float) { return randNormalDistribution(); });
-    Tensor b = Tensor({ M, M }).applyFunction([](float) { return randNormalDistribution(); });
+static void BM_TensorDotProductTransposedFirst(benchmark::State& state) {
+    uint32_t m = state.range(0);
+    Tensor a = randomTensor({ m, m });
+    Tensor b = randomTensor({ m, m });
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
-        Tensor c = a.tensorProduct(b);
+        Tensor c = a.dotProduct(b, true, false);
     }
+
+    setCounters(state, double(m) * m, 3.0 * m * m * FLOAT_BYTES, 2.0 * m * m * m);
 }
 
-static void BM_TensorAddition(benchmark::State& state) {
-    Tensor a = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
-    Tensor b = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
+static void BM_TensorTranspose(benchmark::State& state) {
+    uint32_t m = state.range(0);
+    Tensor a = randomTensor({ m, m });
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
-        Tensor c = a + b;
+        Tensor b = a.transpose();
     }
+
+    setCounters(state, double(m) * m, 2.0 * m * m * FLOAT_BYTES, 0.0);
 }
 
-static void BM_TensorSubtraction(benchmark::State& state) {
-    Tensor a = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
-    Tensor b = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
+static void BM_TensorTransposeInPlace(benchmark::State& state) {
+    uint32_t m = state.range(0);
+    Tensor a = randomTensor({ m, m });
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
-        Tensor c = a - b;
+        a.transposeInPlace();
     }
+
+    setCounters(state, double(m) * m, 2.0 * m * m * FLOAT_BYTES, 0.0);
 }
 
-static void BM_TensorMultiplication(benchmark::State& state) {
-    Tensor a = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
-    Tensor b = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
+static void BM_TensorPermute(benchmark::State& state) {
+    uint32_t m = state.range(0);
+    Tensor a = randomTensor({ m, m, m });
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
-        Tensor c = a * b;
+        Tensor b = a.permute({ 2, 0, 1 });
     }
+
+    setCounters(state, double(m) * m * m, 2.0 * m * m * m * FLOAT_BYTES, 0.0);
 }
 
-static void BM_TensorDivision(benchmark::State& state) {
-    Tensor a = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
-    Tensor b = Tensor({ N }).applyFunction([](float) { float val = randNormalDistribution(); return val != 0 ? val : .25f; });
+static void conv2DCounters(benchmark::State& state, uint32_t size, uint32_t channels, uint32_t filters, uint32_t filter_size) {
+    double out_size = size - filter_size + 1;
+    double outputs = out_size * out_size * filters;
+    double bytes = (double(size) * size * channels + filter_size * filter_size * channels * filters + outputs) * FLOAT_BYTES;
+
+    // direct convolution operations, so algorithms with fewer multiplications show higher rates
+    setCounters(state, outputs, bytes, 2.0 * outputs * filter_size * filter_size * channels);
+}
+
+static void BM_TensorConv2D3x3(benchmark::State& state) {
+    uint32_t size = state.range(0);
+    uint32_t channels = state.range(1);
+    uint32_t filters = state.range(2);
+    Tensor a = randomTensor({ size, size, channels });
+    Tensor b = randomTensor({ 3, 3, channels, filters });
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
-        Tensor c = a / b;
+        Tensor c = a.Conv2D(b);
     }
+
+    conv2DCounters(state, size, channels, filters, 3);
 }
 
-static void BM_TensorCompare(benchmark::State& state) {
-    Tensor a = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
-    Tensor b = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
+static void BM_TensorConv2DIm2col3x3(benchmark::State& state) {
+    uint32_t size = state.range(0);
+    uint32_t channels = state.range(1);
+    uint32_t filters = state.range(2);
+    Tensor a = randomTensor({ size, size, channels });
+    Tensor b = randomTensor({ 3, 3, channels, filters });
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
-        Tensor c = a < b;
+        Tensor c = a.Conv2DIm2col(b);
     }
+
+    conv2DCounters(state, size, channels, filters, 3);
 }
 
-static void BM_TensorAdditionScalar(benchmark::State& state) {
-    Tensor a = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
-    float b = randNormalDistribution();
+static void BM_TensorConv2DWinograd3x3(benchmark::State& state) {
+    uint32_t size = state.range(0);
+    uint32_t channels = state.range(1);
+    uint32_t filters = state.range(2);
+    Tensor a = randomTensor({ size, size, channels });
+    Tensor b = Tensor::winogradFilter(randomTensor({ 3, 3, channels, filters }));
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
-        Tensor c = a + b;
+        Tensor c = a.Conv2DWinograd(b);
     }
+
+    conv2DCounters(state, size, channels, filters, 3);
 }
 
-static void BM_TensorSubtractionScalar(benchmark::State& state) {
-    Tensor a = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
-    float b = randNormalDistribution();
+static void BM_TensorConv2D5x5(benchmark::State& state) {
+    uint32_t size = state.range(0);
+    uint32_t channels = state.range(1);
+    uint32_t filters = state.range(2);
+    Tensor a = randomTensor({ size, size, channels });
+    Tensor b = randomTensor({ 5, 5, channels, filters });
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
-        Tensor c = a - b;
+        Tensor c = a.Conv2D(b);
     }
+
+    conv2DCounters(state, size, channels, filters, 5);
 }
 
-static void BM_TensorMultiplicationScalar(benchmark::State& state) {
-    Tensor a = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
-    float b = randNormalDistribution();
+static void BM_TensorTensorProduct(benchmark::State& state) {
+    uint32_t m = state.range(0);
+    Tensor a = randomTensor({ m, m });
+    Tensor b = randomTensor({ m, m });
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
-        Tensor c = a * b;
+        Tensor c = a.tensorProduct(b);
     }
+
+    double outputs = double(m) * m * m * m;
+    setCounters(state, outputs, (outputs + 2.0 * m * m) * FLOAT_BYTES, outputs);
 }
 
-static void BM_TensorDivisionScalar(benchmark::State& state) {
-    Tensor a = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
+template <typename Op>
+static void binaryOperationBenchmark(benchmark::State& state, const std::vector<uint32_t>& shape_a, const std::vector<uint32_t>& shape_b, Op op) {
+    Tensor a = randomTensor(shape_a);
+    Tensor b = randomTensor(shape_b).applyFunction([](float value) { return value != 0.0f ? value : 0.25f; });
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor c = op(a, b);
+    }
+
+    double n = a.getSize();
+    setCounters(state, n, (2.0 * n + b.getSize()) * FLOAT_BYTES, n);
+}
+
+static void BM_TensorAddition(benchmark::State& state) {
+    binaryOperationBenchmark(state, { uint32_t(state.range(0)) }, { uint32_t(state.range(0)) }, [](const Tensor& a, const Tensor& b) { return a + b; });
+}
+
+static void BM_TensorAdditionRepeated(benchmark::State& state) {
+    binaryOperationBenchmark(state, { uint32_t(state.range(0)), uint32_t(state.range(1)) }, { uint32_t(state.range(1)) }, [](const Tensor& a, const Tensor& b) { return a + b; });
+}
+
+static void BM_TensorAdditionBroadcastColumn(benchmark::State& state) {
+    binaryOperationBenchmark(state, { uint32_t(state.range(0)), uint32_t(state.range(1)) }, { uint32_t(state.range(0)), 1 }, [](const Tensor& a, const Tensor& b) { return a + b; });
+}
+
+static void BM_TensorMultiplicationBroadcastChannels(benchmark::State& state) {
+    uint32_t batch = state.range(0);
+    uint32_t channels = state.range(1);
+    binaryOperationBenchmark(state, { batch, 32, 32, channels }, { batch, 1, 1, channels }, [](const Tensor& a, const Tensor& b) { return a * b; });
+}
+
+static void BM_TensorSubtraction(benchmark::State& state) {
+    binaryOperationBenchmark(state, { uint32_t(state.range(0)) }, { uint32_t(state.range(0)) }, [](const Tensor& a, const Tensor& b) { return a - b; });
+}
+
+static void BM_TensorMultiplication(benchmark::State& state) {
+    binaryOperationBenchmark(state, { uint32_t(state.range(0)) }, { uint32_t(state.range(0)) }, [](const Tensor& a, const Tensor& b) { return a * b; });
+}
+
+static void BM_TensorDivision(benchmark::State& state) {
+    binaryOperationBenchmark(state, { uint32_t(state.range(0)) }, { uint32_t(state.range(0)) }, [](const Tensor& a, const Tensor& b) { return a / b; });
+}
+
+static void BM_TensorCompare(benchmark::State& state) {
+    binaryOperationBenchmark(state, { uint32_t(state.range(0)) }, { uint32_t(state.range(0)) }, [](const Tensor& a, const Tensor& b) { return a < b; });
+}
+
+template <typename Op>
+static void scalarOperationBenchmark(benchmark::State& state, Op op) {
+    uint32_t n = state.range(0);
+    Tensor a = randomTensor({ n });
     float b = randNormalDistribution();
     if (b == 0) {
         b = .25f;
     }
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
-        Tensor c = a / b;
+        Tensor c = op(a, b);
     }
+
+    setCounters(state, n, 2.0 * n * FLOAT_BYTES, n);
 }
 
-static void BM_TensorCompareScalar(benchmark::State& state) {
-    Tensor a = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
-    float b = randNormalDistribution();
+static void BM_TensorAdditionScalar(benchmark::State& state) {
+    scalarOperationBenchmark(state, [](const Tensor& a, float b) { return a + b; });
+}
 
-    for (auto _ : state) {
-        Tensor c = a < b;
-    }
+static void BM_TensorSubtractionScalar(benchmark::State& state) {
+    scalarOperationBenchmark(state, [](const Tensor& a, float b) { return a - b; });
+}
+
+static void BM_TensorMultiplicationScalar(benchmark::State& state) {
+    scalarOperationBenchmark(state, [](const Tensor& a, float b) { return a * b; });
+}
+
+static void BM_TensorDivisionScalar(benchmark::State& state) {
+    scalarOperationBenchmark(state, [](const Tensor& a, float b) { return a / b; });
+}
+
+static void BM_TensorCompareScalar(benchmark::State& state) {
+    scalarOperationBenchmark(state, [](const Tensor& a, float b) { return a < b; });
 }
 
 static void BM_TensorSum(benchmark::State& state) {
-    Tensor a = Tensor({ N }).applyFunction([](float) { return randNormalDistribution(); });
+    uint32_t n = state.range(0);
+    ThreadsCountScope threads(state.range(1));
+    Tensor a = randomTensor({ n });
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
         float b = a.sum();
-        (void)b;
+        benchmark::DoNotOptimize(b);
     }
+
+    setCounters(state, n, n * FLOAT_BYTES, n);
 }
 
 static void BM_TensorRowSum(benchmark::State& state) {
-    Tensor a = Tensor({ M, M }).applyFunction([](float) { return randNormalDistribution(); });
+    uint32_t m = state.range(0);
+    Tensor a = randomTensor({ m, m });
 
+    HardwareCountersScope hardware_counters(state);
     for (auto _ : state) {
         Tensor b = a.sum(0);
     }
+
+    setCounters(state, double(m) * m, double(m) * m * FLOAT_BYTES, double(m) * m);
+}
+
+static void BM_TensorSumAxes(benchmark::State& state) {
+    uint32_t batch = state.range(0);
+    ThreadsCountScope threads(state.range(1));
+    Tensor a = randomTensor({ batch, 32, 32, 16 });
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor b = a.sum({ 0, 1, 2 });
+    }
+
+    setCounters(state, a.getSize(), a.getSize() * FLOAT_BYTES, a.getSize());
+}
+
+static void BM_TensorMax(benchmark::State& state) {
+    uint32_t n = state.range(0);
+    ThreadsCountScope threads(state.range(1));
+    Tensor a = randomTensor({ n });
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        float b = a.max();
+        benchmark::DoNotOptimize(b);
+    }
+
+    setCounters(state, n, n * FLOAT_BYTES, n);
 }
 
-BENCHMARK(BM_Tensor1D1DDotProduct);
-BENCHMARK(BM_Tensor2D1DDotProduct);
-BENCHMARK(BM_Tensor2D2DDotProduct);
+static void BM_TensorVarianceAxes(benchmark::State& state) {
+    uint32_t batch = state.range(0);
+    ThreadsCountScope threads(state.range(1));
+    Tensor a = randomTensor({ batch, 32, 32, 16 });
+
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor b = a.variance({ 0, 1, 2 });
+    }
 
-BENCHMARK(BM_TensorDotProductTranspose);
+    // mean pass and squared deviations pass
+    setCounters(state, a.getSize(), 2.0 * a.getSize() * FLOAT_BYTES, 4.0 * a.getSize());
+}
 
-BENCHMARK(BM_TensorTensorProduct);
+static void BM_TensorArgmax(benchmark::State& state) {
+    uint32_t n = state.range(0);
+    ThreadsCountScope threads(state.range(1));
+    Tensor a = randomTensor({ n, 10 });
 
-BENCHMARK(BM_TensorAddition);
-BENCHMARK(BM_TensorSubtraction);
-BENCHMARK(BM_TensorMultiplication);
-BENCHMARK(BM_TensorDivision);
-BENCHMARK(BM_TensorCompare);
+    HardwareCountersScope hardware_counters(state);
+    for (auto _ : state) {
+        Tensor b = a.argmax(1);
+    }
 
-BENCHMARK(BM_TensorAdditionScalar);
-BENCHMARK(BM_TensorSubtractionScalar);
-BENCHMARK(BM_TensorMultiplicationScalar);
-BENCHMARK(BM_TensorDivisionScalar);
-BENCHMARK(BM_TensorCompareScalar);
+    setCounters(state, n, (n * 10.0 + n) * FLOAT_BYTES, n * 10.0);
+}
 
-BENCHMARK(BM_TensorSum);
-BENCHMARK(BM_TensorRowSum);
\ No newline at end of file
+BENCHMARK(BM_Tensor1D1DDotProduct)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)->ArgName("n");
+BENCHMARK(BM_Tensor2D1DDotProduct)->ArgsProduct({ { 64, 512 }, { 1 << 10, 1 << 14 } })->ArgNames({ "m", "n" });
+BENCHMARK(BM_Tensor2D2DDotProduct)->RangeMultiplier(2)->Range(32, 256)->ArgName("m");
+
+BENCHMARK(BM_TensorDotProductTranspose)->RangeMultiplier(2)->Range(32, 256)->ArgName("m");
+BENCHMARK(BM_TensorDotProductTransposedFirst)->RangeMultiplier(2)->Range(32, 256)->ArgName("m");
+
+BENCHMARK(BM_TensorTranspose)->RangeMultiplier(4)->Range(64, 2048)->ArgName("m");
+BENCHMARK(BM_TensorTransposeInPlace)->RangeMultiplier(4)->Range(64, 2048)->ArgName("m");
+BENCHMARK(BM_TensorPermute)->RangeMultiplier(2)->Range(16, 128)->ArgName("m");
+
+BENCHMARK(BM_TensorConv2D3x3)->ArgsProduct({ { 16, 32, 64 }, { 3, 16, 32 }, { 16, 64 } })->ArgNames({ "size", "channels", "filters" });
+BENCHMARK(BM_TensorConv2DIm2col3x3)->ArgsProduct({ { 16, 32, 64 }, { 3, 16, 32 }, { 16, 64 } })->ArgNames({ "size", "channels", "filters" });
+BENCHMARK(BM_TensorConv2DWinograd3x3)->ArgsProduct({ { 16, 32, 64 }, { 3, 16, 32 }, { 16, 64 } })->ArgNames({ "size", "channels", "filters" });
+BENCHMARK(BM_TensorConv2D5x5)->ArgsProduct({ { 16, 32 }, { 3, 16 }, { 16, 64 } })->ArgNames({ "size", "channels", "filters" });
+
+BENCHMARK(BM_TensorTensorProduct)->RangeMultiplier(2)->Range(16, 64)->ArgName("m");
+
+BENCHMARK(BM_TensorAddition)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->ArgName("n");
+BENCHMARK(BM_TensorAdditionRepeated)->ArgsProduct({ { 16, 256 }, { 1 << 10, 1 << 14 } })->ArgNames({ "m", "n" });
+BENCHMARK(BM_TensorAdditionBroadcastColumn)->ArgsProduct({ { 1 << 10, 1 << 14 }, { 16, 256 } })->ArgNames({ "m", "n" });
+BENCHMARK(BM_TensorMultiplicationBroadcastChannels)->ArgsProduct({ { 1, 10 }, { 3, 16, 64 } })->ArgNames({ "batch", "channels" });
+BENCHMARK(BM_TensorSubtraction)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->ArgName("n");
+BENCHMARK(BM_TensorMultiplication)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->ArgName("n");
+BENCHMARK(BM_TensorDivision)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->ArgName("n");
+BENCHMARK(BM_TensorCompare)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->ArgName("n");
+
+BENCHMARK(BM_TensorAdditionScalar)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->ArgName("n");
+BENCHMARK(BM_TensorSubtractionScalar)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->ArgName("n");
+BENCHMARK(BM_TensorMultiplicationScalar)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->ArgName("n");
+BENCHMARK(BM_TensorDivisionScalar)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->ArgName("n");
+BENCHMARK(BM_TensorCompareScalar)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->ArgName("n");
+
+BENCHMARK(BM_TensorSum)->ArgsProduct({ { 1 << 14, 1 << 18, 1 << 22 }, THREADS_COUNTS })->ArgNames({ "n", "threads" })->UseRealTime();
+BENCHMARK(BM_TensorRowSum)->RangeMultiplier(4)->Range(64, 1024)->ArgName("m");
+BENCHMARK(BM_TensorSumAxes)->ArgsProduct({ { 1, 10, 32 }, THREADS_COUNTS })->ArgNames({ "batch", "threads" })->UseRealTime();
+BENCHMARK(BM_TensorMax)->ArgsProduct({ { 1 << 14, 1 << 18, 1 << 22 }, THREADS_COUNTS })->ArgNames({ "n", "threads" })->UseRealTime();
+BENCHMARK(BM_TensorVarianceAxes)->ArgsProduct({ { 1, 10, 32 }, THREADS_COUNTS })->ArgNames({ "batch", "threads" })->UseRealTime();
+BENCHMARK(BM_TensorArgmax)->ArgsProduct({ { 1 << 10, 1 << 16 }, THREADS_COUNTS })->ArgNames({ "n", "threads" })->UseRealTime();
\ No newline at end of file
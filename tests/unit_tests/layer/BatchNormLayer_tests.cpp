@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "src/BatchNormLayer.h"
+#include "tests/unit_tests/UnitTestsUtils.h"
+
+static void channelMoments(const Tensor& tensor, uint32_t channels, std::vector<double>& mean, std::vector<double>& variance) {
+    uint32_t rows = tensor.getSize() / channels;
+    mean.assign(channels, 0.0);
+    variance.assign(channels, 0.0);
+    for (uint32_t i = 0; i < rows; ++i) {
+        for (uint32_t ch = 0; ch < channels; ++ch) {
+            mean[ch] += tensor.getDataPtr()[i * channels + ch] / rows;
+        }
+    }
+    for (uint32_t i = 0; i < rows; ++i) {
+        for (uint32_t ch = 0; ch < channels; ++ch) {
+            double d = tensor.getDataPtr()[i * channels + ch] - mean[ch];
+            variance[ch] += d * d / rows;
+        }
+    }
+}
+
+TEST(BatchNormLayer_test, BatchNormLayerOutputShapeTest) {
+    Tensor tensor = Tensor({ 2, 3, 4, 5 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    BatchNormLayer layer = BatchNormLayer({ 3, 4, 5 });
+
+    layer.initCachedGradient();
+    Tensor result = layer.forwardPropagation(tensor);
+    Tensor result_d = layer.backwardPropagation(result);
+
+    ASSERT_EQ(tensor.getShape(), result.getShape());
+    ASSERT_EQ(tensor.getShape(), result_d.getShape());
+    ASSERT_EQ(2u * 5u, layer.getParamsCount());
+}
+
+TEST(BatchNormLayer_test, TrainingOutputShouldBeNormalizedPerChannel) {
+    const uint32_t channels = 5;
+    std::vector<float> gamma = { 1.0f, 2.0f, 0.5f, 1.5f, 3.0f };
+    std::vector<float> beta = { 0.0f, -1.0f, 0.5f, 2.0f, 0.1f };
+
+    // NHWC and flat inputs, large offsets check the single pass variance does not cancel out
+    for (std::vector<uint32_t> shape : { std::vector<uint32_t>({ 4, 3, 3, channels }), std::vector<uint32_t>({ 32, channels }) }) {
+        Tensor tensor = Tensor(shape);
+        for (uint32_t i = 0; i < tensor.getSize(); ++i) {
+            tensor.getDataPtr()[i] = 100.0f * (i % channels) + randUniform(-1.0f, 1.0f) * (1 + i % channels);
+        }
+        std::vector<uint32_t> input_shape(shape.begin() + 1, shape.end());
+        BatchNormLayer layer = BatchNormLayer(input_shape, 0.99f, 1e-6f);
+        layer.setGamma(gamma);
+        layer.setBeta(beta);
+
+        Tensor result = layer.forwardPropagation(tensor);
+
+        std::vector<double> mean, variance;
+        channelMoments(result, channels, mean, variance);
+        for (uint32_t ch = 0; ch < channels; ++ch) {
+            ASSERT_NEAR(beta[ch], mean[ch], 1e-3);
+            ASSERT_NEAR(gamma[ch] * gamma[ch], variance[ch], 1e-2 * gamma[ch] * gamma[ch]);
+        }
+    }
+}
+
+TEST(BatchNormLayer_test, BackwardPropagationShouldMatchNumericGradient) {
+    const uint32_t channels = 3;
+    Tensor x = Tensor({ 4, 2, 1, channels }).applyFunction([](float) { return randUniform(-2.0f, 2.0f); });
+    Tensor weights = Tensor(x.getShape()).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    BatchNormLayer layer = BatchNormLayer({ 2, 1, channels }, 0.99f, 1e-3f);
+    layer.setGamma({ 1.5f, -0.5f, 2.0f });
+    layer.setBeta({ 0.1f, 0.2f, 0.3f });
+
+    // loss is a weighted sum of outputs, its gradient with respect to outputs are the weights
+    auto loss = [&](const Tensor& input) {
+        Tensor y = layer.forwardPropagation(input);
+        double result = 0.0;
+        for (uint32_t i = 0; i < y.getSize(); ++i) {
+            result += double(y.getDataPtr()[i]) * weights.getDataPtr()[i];
+        }
+        return result;
+    };
+
+    layer.initCachedGradient();
+    layer.forwardPropagation(x);
+    Tensor result = layer.backwardPropagation(weights);
+
+    const float h = 1e-2f;
+    for (uint32_t i = 0; i < x.getSize(); ++i) {
+        Tensor x_plus = Tensor(x);
+        Tensor x_minus = Tensor(x);
+        x_plus.getDataPtr()[i] += h;
+        x_minus.getDataPtr()[i] -= h;
+        double expected = (loss(x_plus) - loss(x_minus)) / (2.0 * h);
+        ASSERT_NEAR(expected, result.getDataPtr()[i], 2e-2);
+    }
+}
+
+TEST(BatchNormLayer_test, RunningStatisticsShouldUpdateOncePerBackwardPropagation) {
+    const uint32_t channels = 4;
+    const float epsilon = 1e-3f;
+    Tensor x = Tensor({ 8, channels }).applyFunction([](float) { return randUniform(-1.0f, 3.0f); });
+    BatchNormLayer layer = BatchNormLayer({ channels }, 0.5f, epsilon);
+
+    std::vector<double> mean, variance;
+    channelMoments(x, channels, mean, variance);
+
+    // recomputed forward propagation, e.g. by gradient checkpointing, is not counted twice
+    layer.initCachedGradient();
+    Tensor y = layer.forwardPropagation(x);
+    layer.forwardPropagation(x);
+    layer.backwardPropagation(y);
+
+    Tensor scale, shift;
+    ASSERT_TRUE(layer.getFoldableScaleShift(scale, shift));
+    for (uint32_t ch = 0; ch < channels; ++ch) {
+        float s = scale.getDataPtr()[ch];
+        ASSERT_NEAR(0.5 * mean[ch], -shift.getDataPtr()[ch] / s, 1e-4);
+        ASSERT_NEAR(0.5 + 0.5 * variance[ch], 1.0f / (s * s) - epsilon, 1e-4);
+    }
+
+    // inference applies running statistics, folded layer passes values through
+    Tensor result;
+    layer.infer(x, result);
+    for (uint32_t i = 0; i < x.getSize(); ++i) {
+        uint32_t ch = i % channels;
+        ASSERT_NEAR(x.getDataPtr()[i] * scale.getDataPtr()[ch] + shift.getDataPtr()[ch], result.getDataPtr()[i], 1e-5f);
+    }
+    layer.setPassThrough(true);
+    layer.infer(x, result);
+    ASSERT_EQ(x.getData(), result.getData());
+}
\ No newline at end of file
@@ -126,4 +126,176 @@ TEST(Conv2DLayer_test, Conv2DLayerForwardPropagationReturnValuesTest) {
     ASSERT_EQ_EPS( 11.5f, backward.getValue({ 0, 2, 2, 1 }));
     ASSERT_EQ_EPS( -3.0f, backward.getValue({ 0, 2, 3, 0 }));
     ASSERT_EQ_EPS( -1.0f, backward.getValue({ 0, 2, 3, 1 }));
+}
+
+TEST(Conv2DLayer_test, Conv2DLayerQuantizedForwardPropagationShouldBeCloseToFloat) {
+    Tensor tensor = Tensor({ 2, 5, 5, 2 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    Conv2DLayer layer = Conv2DLayer({ 5, 5, 2 }, 3, 3);
+
+    std::vector<float> weights(3 * 3 * 2 * 3);
+    for (auto& w : weights) {
+        w = randUniform(-1.0f, 1.0f);
+    }
+    layer.setWeights(weights);
+
+    Tensor expected = layer.forwardPropagation(tensor);
+
+    layer.quantize(tensor);
+
+    Tensor result = layer.forwardPropagation(tensor);
+    std::vector<float> expected_data = expected.getData();
+    std::vector<float> result_data = result.getData();
+
+    ASSERT_EQ(expected_data.size(), result_data.size());
+    for (uint32_t i = 0; i < expected_data.size(); ++i) {
+        ASSERT_LE(fabs(expected_data[i] - result_data[i]), 0.1f);
+    }
+}
+
+TEST(Conv2DLayer_test, Conv2DLayerAlgorithmsShouldMatchDirectConvolution) {
+    for (uint32_t filter_size : { 3, 5 }) {
+        Tensor tensor = Tensor({ 2, 9, 7, 4 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+        Conv2DLayer layer = Conv2DLayer({ 9, 7, 4 }, 11, filter_size);
+
+        std::vector<float> weights(filter_size * filter_size * 4 * 11);
+        for (auto& weight : weights) {
+            weight = randUniform(-1.0f, 1.0f);
+        }
+        layer.setWeights(weights);
+
+        layer.setAlgorithm(ConvAlgorithm::Direct);
+        Tensor expected = layer.forwardPropagation(tensor);
+
+        for (ConvAlgorithm algorithm : { ConvAlgorithm::Im2col, ConvAlgorithm::Winograd, ConvAlgorithm::FFT, ConvAlgorithm::Auto }) {
+            layer.setAlgorithm(algorithm);
+            Tensor result = layer.forwardPropagation(tensor);
+
+            ASSERT_EQ(expected.getShape(), result.getShape());
+            for (uint32_t i = 0; i < expected.getSize(); ++i) {
+                ASSERT_NEAR(expected.getDataPtr()[i], result.getDataPtr()[i], 1e-4f);
+            }
+        }
+    }
+}
+
+TEST(Conv2DLayer_test, Conv2DLayerStridedShouldMatchSubsampledUnitStride) {
+    // a strided convolution is the unit stride one sampled every stride pixels, gradients flow only through the samples
+    for (uint32_t dilation : { 1, 2 }) {
+        Conv2DParams params_1 = { 1, dilation, ConvPadding::Explicit, 2, 1 };
+        Conv2DParams params_2 = { 2, dilation, ConvPadding::Explicit, 2, 1 };
+        Conv2DLayer layer_1 = Conv2DLayer({ 9, 8, 3 }, 5, 3, params_1);
+        Conv2DLayer layer_2 = Conv2DLayer({ 9, 8, 3 }, 5, 3, params_2);
+
+        std::vector<float> weights(3 * 3 * 3 * 5);
+        for (auto& weight : weights) {
+            weight = randUniform(-1.0f, 1.0f);
+        }
+        std::vector<float> biases = { 0.1f, -0.2f, 0.3f, -0.4f, 0.5f };
+        for (Conv2DLayer* layer : { &layer_1, &layer_2 }) {
+            layer->setWeights(weights);
+            layer->setBiases(biases);
+            layer->setAlgorithm(ConvAlgorithm::Direct);
+            layer->initCachedGradient();
+        }
+
+        Tensor tensor = Tensor({ 2, 9, 8, 3 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+        Tensor result_1 = layer_1.forwardPropagation(tensor);
+        Tensor result_2 = layer_2.forwardPropagation(tensor);
+
+        std::vector<uint32_t> shape_2 = result_2.getShape();
+        ASSERT_EQ((result_1.getShape()[1] + 1) / 2, shape_2[1]);
+        ASSERT_EQ((result_1.getShape()[2] + 1) / 2, shape_2[2]);
+
+        Tensor tensor_d_1 = Tensor(result_1.getShape());
+        Tensor tensor_d_2 = Tensor(shape_2).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+        for (uint32_t n = 0; n < shape_2[0]; ++n) {
+            for (uint32_t i = 0; i < shape_2[1]; ++i) {
+                for (uint32_t j = 0; j < shape_2[2]; ++j) {
+                    for (uint32_t k = 0; k < shape_2[3]; ++k) {
+                        ASSERT_NEAR(result_1.getValue({ n, 2 * i, 2 * j, k }), result_2.getValue({ n, i, j, k }), 1e-4f);
+                        tensor_d_1.setValue(tensor_d_2.getValue({ n, i, j, k }), { n, 2 * i, 2 * j, k });
+                    }
+                }
+            }
+        }
+
+        Tensor tensor_prev_d_1 = layer_1.backwardPropagation(tensor_d_1);
+        Tensor tensor_prev_d_2 = layer_2.backwardPropagation(tensor_d_2);
+        ASSERT_EQ(tensor.getShape(), tensor_prev_d_2.getShape());
+        for (uint32_t i = 0; i < tensor.getSize(); ++i) {
+            ASSERT_NEAR(tensor_prev_d_1.getDataPtr()[i], tensor_prev_d_2.getDataPtr()[i], 1e-4f);
+        }
+
+        // equal weight and bias gradients keep the layers related after the update
+        layer_1.updateWeights(0.1f);
+        layer_2.updateWeights(0.1f);
+        result_1 = layer_1.forwardPropagation(tensor);
+        result_2 = layer_2.forwardPropagation(tensor);
+        for (uint32_t n = 0; n < shape_2[0]; ++n) {
+            for (uint32_t i = 0; i < shape_2[1]; ++i) {
+                for (uint32_t j = 0; j < shape_2[2]; ++j) {
+                    for (uint32_t k = 0; k < shape_2[3]; ++k) {
+                        ASSERT_NEAR(result_1.getValue({ n, 2 * i, 2 * j, k }), result_2.getValue({ n, i, j, k }), 1e-4f);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(Conv2DLayer_test, Conv2DLayerDilatedShouldMatchFilterWithInsertedZeros) {
+    // 3x3 filter with dilation 2 covers the same taps as a 5x5 filter with zeros between them
+    Conv2DLayer layer_dilated = Conv2DLayer({ 7, 9, 2 }, 4, 3, { 1, 2, ConvPadding::Same });
+    Conv2DLayer layer_wide = Conv2DLayer({ 7, 9, 2 }, 4, 5, { 1, 1, ConvPadding::Same });
+
+    std::vector<float> weights(3 * 3 * 2 * 4);
+    std::vector<float> weights_wide(5 * 5 * 2 * 4, 0.0f);
+    for (uint32_t i = 0; i < weights.size(); ++i) {
+        weights[i] = randUniform(-1.0f, 1.0f);
+        uint32_t kh = i / (3 * 2 * 4);
+        uint32_t kw = (i / (2 * 4)) % 3;
+        weights_wide[((2 * kh) * 5 + 2 * kw) * 2 * 4 + i % (2 * 4)] = weights[i];
+    }
+    layer_dilated.setWeights(weights);
+    layer_wide.setWeights(weights_wide);
+    layer_dilated.setBiases({ 0.0f, 0.0f, 0.0f, 0.0f });
+    layer_wide.setBiases({ 0.0f, 0.0f, 0.0f, 0.0f });
+    layer_dilated.initCachedGradient();
+    layer_wide.initCachedGradient();
+
+    Tensor tensor = Tensor({ 2, 7, 9, 2 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    Tensor expected = layer_wide.forwardPropagation(tensor);
+    Tensor result = layer_dilated.forwardPropagation(tensor);
+
+    ASSERT_EQ(std::vector<uint32_t>({ 2, 7, 9, 4 }), result.getShape());
+    for (uint32_t i = 0; i < expected.getSize(); ++i) {
+        ASSERT_NEAR(expected.getDataPtr()[i], result.getDataPtr()[i], 1e-4f);
+    }
+
+    Tensor tensor_d = Tensor(result.getShape()).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    expected = layer_wide.backwardPropagation(tensor_d);
+    result = layer_dilated.backwardPropagation(tensor_d);
+    for (uint32_t i = 0; i < expected.getSize(); ++i) {
+        ASSERT_NEAR(expected.getDataPtr()[i], result.getDataPtr()[i], 1e-4f);
+    }
+}
+
+TEST(Conv2DLayer_test, Conv2DLayerShouldSelectAlgorithmByShape) {
+    ASSERT_EQ(ConvAlgorithm::Direct, Conv2DLayer::selectAlgorithm({ 28, 28, 1 }, 4, 3));
+    ASSERT_EQ(ConvAlgorithm::Winograd, Conv2DLayer::selectAlgorithm({ 32, 32, 16 }, 32, 3));
+    ASSERT_EQ(ConvAlgorithm::Direct, Conv2DLayer::selectAlgorithm({ 32, 32, 3 }, 32, 3));
+
+    // winograd has no path for other filter sizes
+    Conv2DLayer layer = Conv2DLayer({ 16, 16, 16 }, 32, 5);
+    layer.setAlgorithm(ConvAlgorithm::Winograd);
+    ASSERT_NE(ConvAlgorithm::Winograd, layer.getAlgorithm());
+
+    // nor for strided filters
+    ASSERT_EQ(ConvAlgorithm::Direct, Conv2DLayer::selectAlgorithm({ 32, 32, 16 }, 32, 3, { 2, 1, ConvPadding::Same }));
+
+    // large filters are cheaper as products of spectra
+    ASSERT_EQ(ConvAlgorithm::FFT, Conv2DLayer::selectAlgorithm({ 64, 64, 16 }, 16, 9, { 1, 1, ConvPadding::Same }));
+    ASSERT_NE(ConvAlgorithm::FFT, Conv2DLayer::selectAlgorithm({ 64, 64, 16 }, 16, 9, { 2, 1, ConvPadding::Same }));
+    layer.setAlgorithm(ConvAlgorithm::FFT);
+    ASSERT_EQ(ConvAlgorithm::FFT, layer.getAlgorithm());
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "src/DenseLayer.h"
+#include "src/ActivationLayer.h"
 
 TEST(DenseLayer_test, DenseLayerForwardPropagationOutputShapeTest) {
     Tensor tensor = Tensor({ 2, 3, 4 });
@@ -65,4 +66,50 @@ TEST(DenseLayer_test, DenseLayerForwardAndBackwardPropagationReturnValuesTest) {
     ASSERT_LE(fabs(-23.7976f  - backward.getValue({ 1, 0 })), 0.001f);
     ASSERT_LE(fabs( 10.71966f - backward.getValue({ 1, 1 })), 0.001f);
     ASSERT_LE(fabs(-27.5218f  - backward.getValue({ 1, 2 })), 0.001f);
+}
+
+TEST(DenseLayer_test, DenseLayerQuantizedForwardPropagationShouldBeCloseToFloat) {
+    Tensor tensor = Tensor({ 8, 20 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    DenseLayer layer = DenseLayer({ 20 }, 6);
+
+    Tensor expected = layer.forwardPropagation(tensor);
+
+    layer.quantize(tensor);
+
+    Tensor result = layer.forwardPropagation(tensor);
+
+    for (uint32_t i = 0; i < 8; ++i) {
+        for (uint32_t j = 0; j < 6; ++j) {
+            ASSERT_LE(fabs(expected.getValue({ i, j }) - result.getValue({ i, j })), 0.05f);
+        }
+    }
+}
+
+TEST(DenseLayer_test, DenseLayerFusedActivationShouldMatchSeparateActivationLayer) {
+    std::vector<ActivationFun> activation_funs = { ActivationFun::Sigmoid, ActivationFun::ReLU, ActivationFun::LeakyReLU };
+
+    for (auto activation_fun : activation_funs) {
+        Tensor tensor = Tensor({ 8, 20 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+        Tensor tensor_d = Tensor({ 8, 6 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+        DenseLayer layer = DenseLayer({ 20 }, 6);
+        ActivationLayer activation_layer = ActivationLayer(layer, activation_fun);
+
+        layer.initCachedGradient();
+        Tensor expected = activation_layer.forwardPropagation(layer.forwardPropagation(tensor));
+        Tensor expected_d = layer.backwardPropagation(activation_layer.backwardPropagation(tensor_d));
+
+        layer.fuseActivation(activation_fun);
+        layer.initCachedGradient();
+        Tensor result = layer.forwardPropagation(tensor);
+        Tensor result_d = layer.backwardPropagation(tensor_d);
+
+        for (uint32_t i = 0; i < 8; ++i) {
+            for (uint32_t j = 0; j < 6; ++j) {
+                ASSERT_LE(fabs(expected.getValue({ i, j }) - result.getValue({ i, j })), 1e-5f);
+            }
+            for (uint32_t j = 0; j < 20; ++j) {
+                ASSERT_LE(fabs(expected_d.getValue({ i, j }) - result_d.getValue({ i, j })), 1e-5f);
+            }
+        }
+    }
 }
\ No newline at end of file
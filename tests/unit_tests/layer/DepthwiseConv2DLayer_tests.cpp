@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "src/DepthwiseConv2DLayer.h"
+#include "src/Conv2DLayer.h"
+#include "tests/unit_tests/UnitTestsUtils.h"
+
+TEST(DepthwiseConv2DLayer_test, DepthwiseConv2DLayerOutputShapeTest) {
+    Tensor tensor = Tensor({ 2, 7, 6, 5 });
+    DepthwiseConv2DLayer layer = DepthwiseConv2DLayer({ 7, 6, 5 }, 3, { 2, 1, ConvPadding::Same });
+
+    layer.initCachedGradient();
+    Tensor result = layer.forwardPropagation(tensor);
+    Tensor result_d = layer.backwardPropagation(result);
+
+    ASSERT_EQ(std::vector<uint32_t>({ 2, 4, 3, 5 }), result.getShape());
+    ASSERT_EQ(tensor.getShape(), result_d.getShape());
+    ASSERT_EQ(3u * 3u * 5u + 5u, layer.getParamsCount());
+}
+
+TEST(DepthwiseConv2DLayer_test, DepthwiseConv2DLayerShouldMatchSingleChannelConvolutions) {
+    // every channel is a convolution with a single input channel and a single filter, also after a training step
+    const uint32_t channels = 3;
+    for (const Conv2DParams& params : { Conv2DParams{ 1, 1, ConvPadding::Same }, Conv2DParams{ 2, 2, ConvPadding::Explicit, 1, 2 } }) {
+        DepthwiseConv2DLayer layer = DepthwiseConv2DLayer({ 8, 7, channels }, 3, params);
+        std::vector<Conv2DLayer> conv_layers;
+
+        std::vector<float> weights(3 * 3 * channels);
+        for (auto& weight : weights) {
+            weight = randUniform(-1.0f, 1.0f);
+        }
+        std::vector<float> biases = { 0.5f, -0.25f, 1.0f };
+        layer.setWeights(weights);
+        layer.setBiases(biases);
+        layer.initCachedGradient();
+
+        for (uint32_t ch = 0; ch < channels; ++ch) {
+            conv_layers.push_back(Conv2DLayer({ 8, 7, 1 }, 1, 3, params));
+            std::vector<float> channel_weights;
+            for (uint32_t i = ch; i < weights.size(); i += channels) {
+                channel_weights.push_back(weights[i]);
+            }
+            conv_layers[ch].setWeights(channel_weights);
+            conv_layers[ch].setBiases({ biases[ch] });
+            conv_layers[ch].initCachedGradient();
+        }
+
+        Tensor tensor = Tensor({ 2, 8, 7, channels }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+        Tensor result = layer.forwardPropagation(tensor);
+        Tensor tensor_d = Tensor(result.getShape()).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+        Tensor result_d = layer.backwardPropagation(tensor_d);
+        layer.updateWeights(0.1f);
+        Tensor result_updated = layer.forwardPropagation(tensor);
+
+        for (uint32_t ch = 0; ch < channels; ++ch) {
+            Tensor expected = conv_layers[ch].forwardPropagation(tensor.slice(3, ch, ch + 1));
+            Tensor expected_d = conv_layers[ch].backwardPropagation(tensor_d.slice(3, ch, ch + 1));
+            conv_layers[ch].updateWeights(0.1f);
+            Tensor expected_updated = conv_layers[ch].forwardPropagation(tensor.slice(3, ch, ch + 1));
+
+            ASSERT_EQ(expected.getShape()[1], result.getShape()[1]);
+            ASSERT_EQ(expected.getShape()[2], result.getShape()[2]);
+            for (uint32_t i = 0; i < expected.getSize(); ++i) {
+                ASSERT_NEAR(expected.getDataPtr()[i], result.getDataPtr()[i * channels + ch], 1e-4f);
+                ASSERT_NEAR(expected_updated.getDataPtr()[i], result_updated.getDataPtr()[i * channels + ch], 1e-4f);
+            }
+            for (uint32_t i = 0; i < expected_d.getSize(); ++i) {
+                ASSERT_NEAR(expected_d.getDataPtr()[i], result_d.getDataPtr()[i * channels + ch], 1e-4f);
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "src/DropoutLayer.h"
+#include "tests/unit_tests/UnitTestsUtils.h"
+
+TEST(DropoutLayer_test, DropoutLayerOutputShapeTest) {
+    Tensor tensor = Tensor({ 2, 3, 4, 5 }) + 1.0f;
+    DropoutLayer layer = DropoutLayer({ 3, 4, 5 }, 0.5f);
+
+    layer.initCachedGradient();
+    Tensor result = layer.forwardPropagation(tensor);
+    Tensor result_d = layer.backwardPropagation(result);
+
+    ASSERT_EQ(tensor.getShape(), result.getShape());
+    ASSERT_EQ(tensor.getShape(), result_d.getShape());
+    ASSERT_EQ(0u, layer.getParamsCount());
+}
+
+TEST(DropoutLayer_test, DropoutLayerShouldDropRateOfValuesAndScaleOthers) {
+    const float rate = 0.3f;
+    Tensor tensor = Tensor({ 64, 1001 }) + 2.0f;
+    DropoutLayer layer = DropoutLayer({ 1001 }, rate, 7u);
+
+    Tensor result = layer.forwardPropagation(tensor);
+
+    uint32_t dropped = 0;
+    for (uint32_t i = 0; i < result.getSize(); ++i) {
+        float value = result.getDataPtr()[i];
+        if (0.0f == value) {
+            ++dropped;
+        }
+        else {
+            ASSERT_FLOAT_EQ(2.0f / (1.0f - rate), value);
+        }
+    }
+    ASSERT_NEAR(rate, static_cast<float>(dropped) / result.getSize(), 0.01f);
+}
+
+TEST(DropoutLayer_test, DropoutLayerMaskShouldChangeOnlyAfterBackwardPropagation) {
+    Tensor tensor = Tensor({ 4, 37 }).applyFunction([](float) { return randUniform(0.5f, 1.0f); });
+    Tensor ones = Tensor({ 4, 37 }) + 1.0f;
+    DropoutLayer layer = DropoutLayer({ 37 }, 0.5f, 11u);
+    DropoutLayer same_seed_layer = DropoutLayer({ 37 }, 0.5f, 11u);
+    DropoutLayer other_seed_layer = DropoutLayer({ 37 }, 0.5f, 12u);
+
+    // forward propagation recomputed by gradient checkpointing draws the same mask
+    Tensor first = layer.forwardPropagation(tensor);
+    Tensor second = layer.forwardPropagation(tensor);
+    ASSERT_EQ(first.getData(), second.getData());
+    ASSERT_EQ(first.getData(), same_seed_layer.forwardPropagation(tensor).getData());
+    ASSERT_NE(first.getData(), other_seed_layer.forwardPropagation(tensor).getData());
+
+    // gradient goes through kept values only
+    Tensor result_d = layer.backwardPropagation(ones);
+    for (uint32_t i = 0; i < tensor.getSize(); ++i) {
+        ASSERT_EQ(0.0f == first.getDataPtr()[i], 0.0f == result_d.getDataPtr()[i]);
+    }
+
+    Tensor next = layer.forwardPropagation(tensor);
+    ASSERT_NE(first.getData(), next.getData());
+}
+
+TEST(DropoutLayer_test, DropoutLayerInferShouldPassValuesThrough) {
+    Tensor tensor = Tensor({ 3, 2, 2, 4 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    DropoutLayer layer = DropoutLayer({ 2, 2, 4 }, 0.5f);
+
+    Tensor result;
+    layer.infer(tensor, result);
+
+    ASSERT_EQ(tensor.getData(), result.getData());
+}
+TEST(DropoutLayer_test, DropoutLayerInPlaceShouldMatchForwardAndBackwardPropagation) {
+    Tensor tensor = Tensor({ 3, 300 }).applyFunction([](float) { return randUniform(0.5f, 1.0f); });
+    Tensor ones = Tensor({ 3, 300 }) + 1.0f;
+    DropoutLayer layer = DropoutLayer({ 300 }, 0.5f, 5u);
+    DropoutLayer in_place_layer = DropoutLayer({ 300 }, 0.5f, 5u);
+
+    Tensor expected = layer.forwardPropagation(tensor);
+    Tensor expected_d = layer.backwardPropagation(ones);
+
+    // mask bits are drawn again for the gradient, nothing is kept between the passes
+    Tensor result = tensor;
+    in_place_layer.forwardPropagationInPlace(result);
+    Tensor result_d = ones;
+    in_place_layer.backwardPropagationInPlace(result_d);
+
+    ASSERT_EQ(expected.getData(), result.getData());
+    ASSERT_EQ(expected_d.getData(), result_d.getData());
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "src/PointwiseConv2DLayer.h"
+#include "src/Conv2DLayer.h"
+#include "tests/unit_tests/UnitTestsUtils.h"
+
+TEST(PointwiseConv2DLayer_test, PointwiseConv2DLayerOutputShapeTest) {
+    Tensor tensor = Tensor({ 2, 3, 4, 5 });
+    PointwiseConv2DLayer layer = PointwiseConv2DLayer({ 3, 4, 5 }, 6);
+
+    layer.initCachedGradient();
+    Tensor result = layer.forwardPropagation(tensor);
+    Tensor result_d = layer.backwardPropagation(result);
+
+    ASSERT_EQ(std::vector<uint32_t>({ 2, 3, 4, 6 }), result.getShape());
+    ASSERT_EQ(tensor.getShape(), result_d.getShape());
+    ASSERT_EQ(5u * 6u + 6u, layer.getParamsCount());
+}
+
+TEST(PointwiseConv2DLayer_test, PointwiseConv2DLayerShouldMatch1x1Convolution) {
+    const uint32_t channels = 5;
+    const uint32_t filters = 7;
+    PointwiseConv2DLayer layer = PointwiseConv2DLayer({ 6, 5, channels }, filters);
+    Conv2DLayer conv_layer = Conv2DLayer({ 6, 5, channels }, filters, 1);
+
+    std::vector<float> weights(channels * filters);
+    for (auto& weight : weights) {
+        weight = randUniform(-1.0f, 1.0f);
+    }
+    std::vector<float> biases(filters);
+    for (auto& bias : biases) {
+        bias = randUniform(-1.0f, 1.0f);
+    }
+    layer.setWeights(weights);
+    layer.setBiases(biases);
+    conv_layer.setWeights(weights);
+    conv_layer.setBiases(biases);
+    layer.initCachedGradient();
+    conv_layer.initCachedGradient();
+
+    Tensor tensor = Tensor({ 3, 6, 5, channels }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    Tensor tensor_d = Tensor({ 3, 6, 5, filters }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+
+    Tensor expected = conv_layer.forwardPropagation(tensor);
+    Tensor result = layer.forwardPropagation(tensor);
+    ASSERT_EQ(expected.getShape(), result.getShape());
+    for (uint32_t i = 0; i < expected.getSize(); ++i) {
+        ASSERT_NEAR(expected.getDataPtr()[i], result.getDataPtr()[i], 1e-4f);
+    }
+
+    expected = conv_layer.backwardPropagation(tensor_d);
+    result = layer.backwardPropagation(tensor_d);
+    ASSERT_EQ(expected.getShape(), result.getShape());
+    for (uint32_t i = 0; i < expected.getSize(); ++i) {
+        ASSERT_NEAR(expected.getDataPtr()[i], result.getDataPtr()[i], 1e-4f);
+    }
+
+    // equal gradients give equal layers after the update
+    conv_layer.updateWeights(0.1f);
+    layer.updateWeights(0.1f);
+    expected = conv_layer.forwardPropagation(tensor);
+    result = layer.forwardPropagation(tensor);
+    for (uint32_t i = 0; i < expected.getSize(); ++i) {
+        ASSERT_NEAR(expected.getDataPtr()[i], result.getDataPtr()[i], 1e-4f);
+    }
+}
\ No newline at end of file
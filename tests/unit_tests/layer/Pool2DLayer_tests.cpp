@@ -207,3 +207,62 @@ TEST(Pool2DLayer_test, Pool2DLayerMaxForwardPropagationTensorWithChannels) {
     ASSERT_EQ( 19.0f, result.getValue({ 1, 1, 1, 0 }));
     ASSERT_EQ( 20.0f, result.getValue({ 1, 1, 1, 1 }));
 }
+
+
+TEST(Pool2DLayer_test, Pool2DLayerMaxPropagationWithPoolSize3) {
+    Tensor tensor = Tensor({ 1, 3, 3, 2 });
+    Tensor tensor_d = Tensor({ 1, 1, 1, 2 });
+    Pool2DLayer layer = Pool2DLayer({ 3, 3, 2 }, 3, PoolMode::Max);
+
+    tensor.setValues({
+         1.0f, 9.0f,    2.0f, 0.0f,    3.0f, 9.0f,
+         4.0f, 1.0f,    8.0f, 2.0f,    5.0f, 3.0f,
+         6.0f, 4.0f,    7.0f, 9.0f,    0.0f, 5.0f
+        });
+    tensor_d.setValues({ 4.0f, 6.0f });
+
+    Tensor result = layer.forwardPropagation(tensor);
+
+    ASSERT_EQ( 4, result.getDim());
+    ASSERT_EQ( 1, result.getShape()[1]);
+    ASSERT_EQ( 1, result.getShape()[2]);
+    ASSERT_EQ( 2, result.getShape()[3]);
+
+    ASSERT_EQ( 8.0f, result.getValue({ 0, 0, 0, 0 }));
+    ASSERT_EQ( 9.0f, result.getValue({ 0, 0, 0, 1 }));
+
+    Tensor result_d = layer.backwardPropagation(tensor_d);
+
+    ASSERT_EQ_EPS( 4.0f, result_d.getValue({ 0, 1, 1, 0 }));
+    ASSERT_EQ_EPS( 0.0f, result_d.getValue({ 0, 0, 0, 0 }));
+    ASSERT_EQ_EPS( 2.0f, result_d.getValue({ 0, 0, 0, 1 }));
+    ASSERT_EQ_EPS( 2.0f, result_d.getValue({ 0, 0, 2, 1 }));
+    ASSERT_EQ_EPS( 2.0f, result_d.getValue({ 0, 2, 1, 1 }));
+    ASSERT_EQ_EPS( 0.0f, result_d.getValue({ 0, 1, 1, 1 }));
+}
+
+TEST(Pool2DLayer_test, Pool2DLayerAveragePropagationWithPoolSize4) {
+    Tensor tensor = Tensor({ 1, 4, 4, 1 });
+    Tensor tensor_d = Tensor({ 1, 1, 1, 1 });
+    Pool2DLayer layer = Pool2DLayer({ 4, 4 }, 4, PoolMode::Average);
+
+    tensor.setValues({
+         1.0f,  2.0f,  3.0f,  4.0f,
+         5.0f,  6.0f,  7.0f,  8.0f,
+         9.0f, 10.0f, 11.0f, 12.0f,
+        13.0f, 14.0f, 15.0f, 16.0f
+        });
+    tensor_d.setValues({ 2.0f });
+
+    Tensor result = layer.forwardPropagation(tensor);
+
+    ASSERT_EQ_EPS( 8.5f, result.getValue({ 0, 0, 0, 0 }));
+
+    Tensor result_d = layer.backwardPropagation(tensor_d);
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        for (uint32_t j = 0; j < 4; ++j) {
+            ASSERT_EQ_EPS(tensor.getValue({ 0, i, j, 0 }) / 8.5f * 2.0f, result_d.getValue({ 0, i, j, 0 }));
+        }
+    }
+}
\ No newline at end of file
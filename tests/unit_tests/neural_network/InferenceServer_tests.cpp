@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "src/InferenceServer.h"
+#include "src/ActivationLayer.h"
+#include "src/DenseLayer.h"
+
+TEST(InferenceServer_test, LoopbackResultsShouldMatchPredict) {
+    auto layer_1 = DenseLayer({ 8 }, 16);
+    auto layer_2 = ActivationLayer(layer_1, ActivationFun::ReLU);
+    auto layer_3 = DenseLayer(layer_2, 3);
+    auto layer_4 = ActivationLayer(layer_3, ActivationFun::Sigmoid);
+    NeuralNetwork nn = NeuralNetwork(layer_1, layer_4, CostFun::BinaryCrossentropy);
+
+    Tensor x = Tensor({ 64, 8 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    Tensor expected = nn.predict(x);
+
+    std::vector<std::future<Tensor> > futures(64);
+    {
+        InferenceServer server = InferenceServer(nn, 8, 2000, 2);
+        std::vector<std::thread> clients;
+
+        for (uint32_t c = 0; c < 4; ++c) {
+            clients.emplace_back([&, c]() {
+                for (uint32_t i = c; i < 64; i += 4) {
+                    futures[i] = server.submit(x.getSubTensor(std::vector<uint32_t>{ i, WHOLE_AXIS }));
+                }
+            });
+        }
+        for (auto& client : clients) {
+            client.join();
+        }
+
+        for (uint32_t i = 0; i < 64; ++i) {
+            Tensor y = futures[i].get();
+            ASSERT_EQ(1, (int)y.getDim());
+            ASSERT_EQ(3, (int)y.getShape()[0]);
+            for (uint32_t j = 0; j < 3; ++j) {
+                ASSERT_NEAR(expected.getValue({ i, j }), y.getValue({ j }), 1e-5f);
+            }
+        }
+
+        InferenceServerStats stats = server.getStats();
+        ASSERT_EQ(64u, stats.requests_count);
+        ASSERT_EQ(0u, stats.queue_depth);
+        ASSERT_GE(stats.batches_count, 8u);
+        ASSERT_LE(stats.p50_latency_ms, stats.p99_latency_ms);
+    }
+}
+
+TEST(InferenceServer_test, FullBatchShouldNotWaitForDeadline) {
+    auto layer_1 = DenseLayer({ 4 }, 2);
+    NeuralNetwork nn = NeuralNetwork(layer_1, layer_1, CostFun::BinaryCrossentropy);
+    InferenceServer server = InferenceServer(nn, 4, 10000000, 1);
+
+    std::vector<std::future<Tensor> > futures;
+    for (uint32_t i = 0; i < 4; ++i) {
+        futures.push_back(server.submit(Tensor({ 4 })));
+    }
+
+    for (auto& future : futures) {
+        ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(5)));
+    }
+
+    InferenceServerStats stats = server.getStats();
+    ASSERT_EQ(1u, stats.batches_count);
+    ASSERT_EQ(4u, stats.last_batch_size);
+}
+
+TEST(InferenceServer_test, PartialBatchShouldRunAfterDeadline) {
+    auto layer_1 = DenseLayer({ 4 }, 2);
+    NeuralNetwork nn = NeuralNetwork(layer_1, layer_1, CostFun::BinaryCrossentropy);
+    InferenceServer server = InferenceServer(nn, 32, 1000, 1);
+
+    std::future<Tensor> future = server.submit(Tensor({ 4 }));
+
+    ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(5)));
+    ASSERT_EQ(2, (int)future.get().getShape()[0]);
+    ASSERT_EQ(1u, server.getStats().last_batch_size);
+}
+
+TEST(InferenceServer_test, SubmitWithWrongSampleSizeShouldThrow) {
+    auto layer_1 = DenseLayer({ 4 }, 2);
+    NeuralNetwork nn = NeuralNetwork(layer_1, layer_1, CostFun::BinaryCrossentropy);
+    InferenceServer server = InferenceServer(nn, 4, 1000, 1);
+
+    ASSERT_THROW(server.submit(Tensor({ 5 })), std::invalid_argument);
+}
\ No newline at end of file
@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
+#include <memory>
+#include <thread>
 #include "src/NeuralNetwork.h"
 #include "src/ActivationLayer.h"
 #include "src/DenseLayer.h"
+#include "src/Conv2DLayer.h"
+#include "src/Pool2DLayer.h"
+#include "src/BatchNormLayer.h"
+#include "src/DropoutLayer.h"
 
 TEST(NeuralNetwork_test, BinaryCrossentropyTest) {
     Tensor y = Tensor({ 2, 2 });
@@ -59,7 +65,11 @@ TEST(NeuralNetwork_test, PredictShouldReturnTensor) {
     ASSERT_EQ(   1.0f, result.getValue({ 1, 1 }));
 }
 
-TEST(NeuralNetwork_test, FitShouldDecreaseCost) {
+// mixed precision keeps fp32 master weights, training in 16 bits should still decrease cost
+class FitPrecision_test : public testing::TestWithParam<DataType> {
+};
+
+TEST_P(FitPrecision_test, FitShouldDecreaseCost) {
     auto x_train = Tensor({ 512, 2 });
     auto y_train = Tensor({ 512, 2 });
     auto x_test = Tensor({ 32, 2 });
@@ -106,11 +116,479 @@ TEST(NeuralNetwork_test, FitShouldDecreaseCost) {
 
     float cost_1 = nn.getCostFun()(y_hat, y_test);
 
-    nn.fit(x_train, y_train, x_test, y_test, 32, 10, 0.01f, 0);
+    nn.fit(x_train, y_train, x_test, y_test, 32, 10, 0.01f, 0, GetParam());
 
     y_hat = nn.predict(x_test);
 
     float cost_2 = nn.getCostFun()(y_hat, y_test);
 
     ASSERT_TRUE(cost_2 < cost_1);
-}
\ No newline at end of file
+}
+
+INSTANTIATE_TEST_SUITE_P(NeuralNetwork_test, FitPrecision_test, testing::Values(DataType::Float32, DataType::BFloat16, DataType::Float16),
+    [](const testing::TestParamInfo<DataType>& info) {
+        switch (info.param) {
+        case DataType::BFloat16: return std::string("BFloat16");
+        case DataType::Float16: return std::string("Float16");
+        default: return std::string("Float32");
+        }
+    });
+
+TEST(NeuralNetwork_test, QuantizedPredictShouldBeCloseToFloatPredict) {
+    auto x = Tensor({ 64, 8 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    // calibration sample from the same distribution, evaluated inputs are not seen by quantize
+    auto calibration_x = Tensor({ 64, 8 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+
+    auto layer_1 = DenseLayer({ 8 }, 32);
+    auto layer_2 = ActivationLayer(layer_1, ActivationFun::LeakyReLU);
+    auto layer_3 = DenseLayer(layer_2, 4);
+    auto layer_4 = ActivationLayer(layer_3, ActivationFun::Sigmoid);
+
+    auto nn = NeuralNetwork(layer_1, layer_4, CostFun::BinaryCrossentropy);
+
+    Tensor expected = nn.predict(x);
+
+    nn.quantize(calibration_x);
+
+    Tensor result = nn.predict(x);
+
+    for (uint32_t i = 0; i < 64; ++i) {
+        for (uint32_t j = 0; j < 4; ++j) {
+            ASSERT_LE(fabs(expected.getValue({ i, j }) - result.getValue({ i, j })), 0.05f);
+        }
+    }
+}
+
+TEST(NeuralNetwork_test, FusedLayersShouldPredictSameAsSeparateLayers) {
+    auto x = Tensor({ 16, 8 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+
+    auto layer_1 = DenseLayer({ 8 }, 32);
+    auto layer_2 = ActivationLayer(layer_1, ActivationFun::ReLU);
+    auto layer_3 = DenseLayer(layer_2, 4);
+    auto layer_4 = ActivationLayer(layer_3, ActivationFun::Sigmoid);
+
+    auto nn = NeuralNetwork(layer_1, layer_4, CostFun::BinaryCrossentropy);
+
+    Tensor fused = nn.predict(x);
+
+    nn.setLayersFusion(false);
+
+    Tensor expected = nn.predict(x);
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        for (uint32_t j = 0; j < 4; ++j) {
+            ASSERT_LE(fabs(expected.getValue({ i, j }) - fused.getValue({ i, j })), 1e-5f);
+        }
+    }
+}
+
+TEST(NeuralNetwork_test, PredictWithContextShouldMatchPredict) {
+    auto x = Tensor({ 4, 6, 6, 2 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+
+    auto layer_1 = Conv2DLayer({ 6, 6, 2 }, 4, 3);
+    auto layer_2 = ActivationLayer(layer_1, ActivationFun::ReLU);
+    auto layer_3 = Pool2DLayer(layer_2, 2, PoolMode::Max);
+    auto layer_4 = DenseLayer(layer_3, 5);
+    auto layer_5 = ActivationLayer(layer_4, ActivationFun::Sigmoid);
+
+    auto nn = NeuralNetwork(layer_1, layer_5, CostFun::BinaryCrossentropy);
+    ExecutionContext context;
+
+    Tensor expected = nn.predict(x);
+    Tensor result = nn.predict(x, context);
+    uint64_t buffers_size = context.getBuffersSize();
+    result = nn.predict(x, context);
+
+    ASSERT_EQ(expected.getShape(), result.getShape());
+    ASSERT_EQ(buffers_size, context.getBuffersSize());
+    for (uint32_t i = 0; i < 4; ++i) {
+        for (uint32_t j = 0; j < 5; ++j) {
+            ASSERT_NEAR(expected.getValue({ i, j }), result.getValue({ i, j }), 1e-5f);
+        }
+    }
+}
+
+TEST(NeuralNetwork_test, ConcurrentPredictWithContextsShouldMatchPredict) {
+    auto x = Tensor({ 16, 8 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+
+    auto layer_1 = DenseLayer({ 8 }, 32);
+    auto layer_2 = ActivationLayer(layer_1, ActivationFun::LeakyReLU);
+    auto layer_3 = DenseLayer(layer_2, 4);
+    auto layer_4 = ActivationLayer(layer_3, ActivationFun::Sigmoid);
+
+    const auto nn = NeuralNetwork(layer_1, layer_4, CostFun::BinaryCrossentropy);
+    ExecutionContext expected_context;
+    Tensor expected = nn.predict(x, expected_context);
+
+    std::vector<std::thread> threads;
+    std::vector<uint32_t> mismatches(4, 0);
+
+    for (uint32_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            ExecutionContext context;
+            for (uint32_t k = 0; k < 50; ++k) {
+                const Tensor& result = nn.predict(x, context);
+                for (uint32_t i = 0; i < expected.getSize(); ++i) {
+                    mismatches[t] += (expected.getDataPtr()[i] != result.getDataPtr()[i]) ? 1 : 0;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (uint32_t t = 0; t < 4; ++t) {
+        ASSERT_EQ(0u, mismatches[t]);
+    }
+}
+
+TEST(NeuralNetwork_test, FitHistoryShouldContainMetrics) {
+    auto x_train = Tensor({ 64, 4 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    auto y_train = Tensor({ 64, 2 });
+    auto x_test = Tensor({ 16, 4 });
+    auto y_test = Tensor({ 16, 2 });
+
+    auto layer_1 = DenseLayer({ 4 }, 2);
+    auto layer_2 = ActivationLayer(layer_1, ActivationFun::Sigmoid);
+    auto nn = NeuralNetwork(layer_1, layer_2, CostFun::BinaryCrossentropy);
+
+    const char* metrics_path = "fit_metrics_test.jsonl";
+    remove(metrics_path);
+    ASSERT_TRUE(nn.setMetricsOutput(metrics_path));
+
+    FitHistory history = nn.fit(x_train, y_train, x_test, y_test, 16, 2, 0.01f, 0);
+    nn.setMetricsOutput("");
+
+    ASSERT_EQ(2u, history.epochs.size());
+    ASSERT_EQ(8u, history.batches.size());
+    for (const auto& epoch : history.epochs) {
+        ASSERT_EQ(4u, epoch.batches_count);
+        ASSERT_EQ(64u, epoch.samples);
+        ASSERT_GT(epoch.samples_per_sec, 0.0);
+        ASSERT_LE(epoch.train_sec, epoch.wall_sec);
+        double phases_sec = epoch.phases.data_sec + epoch.phases.forward_sec + epoch.phases.backward_sec + epoch.phases.update_sec;
+        ASSERT_LE(phases_sec, epoch.train_sec);
+        ASSERT_FLOAT_EQ(history.train_cost[epoch.epoch], epoch.train_cost);
+    }
+    for (const auto& batch : history.batches) {
+        ASSERT_EQ(16u, batch.samples);
+        ASSERT_GT(batch.wall_sec, 0.0);
+    }
+
+    FILE* file = fopen(metrics_path, "r");
+    ASSERT_NE(nullptr, file);
+    char line[1024];
+    uint32_t batch_lines = 0;
+    uint32_t epoch_lines = 0;
+    while (fgets(line, sizeof(line), file)) {
+        ASSERT_EQ('{', line[0]);
+        batch_lines += (nullptr != strstr(line, "\"type\": \"batch\"")) ? 1 : 0;
+        epoch_lines += (nullptr != strstr(line, "\"type\": \"epoch\"")) ? 1 : 0;
+    }
+    fclose(file);
+    remove(metrics_path);
+
+    ASSERT_EQ(8u, batch_lines);
+    ASSERT_EQ(2u, epoch_lines);
+
+    free(history.train_cost);
+    free(history.test_cost);
+}
+
+TEST(NeuralNetwork_test, FitHistoryShouldKeepLastBatches) {
+    auto x_train = Tensor({ 64, 4 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    auto y_train = Tensor({ 64, 2 });
+    auto x_test = Tensor({ 16, 4 });
+    auto y_test = Tensor({ 16, 2 });
+
+    auto layer_1 = DenseLayer({ 4 }, 2);
+    auto layer_2 = ActivationLayer(layer_1, ActivationFun::Sigmoid);
+    auto nn = NeuralNetwork(layer_1, layer_2, CostFun::BinaryCrossentropy);
+
+    nn.setBatchHistoryLimit(3);
+    FitHistory history = nn.fit(x_train, y_train, x_test, y_test, 16, 2, 0.01f, 0);
+
+    ASSERT_EQ(3u, history.batches.size());
+    for (uint32_t i = 0; i < 3; ++i) {
+        ASSERT_EQ(1u, history.batches[i].epoch);
+        ASSERT_EQ(i + 1, history.batches[i].batch);
+    }
+    free(history.train_cost);
+    free(history.test_cost);
+
+    nn.setBatchHistoryLimit(0);
+    history = nn.fit(x_train, y_train, x_test, y_test, 16, 1, 0.01f, 0);
+
+    ASSERT_TRUE(history.batches.empty());
+    ASSERT_EQ(1u, history.epochs.size());
+    free(history.train_cost);
+    free(history.test_cost);
+}
+
+static void setSequenceWeights(DenseLayer& layer, uint32_t inputs, uint32_t neurons) {
+    std::vector<float> weights(inputs * neurons);
+    for (uint32_t i = 0; i < weights.size(); ++i) {
+        weights[i] = 0.1f * static_cast<float>(i % 7) - 0.3f;
+    }
+    layer.setWeights(weights);
+    layer.setBiases(std::vector<float>(neurons, 0.05f));
+}
+
+enum class MirroredLayer {
+    None,
+    BatchNorm,
+    Dropout
+};
+
+struct MirroredTrainingParam {
+    const char* name;
+    MirroredLayer middle_layer;
+    // segment starts of the mirrored network, the first segment is added by setCheckpoints
+    std::vector<uint32_t> checkpoints;
+    uint32_t accumulation_steps;
+    float tolerance;
+};
+
+// dense, optional batch normalization or dropout, activation, dense, activation with fixed weights
+struct MirroredNetwork {
+    std::unique_ptr<DenseLayer> dense_1;
+    std::unique_ptr<BatchNormLayer> batch_norm;
+    std::unique_ptr<DropoutLayer> dropout;
+    std::unique_ptr<ActivationLayer> activation_1;
+    std::unique_ptr<DenseLayer> dense_2;
+    std::unique_ptr<ActivationLayer> activation_2;
+    std::unique_ptr<NeuralNetwork> nn;
+
+    MirroredNetwork(MirroredLayer middle_layer) {
+        dense_1 = std::make_unique<DenseLayer>(std::vector<uint32_t>({ 4 }), 8);
+        Layer* last = dense_1.get();
+        if (MirroredLayer::BatchNorm == middle_layer) {
+            batch_norm = std::make_unique<BatchNormLayer>(*last, 0.5f);
+            last = batch_norm.get();
+        }
+        if (MirroredLayer::Dropout == middle_layer) {
+            dropout = std::make_unique<DropoutLayer>(*last, 0.5f, 3u);
+            last = dropout.get();
+        }
+        activation_1 = std::make_unique<ActivationLayer>(*last, ActivationFun::ReLU);
+        dense_2 = std::make_unique<DenseLayer>(*activation_1, 2);
+        activation_2 = std::make_unique<ActivationLayer>(*dense_2, ActivationFun::Sigmoid);
+        nn = std::make_unique<NeuralNetwork>(*dense_1, *activation_2, CostFun::BinaryCrossentropy);
+
+        setSequenceWeights(*dense_1, 4, 8);
+        setSequenceWeights(*dense_2, 8, 2);
+    }
+};
+
+class MirroredTraining_test : public testing::TestWithParam<MirroredTrainingParam> {
+};
+
+// mirrored network trains with checkpointing or accumulation, regular one without, both end up with the same weights
+TEST_P(MirroredTraining_test, ShouldMatchRegularTraining) {
+    const MirroredTrainingParam& param = GetParam();
+    auto x_train = Tensor({ 64, 4 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    auto y_train = Tensor({ 64, 2 }).applyFunction([](float) { return randUniform(0.1f, 0.9f); });
+    auto x_test = Tensor({ 16, 4 });
+    auto y_test = Tensor({ 16, 2 });
+
+    MirroredNetwork regular(param.middle_layer);
+    MirroredNetwork mirrored(param.middle_layer);
+    if (!param.checkpoints.empty()) {
+        mirrored.nn->setCheckpoints(param.checkpoints);
+        std::vector<uint32_t> expected_checkpoints = param.checkpoints;
+        expected_checkpoints.insert(expected_checkpoints.begin(), 0);
+        ASSERT_EQ(expected_checkpoints, mirrored.nn->getCheckpoints());
+    }
+
+    // same shuffling in both runs
+    regular.nn->setShuffleSeed(42);
+    mirrored.nn->setShuffleSeed(42);
+    FitHistory history = regular.nn->fit(x_train, y_train, x_test, y_test, 16, 2, 0.1f, 0);
+    FitHistory mirrored_history = mirrored.nn->fit(x_train, y_train, x_test, y_test, 16, 2, 0.1f, 0, DataType::Float32, param.accumulation_steps);
+
+    ASSERT_EQ(history.batches.size(), mirrored_history.batches.size());
+    for (uint32_t i = 0; i < history.batches.size(); ++i) {
+        ASSERT_EQ(16u, mirrored_history.batches[i].samples);
+        ASSERT_NEAR(history.batches[i].cost, mirrored_history.batches[i].cost, param.tolerance);
+    }
+
+    std::vector<float> expected = regular.nn->predict(x_train).getData();
+    std::vector<float> result = mirrored.nn->predict(x_train).getData();
+    for (uint32_t i = 0; i < expected.size(); ++i) {
+        ASSERT_NEAR(expected[i], result[i], param.tolerance);
+    }
+
+    free(history.train_cost);
+    free(history.test_cost);
+    free(mirrored_history.train_cost);
+    free(mirrored_history.test_cost);
+}
+
+// recomputed segments run the same operations, accumulated micro-batch gradients are summed in another order,
+// batch statistics and dropout masks of micro-batches differ from full batches, so they are not accumulated
+INSTANTIATE_TEST_SUITE_P(NeuralNetwork_test, MirroredTraining_test, testing::Values(
+    MirroredTrainingParam{ "Checkpointed", MirroredLayer::None, { 2 }, 1u, 0.0f },
+    MirroredTrainingParam{ "CheckpointedBatchNorm", MirroredLayer::BatchNorm, { 3 }, 1u, 0.0f },
+    MirroredTrainingParam{ "CheckpointedDropout", MirroredLayer::Dropout, { 3 }, 1u, 0.0f },
+    MirroredTrainingParam{ "AccumulatedMicroBatches", MirroredLayer::None, {}, 4u, 1e-5f }
+), [](const testing::TestParamInfo<MirroredTrainingParam>& info) { return std::string(info.param.name); });
+
+TEST(NeuralNetwork_test, FitShouldRejectIndivisibleAccumulationSteps) {
+    auto x_train = Tensor({ 64, 4 });
+    auto y_train = Tensor({ 64, 2 });
+    MirroredNetwork network(MirroredLayer::None);
+
+    ASSERT_THROW(network.nn->fit(x_train, y_train, x_train, y_train, 16, 1, 0.1f, 0, DataType::Float32, 3), std::invalid_argument);
+}
+
+TEST(NeuralNetwork_test, ActivationMemoryBudgetShouldSplitIntoSegments) {
+    auto layer_1 = DenseLayer({ 16 }, 16);
+    auto layer_2 = ActivationLayer(layer_1, ActivationFun::ReLU);
+    auto layer_3 = DenseLayer(layer_2, 16);
+    auto layer_4 = ActivationLayer(layer_3, ActivationFun::ReLU);
+    auto layer_5 = DenseLayer(layer_4, 2);
+    auto layer_6 = ActivationLayer(layer_5, ActivationFun::Sigmoid);
+    auto nn = NeuralNetwork(layer_1, layer_6, CostFun::BinaryCrossentropy);
+
+    uint32_t batch_size = 32;
+    uint64_t full_memory = nn.getActivationMemory(batch_size);
+    ASSERT_EQ(uint64_t(batch_size) * (4 * 32 + 16 + 2 + 2 + 2) * sizeof(float), full_memory);
+
+    auto x = Tensor({ batch_size, 16 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    auto y = Tensor({ batch_size, 2 });
+
+    // budget large enough keeps the whole network in one segment
+    nn.setActivationMemoryBudget(full_memory);
+    nn.initLayersCachedGradient();
+    nn.backwardPropagation(nn.forwardPropagation(x), y);
+    ASSERT_EQ(std::vector<uint32_t>({ 0 }), nn.getCheckpoints());
+
+    nn.setActivationMemoryBudget(full_memory / 2);
+    nn.initLayersCachedGradient();
+    nn.backwardPropagation(nn.forwardPropagation(x), y);
+    ASSERT_GT(nn.getCheckpoints().size(), 1u);
+
+    nn.setActivationMemoryBudget(0);
+    ASSERT_TRUE(nn.getCheckpoints().empty());
+}
+
+TEST(NeuralNetwork_test, PredictShouldNotReplanCheckpoints) {
+    auto layer_1 = DenseLayer({ 16 }, 16);
+    auto layer_2 = ActivationLayer(layer_1, ActivationFun::ReLU);
+    auto layer_3 = DenseLayer(layer_2, 16);
+    auto layer_4 = ActivationLayer(layer_3, ActivationFun::ReLU);
+    auto layer_5 = DenseLayer(layer_4, 2);
+    auto layer_6 = ActivationLayer(layer_5, ActivationFun::Sigmoid);
+    auto nn = NeuralNetwork(layer_1, layer_6, CostFun::BinaryCrossentropy);
+
+    auto x = Tensor({ 32, 16 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    auto y = Tensor({ 32, 2 });
+    auto x_test = Tensor({ 1, 16 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+
+    nn.setActivationMemoryBudget(nn.getActivationMemory(32) / 2);
+    nn.initLayersCachedGradient();
+    nn.backwardPropagation(nn.forwardPropagation(x), y);
+    std::vector<uint32_t> checkpoints = nn.getCheckpoints();
+    ASSERT_GT(checkpoints.size(), 1u);
+
+    // batch of another size, e.g. test batch in fit, keeps the plan of training batches
+    Tensor expected = nn.predict(x_test);
+    ASSERT_EQ(checkpoints, nn.getCheckpoints());
+
+    nn.setActivationMemoryBudget(0);
+    Tensor result = nn.predict(x_test);
+    ASSERT_EQ(expected.getData(), result.getData());
+}
+
+TEST(NeuralNetwork_test, FoldedBatchNormShouldPredictSameAsSeparateLayers) {
+    auto x = Tensor({ 8, 6, 6, 2 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    auto y = Tensor({ 8, 3 }).applyFunction([](float) { return randUniform(0.1f, 0.9f); });
+
+    auto layer_1 = Conv2DLayer({ 6, 6, 2 }, 4, 3);
+    auto layer_2 = BatchNormLayer(layer_1, 0.5f);
+    auto layer_3 = ActivationLayer(layer_2, ActivationFun::ReLU);
+    auto layer_4 = Pool2DLayer(layer_3, 2, PoolMode::Max);
+    auto layer_5 = DenseLayer(layer_4, 3);
+    auto layer_6 = BatchNormLayer(layer_5, 0.5f);
+    auto layer_7 = ActivationLayer(layer_6, ActivationFun::Sigmoid);
+    auto nn = NeuralNetwork(layer_1, layer_7, CostFun::BinaryCrossentropy);
+
+    // running statistics move away from their initial values
+    for (uint32_t step = 0; step < 3; ++step) {
+        nn.initLayersCachedGradient();
+        Tensor y_hat = nn.forwardPropagation(x);
+        nn.backwardPropagation(y_hat, y);
+        nn.updateLayersWeights(0.1f);
+    }
+
+    // layers are folded by the first inference after the updates
+    auto probe = Tensor({ 2, 3 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    Tensor probe_result;
+    layer_6.infer(probe, probe_result);
+    ASSERT_NE(probe.getData(), probe_result.getData());
+
+    ExecutionContext context;
+    Tensor folded = nn.predict(x, context);
+
+    // batch normalization is applied by the layers before it
+    layer_6.infer(probe, probe_result);
+    ASSERT_EQ(probe.getData(), probe_result.getData());
+
+    nn.setLayersFusion(false);
+    Tensor expected = nn.predict(x, context);
+
+    ASSERT_EQ(expected.getShape(), folded.getShape());
+    for (uint32_t i = 0; i < expected.getSize(); ++i) {
+        ASSERT_NEAR(expected.getDataPtr()[i], folded.getDataPtr()[i], 1e-5f);
+    }
+}
+
+TEST(NeuralNetwork_test, PredictShouldNotApplyDropout) {
+    auto x = Tensor({ 8, 4 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    auto y = Tensor({ 8, 8 }).applyFunction([](float) { return randUniform(0.1f, 0.9f); });
+
+    auto layer_1 = DenseLayer({ 4 }, 8);
+    auto layer_2 = DropoutLayer(layer_1, 0.5f, 3u);
+    auto nn = NeuralNetwork(layer_1, layer_2, CostFun::BinaryCrossentropy);
+    setSequenceWeights(layer_1, 4, 8);
+
+    // training step advances the mask
+    nn.initLayersCachedGradient();
+    nn.backwardPropagation(nn.forwardPropagation(x), y);
+
+    Tensor expected;
+    layer_1.infer(x, expected);
+
+    std::vector<float> result_1 = nn.predict(x).getData();
+    std::vector<float> result_2 = nn.predict(x).getData();
+    ASSERT_EQ(result_1, result_2);
+    ASSERT_EQ(expected.getData(), result_1);
+}
+
+TEST(NeuralNetwork_test, SingleSamplePredictShouldUseRunningStatistics) {
+    auto x = Tensor({ 8, 4 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    auto y = Tensor({ 8, 4 }).applyFunction([](float) { return randUniform(0.1f, 0.9f); });
+    auto sample = Tensor({ 1, 4 });
+    sample.setValues({ 0.5f, -0.25f, 1.0f, 0.0f });
+
+    auto layer_1 = BatchNormLayer({ 4 }, 0.5f);
+    auto nn = NeuralNetwork(layer_1, layer_1, CostFun::BinaryCrossentropy);
+
+    for (uint32_t step = 0; step < 3; ++step) {
+        nn.initLayersCachedGradient();
+        nn.backwardPropagation(nn.forwardPropagation(x), y);
+        nn.updateLayersWeights(0.1f);
+    }
+
+    // running statistics as a per-channel scale and shift, batch statistics of one sample would give beta
+    Tensor scale, shift;
+    ASSERT_TRUE(layer_1.getFoldableScaleShift(scale, shift));
+
+    Tensor result = nn.predict(sample);
+    ASSERT_EQ(sample.getShape(), result.getShape());
+    for (uint32_t ch = 0; ch < 4; ++ch) {
+        float expected = sample.getDataPtr()[ch] * scale.getDataPtr()[ch] + shift.getDataPtr()[ch];
+        ASSERT_NEAR(expected, result.getDataPtr()[ch], 1e-5f);
+    }
+}
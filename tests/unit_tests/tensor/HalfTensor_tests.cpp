@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "src/HalfTensor.h"
+#include "tests/unit_tests/UnitTestsUtils.h"
+
+TEST(HalfTensor_test, BFloat16ConversionShouldRoundToNearestEven) {
+    ASSERT_EQ(1.0f, HalfTensor::bFloat16ToFloat(HalfTensor::floatToBFloat16(1.0f)));
+    ASSERT_EQ(-2.5f, HalfTensor::bFloat16ToFloat(HalfTensor::floatToBFloat16(-2.5f)));
+    ASSERT_EQ(0x3F80, HalfTensor::floatToBFloat16(1.00390625f));
+    ASSERT_EQ(0x3F82, HalfTensor::floatToBFloat16(1.01171875f));
+    ASSERT_EQ(0x3F81, HalfTensor::floatToBFloat16(1.0078125f));
+}
+
+TEST(HalfTensor_test, Float16ConversionShouldHandleSpecialValues) {
+    ASSERT_EQ(0x3C00, HalfTensor::floatToFloat16(1.0f));
+    ASSERT_EQ(0xC000, HalfTensor::floatToFloat16(-2.0f));
+    ASSERT_EQ(0x7BFF, HalfTensor::floatToFloat16(65504.0f));
+    ASSERT_EQ(0x7C00, HalfTensor::floatToFloat16(100000.0f));
+    ASSERT_EQ(0x0001, HalfTensor::floatToFloat16(5.9604645e-8f));
+    ASSERT_EQ(0x0000, HalfTensor::floatToFloat16(1e-9f));
+
+    ASSERT_EQ(65504.0f, HalfTensor::float16ToFloat(0x7BFF));
+    ASSERT_EQ(5.9604645e-8f, HalfTensor::float16ToFloat(0x0001));
+    ASSERT_EQ(-0.5f, HalfTensor::float16ToFloat(0xB800));
+    ASSERT_TRUE(std::isinf(HalfTensor::float16ToFloat(0x7C00)));
+}
+
+TEST(HalfTensor_test, ToTensorShouldRestoreValuesWithinPrecision) {
+    Tensor tensor = Tensor({ 2, 3 });
+
+    tensor.setValues({
+        1.0f, -0.5f, 2.2f,
+        3.1f, -10.0f, 123.0f
+        });
+
+    for (auto dtype : { DataType::BFloat16, DataType::Float16 }) {
+        HalfTensor half = HalfTensor(tensor, dtype);
+        Tensor result = half.toTensor();
+
+        ASSERT_EQ(2, (int)result.getDim());
+        ASSERT_EQ(2, (int)result.getShape()[0]);
+        ASSERT_EQ(3, (int)result.getShape()[1]);
+        for (uint32_t i = 0; i < 2; ++i) {
+            for (uint32_t j = 0; j < 3; ++j) {
+                ASSERT_LE(fabs(tensor.getValue({ i, j }) - result.getValue({ i, j })), fabs(tensor.getValue({ i, j })) / 128.0f);
+            }
+        }
+    }
+}
+
+TEST(HalfTensor_test, DotProductTransposeShouldAccumulateInFloat) {
+    Tensor tensor_a = Tensor({ 3, 600 });
+    Tensor tensor_b = Tensor({ 10, 600 });
+
+    tensor_a = tensor_a.applyFunction([](float) { return 1.0f; });
+    tensor_b = tensor_b.applyFunction([](float) { return 0.5f; });
+
+    Tensor result = HalfTensor::dotProductTranspose(tensor_a, HalfTensor(tensor_b, DataType::BFloat16));
+
+    ASSERT_EQ(3, (int)result.getShape()[0]);
+    ASSERT_EQ(10, (int)result.getShape()[1]);
+    for (uint32_t i = 0; i < 3; ++i) {
+        for (uint32_t j = 0; j < 10; ++j) {
+            ASSERT_EQ_EPS(300.0f, result.getValue({ i, j }));
+        }
+    }
+}
+
+TEST(HalfTensor_test, SumShouldAccumulateInFloat) {
+    Tensor tensor = Tensor({ 10000 });
+
+    tensor = tensor.applyFunction([](float) { return 1.0f; });
+
+    ASSERT_EQ_EPS(10000.0f, HalfTensor(tensor, DataType::Float16).sum());
+    ASSERT_EQ_EPS(10000.0f, HalfTensor(tensor, DataType::BFloat16).sum());
+}
\ No newline at end of file
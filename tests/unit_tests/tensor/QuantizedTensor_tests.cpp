@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "src/QuantizedTensor.h"
+#include "src/Utils.h"
+
+TEST(QuantizedTensor_test, PerChannelScalesShouldMatchChannelMaximum) {
+    Tensor tensor = Tensor({ 2, 3 });
+
+    tensor.setValues({
+        1.27f, -0.5f, 0.2f,
+        3.0f, -25.4f, 12.0f
+        });
+
+    QuantizedTensor quantized = QuantizedTensor(tensor, 0u);
+    std::vector<float> scales = quantized.getScales();
+
+    ASSERT_EQ(2u, scales.size());
+    ASSERT_FLOAT_EQ(0.01f, scales[0]);
+    ASSERT_FLOAT_EQ(0.2f, scales[1]);
+
+    Tensor result = quantized.toTensor();
+
+    for (uint32_t i = 0; i < 2; ++i) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            ASSERT_LE(fabs(tensor.getValue({ i, j }) - result.getValue({ i, j })), scales[i] / 2.0f + 1e-6f);
+        }
+    }
+}
+
+TEST(QuantizedTensor_test, DotProductTransposeShouldBeCloseToFloatResult) {
+    Tensor tensor_a = Tensor({ 4, 64 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    Tensor tensor_b = Tensor({ 5, 64 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+
+    Tensor expected = tensor_a.dotProductTranspose(tensor_b);
+    Tensor result = QuantizedTensor::dotProductTranspose(
+        QuantizedTensor(tensor_a, QuantizedTensor::calibrateScale(tensor_a)),
+        QuantizedTensor(tensor_b, 0u));
+
+    ASSERT_EQ(4, (int)result.getShape()[0]);
+    ASSERT_EQ(5, (int)result.getShape()[1]);
+    for (uint32_t i = 0; i < 4; ++i) {
+        for (uint32_t j = 0; j < 5; ++j) {
+            ASSERT_LE(fabs(expected.getValue({ i, j }) - result.getValue({ i, j })), 0.1f);
+        }
+    }
+}
+
+TEST(QuantizedTensor_test, Conv2DShouldBeCloseToFloatResult) {
+    Tensor tensor_a = Tensor({ 6, 7, 3 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+    Tensor tensor_b = Tensor({ 3, 3, 3, 4 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+
+    Tensor expected = tensor_a.Conv2D(tensor_b);
+    Tensor result = QuantizedTensor::Conv2D(
+        QuantizedTensor(tensor_a, QuantizedTensor::calibrateScale(tensor_a)),
+        QuantizedTensor(tensor_b, 3u));
+
+    ASSERT_EQ(4, (int)result.getShape()[0]);
+    ASSERT_EQ(5, (int)result.getShape()[1]);
+    ASSERT_EQ(4, (int)result.getShape()[2]);
+    for (uint32_t i = 0; i < 4; ++i) {
+        for (uint32_t j = 0; j < 5; ++j) {
+            for (uint32_t k = 0; k < 4; ++k) {
+                ASSERT_LE(fabs(expected.getValue({ i, j, k }) - result.getValue({ i, j, k })), 0.1f);
+            }
+        }
+    }
+}
\ No newline at end of file
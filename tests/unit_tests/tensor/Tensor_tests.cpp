@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 #include "src/Tensor.h"
+#include "src/Utils.h"
+#include "tests/unit_tests/UnitTestsUtils.h"
+
+#include <cmath>
 
 TEST(Tensor_test, WhenGetValueShouldReturnProperItem) {
     Tensor tensor = Tensor({ 3, 3 });
@@ -441,6 +445,79 @@ TEST(Tensor_test, WhenAddedTwoTensorsWithDifferentShapesSecondTensorShoudBeAdded
     ASSERT_EQ( 10.0f, tensor_c.getValue({ 1, 2 }));
 }
 
+TEST(Tensor_test, WhenAddedColumnAndRowTensorsShouldBeBroadcastToMatrix) {
+    Tensor tensor_a = Tensor({ 3, 1 });
+    Tensor tensor_b = Tensor({ 4 });
+
+    tensor_a.setValues({ 10.0f, 20.0f, 30.0f });
+    tensor_b.setValues({ 1.0f, 2.0f, 3.0f, 4.0f });
+
+    Tensor tensor_c = tensor_a + tensor_b;
+    Tensor tensor_d = tensor_b - tensor_a;
+
+    ASSERT_EQ(2, (int)tensor_c.getDim());
+    ASSERT_EQ(3, (int)tensor_c.getShape()[0]);
+    ASSERT_EQ(4, (int)tensor_c.getShape()[1]);
+
+    for (uint32_t i = 0; i < 3; ++i) {
+        for (uint32_t j = 0; j < 4; ++j) {
+            ASSERT_EQ(tensor_a.getValue({ i, 0 }) + tensor_b.getValue({ j }), tensor_c.getValue({ i, j }));
+            ASSERT_EQ(tensor_b.getValue({ j }) - tensor_a.getValue({ i, 0 }), tensor_d.getValue({ i, j }));
+        }
+    }
+}
+
+TEST(Tensor_test, WhenMultipliedInPlaceByBroadcastTensorMiddleAxisShouldBeRepeated) {
+    Tensor tensor_a = Tensor({ 2, 3, 2 });
+    Tensor tensor_b = Tensor({ 2, 1, 2 });
+
+    tensor_a.setValues({
+        1.0f, 2.0f,   3.0f, 4.0f,   5.0f, 6.0f,
+        7.0f, 8.0f,   9.0f, 10.0f,  11.0f, 12.0f
+        });
+    tensor_b.setValues({ 1.0f, 2.0f,   -1.0f, 0.5f });
+
+    tensor_a *= tensor_b;
+
+    ASSERT_EQ(  1.0f, tensor_a.getValue({ 0, 0, 0 }));
+    ASSERT_EQ(  4.0f, tensor_a.getValue({ 0, 0, 1 }));
+    ASSERT_EQ(  5.0f, tensor_a.getValue({ 0, 2, 0 }));
+    ASSERT_EQ( 12.0f, tensor_a.getValue({ 0, 2, 1 }));
+    ASSERT_EQ( -7.0f, tensor_a.getValue({ 1, 0, 0 }));
+    ASSERT_EQ(  4.0f, tensor_a.getValue({ 1, 0, 1 }));
+    ASSERT_EQ(-11.0f, tensor_a.getValue({ 1, 2, 0 }));
+    ASSERT_EQ(  6.0f, tensor_a.getValue({ 1, 2, 1 }));
+}
+
+TEST(Tensor_test, WhenComparedWithBroadcastTensorResultShouldHaveBroadcastShape) {
+    Tensor tensor_a = Tensor({ 2, 1 });
+    Tensor tensor_b = Tensor({ 1, 3 });
+
+    tensor_a.setValues({ 1.0f, 3.0f });
+    tensor_b.setValues({ 0.0f, 2.0f, 4.0f });
+
+    Tensor result = tensor_a > tensor_b;
+
+    ASSERT_EQ(2, (int)result.getShape()[0]);
+    ASSERT_EQ(3, (int)result.getShape()[1]);
+
+    ASSERT_EQ(1.0f, result.getValue({ 0, 0 }));
+    ASSERT_EQ(0.0f, result.getValue({ 0, 1 }));
+    ASSERT_EQ(0.0f, result.getValue({ 0, 2 }));
+    ASSERT_EQ(1.0f, result.getValue({ 1, 0 }));
+    ASSERT_EQ(1.0f, result.getValue({ 1, 1 }));
+    ASSERT_EQ(0.0f, result.getValue({ 1, 2 }));
+}
+
+TEST(Tensor_test, WhenShapesCannotBeBroadcastShouldThrow) {
+    Tensor tensor_a = Tensor({ 2, 3 });
+    Tensor tensor_b = Tensor({ 2 });
+    Tensor tensor_c = Tensor({ 2, 1 });
+
+    ASSERT_THROW(tensor_a + tensor_b, std::invalid_argument);
+    ASSERT_THROW(tensor_c += tensor_a, std::invalid_argument);
+}
+
 TEST(Tensor_test, WhenTensorSubtractedFromNumberShouldBeReturnedTensorWithDifferences) {
     float number = 1.0f;
     Tensor tensor_a = Tensor({ 2, 3 });
@@ -622,6 +699,114 @@ TEST(Tensor_test, WhenTensorsAreMatricesDotProductTransposeShouldReturnMatricesP
     ASSERT_EQ(3.25f, result.getValue({ 1, 1 }));
 }
 
+TEST(Tensor_test, DotProductWithTransposeFlagsShouldMatchProductOfTransposedMatrices) {
+    Tensor tensor_a = Tensor({ 3, 2 });
+    Tensor tensor_b = Tensor({ 2, 4 });
+
+    tensor_a.setValues({
+        1.0f, 2.0f,
+        -1.0f, .5f,
+        3.0f, 0.0f
+        });
+
+    tensor_b.setValues({
+        2.0f, 1.0f, 0.0f, -1.0f,
+        .5f, 4.0f, 2.0f, 1.0f
+        });
+
+    Tensor expected = tensor_a.dotProduct(tensor_b);
+
+    Tensor result_nn = tensor_a.dotProduct(tensor_b, false, false);
+    Tensor result_tn = tensor_a.transpose().dotProduct(tensor_b, true, false);
+    Tensor result_nt = tensor_a.dotProduct(tensor_b.transpose(), false, true);
+    Tensor result_tt = tensor_a.transpose().dotProduct(tensor_b.transpose(), true, true);
+
+    for (auto result : { result_nn, result_tn, result_nt, result_tt }) {
+        ASSERT_EQ(2, (int)result.getDim());
+        ASSERT_EQ(3, (int)result.getShape()[0]);
+        ASSERT_EQ(4, (int)result.getShape()[1]);
+        for (uint32_t i = 0; i < 3; ++i) {
+            for (uint32_t j = 0; j < 4; ++j) {
+                ASSERT_EQ(expected.getValue({ i, j }), result.getValue({ i, j }));
+            }
+        }
+    }
+}
+
+TEST(Tensor_test, TransposeShouldSwapAxesOfLargeMatrix) {
+    Tensor tensor = Tensor({ 37, 70 });
+
+    tensor = tensor.applyFunction([](float) { return static_cast<float>(rand() % 1000); });
+
+    Tensor result = tensor.transpose();
+
+    ASSERT_EQ(70, (int)result.getShape()[0]);
+    ASSERT_EQ(37, (int)result.getShape()[1]);
+    for (uint32_t i = 0; i < 37; ++i) {
+        for (uint32_t j = 0; j < 70; ++j) {
+            ASSERT_EQ(tensor.getValue({ i, j }), result.getValue({ j, i }));
+        }
+    }
+}
+
+TEST(Tensor_test, TransposeInPlaceShouldMatchTranspose) {
+    for (auto shape : { std::vector<uint32_t>({ 45, 45 }), std::vector<uint32_t>({ 13, 50 }) }) {
+        Tensor tensor = Tensor(shape);
+
+        tensor = tensor.applyFunction([](float) { return static_cast<float>(rand() % 1000); });
+
+        Tensor expected = tensor.transpose();
+        tensor.transposeInPlace();
+
+        ASSERT_EQ(expected.getShape()[0], tensor.getShape()[0]);
+        ASSERT_EQ(expected.getShape()[1], tensor.getShape()[1]);
+        ASSERT_TRUE(expected.getData() == tensor.getData());
+    }
+}
+
+TEST(Tensor_test, ReshapeInPlaceShouldMatchReshape) {
+    Tensor tensor = Tensor({ 2, 3, 4 });
+
+    tensor = tensor.applyFunction([](float) { return static_cast<float>(rand() % 1000); });
+
+    Tensor expected = tensor.reshape({ 6, 4 });
+    tensor.reshapeInPlace({ 6, 4 });
+
+    ASSERT_EQ(expected.getShape(), tensor.getShape());
+    ASSERT_TRUE(expected.getData() == tensor.getData());
+    ASSERT_THROW(tensor.reshapeInPlace({ 5, 4 }), std::invalid_argument);
+}
+
+TEST(Tensor_test, PermuteShouldReorderAxes) {
+    Tensor tensor = Tensor({ 2, 3, 4 });
+
+    tensor = tensor.applyFunction([](float) { return static_cast<float>(rand() % 1000); });
+
+    Tensor result = tensor.permute({ 2, 0, 1 });
+
+    ASSERT_EQ(3, (int)result.getDim());
+    ASSERT_EQ(4, (int)result.getShape()[0]);
+    ASSERT_EQ(2, (int)result.getShape()[1]);
+    ASSERT_EQ(3, (int)result.getShape()[2]);
+    for (uint32_t i = 0; i < 2; ++i) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            for (uint32_t k = 0; k < 4; ++k) {
+                ASSERT_EQ(tensor.getValue({ i, j, k }), result.getValue({ k, i, j }));
+            }
+        }
+    }
+
+    Tensor result_last = tensor.permute({ 0, 2, 1 });
+
+    for (uint32_t i = 0; i < 2; ++i) {
+        for (uint32_t j = 0; j < 3; ++j) {
+            for (uint32_t k = 0; k < 4; ++k) {
+                ASSERT_EQ(tensor.getValue({ i, j, k }), result_last.getValue({ i, k, j }));
+            }
+        }
+    }
+}
+
 TEST(Tensor_test, TensorProductResultDimShouldBeSumOfArgumentsDims) {
     Tensor tensor_a = Tensor({ 2, 3 });
     Tensor tensor_b = Tensor({ 4, 5, 6 });
@@ -720,6 +905,156 @@ TEST(Tensor_test, TensorConv2DTest) {
     ASSERT_EQ(153.0f, result.getValue({ 0, 2, 2 }));
 }
 
+TEST(Tensor_test, TensorConv2DShouldMatchSumOfWindowProducts) {
+    std::vector<std::vector<uint32_t>> filter_shapes = { { 1, 1 }, { 3, 3 }, { 5, 5 }, { 2, 3 } };
+
+    for (auto filter_shape : filter_shapes) {
+        Tensor tensor_a = Tensor({ 7, 8, 3 });
+        Tensor tensor_b = Tensor({ filter_shape[0], filter_shape[1], 3, 4 });
+
+        tensor_a = tensor_a.applyFunction([](float) { return static_cast<float>(rand() % 7) - 3.0f; });
+        tensor_b = tensor_b.applyFunction([](float) { return static_cast<float>(rand() % 7) - 3.0f; });
+
+        Tensor result = tensor_a.Conv2D(tensor_b);
+
+        ASSERT_EQ(8u - filter_shape[0], result.getShape()[0]);
+        ASSERT_EQ(9u - filter_shape[1], result.getShape()[1]);
+        ASSERT_EQ(4u, result.getShape()[2]);
+
+        for (uint32_t i = 0; i < result.getShape()[0]; ++i) {
+            for (uint32_t j = 0; j < result.getShape()[1]; ++j) {
+                for (uint32_t k = 0; k < 4; ++k) {
+                    float expected = (tensor_a.getSubTensor({ { i, i + filter_shape[0] }, { j, j + filter_shape[1] }, {} }) *
+                                      tensor_b.getSubTensor({ WHOLE_AXIS, WHOLE_AXIS, WHOLE_AXIS, k })).sum();
+                    ASSERT_EQ(expected, result.getValue({ i, j, k }));
+                }
+            }
+        }
+    }
+}
+
+TEST(Tensor_test, TensorConv2DIm2colShouldMatchDirectConv2D) {
+    // full and partial register tiles of the direct kernel
+    std::vector<std::vector<uint32_t>> filter_shapes = { { 1, 1 }, { 3, 3 }, { 5, 5 }, { 2, 3 } };
+
+    for (auto filter_shape : filter_shapes) {
+        Tensor tensor_a = Tensor({ 9, 13, 3 }).applyFunction([](float) { return static_cast<float>(rand() % 7) - 3.0f; });
+        Tensor tensor_b = Tensor({ filter_shape[0], filter_shape[1], 3, 19 }).applyFunction([](float) { return static_cast<float>(rand() % 7) - 3.0f; });
+
+        Tensor expected = tensor_a.Conv2D(tensor_b);
+        Tensor result = tensor_a.Conv2DIm2col(tensor_b);
+
+        ASSERT_EQ(expected.getShape(), result.getShape());
+        for (uint32_t i = 0; i < expected.getSize(); ++i) {
+            ASSERT_EQ(expected.getDataPtr()[i], result.getDataPtr()[i]);
+        }
+    }
+}
+
+TEST(Tensor_test, TensorConv2DWinogradShouldMatchDirectConv2D) {
+    std::vector<std::vector<uint32_t>> input_shapes = { { 7, 8, 3 }, { 6, 6, 1 }, { 3, 3, 2 }, { 12, 9, 16 } };
+
+    for (auto input_shape : input_shapes) {
+        Tensor tensor_a = Tensor(input_shape).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+        Tensor tensor_b = Tensor({ 3, 3, input_shape[2], 5 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+
+        Tensor expected = tensor_a.Conv2D(tensor_b);
+        Tensor result = tensor_a.Conv2DWinograd(Tensor::winogradFilter(tensor_b));
+
+        ASSERT_EQ(expected.getShape(), result.getShape());
+        for (uint32_t i = 0; i < expected.getSize(); ++i) {
+            ASSERT_NEAR(expected.getDataPtr()[i], result.getDataPtr()[i], 1e-4f);
+        }
+    }
+}
+
+TEST(Tensor_test, TensorConv2DShouldSupportStrideDilationAndPadding) {
+    // params, expected output height and width, expected top and left padding
+    std::vector<std::pair<Conv2DParams, std::vector<uint32_t>>> cases = {
+        { { 2, 1, ConvPadding::Valid }, { 3, 3, 0, 0 } },
+        { { 1, 2, ConvPadding::Same }, { 7, 8, 2, 2 } },
+        { { 2, 1, ConvPadding::Same }, { 4, 4, 1, 0 } },
+        { { 2, 2, ConvPadding::Explicit, 1, 2 }, { 3, 4, 1, 2 } },
+    };
+
+    for (auto& conv_case : cases) {
+        const Conv2DParams& params = conv_case.first;
+        Tensor tensor_a = Tensor({ 7, 8, 3 }).applyFunction([](float) { return static_cast<float>(rand() % 7) - 3.0f; });
+        Tensor tensor_b = Tensor({ 3, 3, 3, 4 }).applyFunction([](float) { return static_cast<float>(rand() % 7) - 3.0f; });
+
+        Conv2DGeometry g = Tensor::conv2DGeometry(tensor_a.getShape(), tensor_b.getShape(), params);
+        ASSERT_EQ(conv_case.second, std::vector<uint32_t>({ g.out_h, g.out_w, g.padding_top, g.padding_left }));
+
+        Tensor result = tensor_a.Conv2D(tensor_b, params);
+        ASSERT_EQ(std::vector<uint32_t>({ g.out_h, g.out_w, 4 }), result.getShape());
+
+        for (uint32_t i = 0; i < g.out_h; ++i) {
+            for (uint32_t j = 0; j < g.out_w; ++j) {
+                for (uint32_t k = 0; k < 4; ++k) {
+                    float expected = 0.0f;
+                    for (uint32_t kh = 0; kh < 3; ++kh) {
+                        for (uint32_t kw = 0; kw < 3; ++kw) {
+                            int32_t y = (int32_t)(i * params.stride + kh * params.dilation) - (int32_t)g.padding_top;
+                            int32_t x = (int32_t)(j * params.stride + kw * params.dilation) - (int32_t)g.padding_left;
+                            if ((y < 0) || (y >= 7) || (x < 0) || (x >= 8)) {
+                                continue;
+                            }
+                            for (uint32_t ch = 0; ch < 3; ++ch) {
+                                expected += tensor_a.getValue({ (uint32_t)y, (uint32_t)x, ch }) * tensor_b.getValue({ kh, kw, ch, k });
+                            }
+                        }
+                    }
+                    ASSERT_EQ(expected, result.getValue({ i, j, k }));
+                }
+            }
+        }
+
+        Tensor result_im2col = tensor_a.Conv2DIm2col(tensor_b, params);
+        ASSERT_EQ(result.getShape(), result_im2col.getShape());
+        for (uint32_t i = 0; i < result.getSize(); ++i) {
+            ASSERT_EQ(result.getDataPtr()[i], result_im2col.getDataPtr()[i]);
+        }
+    }
+}
+
+TEST(Tensor_test, TensorConv2DWinogradShouldMatchDirectConv2DWithSamePadding) {
+    std::vector<std::vector<uint32_t>> input_shapes = { { 7, 8, 3 }, { 2, 1, 2 }, { 12, 9, 16 } };
+    Conv2DParams params = { 1, 1, ConvPadding::Same };
+
+    for (auto input_shape : input_shapes) {
+        Tensor tensor_a = Tensor(input_shape).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+        Tensor tensor_b = Tensor({ 3, 3, input_shape[2], 5 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+
+        Tensor expected = tensor_a.Conv2D(tensor_b, params);
+        Tensor result = tensor_a.Conv2DWinograd(Tensor::winogradFilter(tensor_b), params);
+
+        ASSERT_EQ(std::vector<uint32_t>({ input_shape[0], input_shape[1], 5 }), result.getShape());
+        for (uint32_t i = 0; i < expected.getSize(); ++i) {
+            ASSERT_NEAR(expected.getDataPtr()[i], result.getDataPtr()[i], 1e-4f);
+        }
+    }
+}
+
+TEST(Tensor_test, TensorConv2DFFTShouldMatchDirectConv2D) {
+    std::vector<std::vector<uint32_t>> filter_shapes = { { 1, 1 }, { 3, 3 }, { 7, 7 }, { 2, 5 } };
+    std::vector<Conv2DParams> params_list = { { 1, 1, ConvPadding::Valid }, { 1, 1, ConvPadding::Same }, { 1, 1, ConvPadding::Explicit, 3, 1 } };
+
+    for (auto filter_shape : filter_shapes) {
+        for (auto& params : params_list) {
+            Tensor tensor_a = Tensor({ 9, 13, 3 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+            Tensor tensor_b = Tensor({ filter_shape[0], filter_shape[1], 3, 5 }).applyFunction([](float) { return randUniform(-1.0f, 1.0f); });
+
+            Tensor expected = tensor_a.Conv2D(tensor_b, params);
+            Tensor result = tensor_a.Conv2DFFT(tensor_b, params);
+
+            ASSERT_EQ(expected.getShape(), result.getShape());
+            for (uint32_t i = 0; i < expected.getSize(); ++i) {
+                ASSERT_NEAR(expected.getDataPtr()[i], result.getDataPtr()[i], 1e-4f);
+            }
+        }
+    }
+}
+
 TEST(Tensor_test, TensorSumTest) {
     Tensor tensor = Tensor({ 2, 3, 2 });
 
@@ -858,6 +1193,133 @@ TEST(Tensor_test, SumAcrossThridAxisOf3DTensor) {
     ASSERT_EQ(23.0f, result.getValue({ 1, 2 }));
 }
 
+TEST(Tensor_test, SumAcrossFirstAndLastAxesOf3DTensor) {
+    Tensor tensor = Tensor({ 2, 3, 2 });
+
+    tensor.setValues({
+        1.0f, 2.0f,
+        3.0f, 4.0f,
+        5.0f, 6.0f,
+
+        7.0f, 8.0f,
+        9.0f, 10.0f,
+        11.0f, 12.0f
+        });
+
+    Tensor result = tensor.sum({ 0, 2 });
+
+    ASSERT_EQ(1, (int)result.getDim());
+    ASSERT_EQ(3, (int)result.getShape()[0]);
+
+    ASSERT_EQ(18.0f, result.getValue({ 0 }));
+    ASSERT_EQ(26.0f, result.getValue({ 1 }));
+    ASSERT_EQ(34.0f, result.getValue({ 2 }));
+
+    Tensor result_all = tensor.sum({ 0, 1, 2 });
+
+    ASSERT_EQ(78.0f, result_all.getValue());
+}
+
+TEST(Tensor_test, MaxMinAndMeanAcrossAxes) {
+    Tensor tensor = Tensor({ 2, 3, 2 });
+
+    tensor.setValues({
+        1.0f, -2.0f,
+        3.0f, 14.0f,
+        5.0f, 6.0f,
+
+        -7.0f, 8.0f,
+        9.0f, 10.0f,
+        11.0f, 0.0f
+        });
+
+    Tensor result_max = tensor.max({ 1 });
+    Tensor result_min = tensor.min({ 0, 1 });
+    Tensor result_mean = tensor.mean({ 2 });
+
+    ASSERT_EQ( 5.0f, result_max.getValue({ 0, 0 }));
+    ASSERT_EQ(14.0f, result_max.getValue({ 0, 1 }));
+    ASSERT_EQ(11.0f, result_max.getValue({ 1, 0 }));
+    ASSERT_EQ(10.0f, result_max.getValue({ 1, 1 }));
+
+    ASSERT_EQ(-7.0f, result_min.getValue({ 0 }));
+    ASSERT_EQ(-2.0f, result_min.getValue({ 1 }));
+
+    ASSERT_EQ(-0.5f, result_mean.getValue({ 0, 0 }));
+    ASSERT_EQ( 8.5f, result_mean.getValue({ 0, 1 }));
+    ASSERT_EQ( 5.5f, result_mean.getValue({ 1, 2 }));
+
+    ASSERT_EQ(14.0f, tensor.max());
+    ASSERT_EQ(-7.0f, tensor.min());
+}
+
+TEST(Tensor_test, VarianceAcrossAxesShouldMatchDefinition) {
+    Tensor tensor = Tensor({ 4, 3 });
+
+    tensor.setValues({
+        1.0f, 2.0f, 0.0f,
+        3.0f, 2.0f, 0.0f,
+        5.0f, 2.0f, 4.0f,
+        7.0f, 2.0f, 4.0f
+        });
+
+    Tensor result = tensor.variance({ 0 });
+
+    ASSERT_EQ(1, (int)result.getDim());
+    ASSERT_EQ_EPS(5.0f, result.getValue({ 0 }));
+    ASSERT_EQ_EPS(0.0f, result.getValue({ 1 }));
+    ASSERT_EQ_EPS(4.0f, result.getValue({ 2 }));
+
+    ASSERT_EQ_EPS(tensor.variance({ 0, 1 }).getValue(), tensor.variance());
+}
+
+TEST(Tensor_test, ArgmaxShouldReturnIndexOfFirstMaximum) {
+    Tensor tensor = Tensor({ 2, 3, 2 });
+
+    tensor.setValues({
+        1.0f, -2.0f,
+        3.0f, 14.0f,
+        5.0f, 14.0f,
+
+        -7.0f, 8.0f,
+        9.0f, 10.0f,
+        9.0f, 0.0f
+        });
+
+    Tensor result_inner = tensor.argmax(2);
+    Tensor result_middle = tensor.argmax(1);
+
+    ASSERT_EQ(2, (int)result_inner.getShape()[0]);
+    ASSERT_EQ(3, (int)result_inner.getShape()[1]);
+    ASSERT_EQ(0.0f, result_inner.getValue({ 0, 0 }));
+    ASSERT_EQ(1.0f, result_inner.getValue({ 0, 1 }));
+    ASSERT_EQ(1.0f, result_inner.getValue({ 1, 0 }));
+    ASSERT_EQ(0.0f, result_inner.getValue({ 1, 2 }));
+
+    ASSERT_EQ(2, (int)result_middle.getShape()[0]);
+    ASSERT_EQ(2, (int)result_middle.getShape()[1]);
+    ASSERT_EQ(2.0f, result_middle.getValue({ 0, 0 }));
+    ASSERT_EQ(1.0f, result_middle.getValue({ 0, 1 }));
+    ASSERT_EQ(1.0f, result_middle.getValue({ 1, 0 }));
+    ASSERT_EQ(1.0f, result_middle.getValue({ 1, 1 }));
+}
+
+TEST(Tensor_test, PairwiseSumOfManySmallValuesShouldBeAccurate) {
+    constexpr uint32_t n = 1u << 22;
+    Tensor tensor = Tensor({ n });
+
+    tensor = tensor + 0.1f;
+
+    ASSERT_LE(fabs(tensor.sum() - n * 0.1f), 1e-5f * n * 0.1f);
+
+    Tensor columns = Tensor({ n / 4, 4 }) + 0.1f;
+    Tensor result = columns.sum({ 0 });
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        ASSERT_LE(fabs(result.getValue({ i }) - n / 4 * 0.1f), 1e-5f * n / 4 * 0.1f);
+    }
+}
+
 TEST(Tensor_test, WhenFlattenResultShouldHaveOnlyOneDimEqualToSize) {
     Tensor tensor = Tensor({ 2, 3, 2 });
 
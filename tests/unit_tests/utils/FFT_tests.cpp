@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "src/FFT.h"
+#include "src/Utils.h"
+
+static std::vector<Complex> naiveDFT(const std::vector<Complex>& x, double sign) {
+    uint32_t n = x.size();
+    std::vector<Complex> result(n);
+    for (uint32_t k = 0; k < n; ++k) {
+        std::complex<double> sum = 0.0;
+        for (uint32_t j = 0; j < n; ++j) {
+            double phase = sign * 2.0 * M_PI * double(j) * k / n;
+            sum += std::complex<double>(x[j]) * std::complex<double>(cos(phase), sin(phase));
+        }
+        result[k] = Complex(sum);
+    }
+    return result;
+}
+
+TEST(FFT_test, FastSizeShouldBeEvenAndHaveSmallPrimeFactors) {
+    ASSERT_EQ(2u, FFT::fastSize(1));
+    ASSERT_EQ(2u, FFT::fastSize(2));
+    ASSERT_EQ(4u, FFT::fastSize(3));
+    ASSERT_EQ(12u, FFT::fastSize(11));
+    ASSERT_EQ(16u, FFT::fastSize(13));
+    ASSERT_EQ(36u, FFT::fastSize(35));
+    ASSERT_EQ(50u, FFT::fastSize(49));
+}
+
+TEST(FFT_test, FFTShouldMatchNaiveDFT) {
+    for (uint32_t n : { 1, 2, 3, 4, 5, 6, 8, 9, 12, 15, 25, 30, 60, 64 }) {
+        std::vector<Complex> x(n);
+        for (auto& value : x) {
+            value = Complex(randUniform(-1.0f, 1.0f), randUniform(-1.0f, 1.0f));
+        }
+        FFT fft = FFT(n);
+        std::vector<Complex> spectrum(n);
+        std::vector<Complex> signal(n);
+
+        fft.forward(x.data(), spectrum.data());
+        std::vector<Complex> expected = naiveDFT(x, -1.0);
+        for (uint32_t k = 0; k < n; ++k) {
+            ASSERT_NEAR(expected[k].real(), spectrum[k].real(), 1e-4f * n);
+            ASSERT_NEAR(expected[k].imag(), spectrum[k].imag(), 1e-4f * n);
+        }
+
+        fft.inverse(spectrum.data(), signal.data());
+        for (uint32_t k = 0; k < n; ++k) {
+            ASSERT_NEAR(x[k].real() * n, signal[k].real(), 1e-4f * n);
+            ASSERT_NEAR(x[k].imag() * n, signal[k].imag(), 1e-4f * n);
+        }
+    }
+}
+
+TEST(FFT_test, RealFFTShouldMatchComplexFFT) {
+    for (uint32_t n : { 2, 4, 6, 10, 18, 30, 64 }) {
+        std::vector<float> x(n);
+        std::vector<Complex> x_complex(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            x[i] = randUniform(-1.0f, 1.0f);
+            x_complex[i] = Complex(x[i], 0.0f);
+        }
+        RealFFT fft = RealFFT(n);
+        std::vector<Complex> spectrum(fft.getBinsCount());
+        std::vector<Complex> work(n);
+        std::vector<float> signal(n);
+
+        fft.forward(x.data(), spectrum.data(), work.data());
+        std::vector<Complex> expected = naiveDFT(x_complex, -1.0);
+        ASSERT_EQ(n / 2 + 1, fft.getBinsCount());
+        for (uint32_t k = 0; k < fft.getBinsCount(); ++k) {
+            ASSERT_NEAR(expected[k].real(), spectrum[k].real(), 1e-4f * n);
+            ASSERT_NEAR(expected[k].imag(), spectrum[k].imag(), 1e-4f * n);
+        }
+
+        fft.inverse(spectrum.data(), signal.data(), work.data());
+        for (uint32_t i = 0; i < n; ++i) {
+            ASSERT_NEAR(x[i] * n, signal[i], 1e-4f * n);
+        }
+    }
+}
+
+TEST(FFT_test, RealFFT2DShouldMatchNaiveDFT) {
+    const uint32_t h = 6;
+    const uint32_t w = 10;
+    // rows outside [1, 4) are zeros
+    std::vector<float> x(h * w, 0.0f);
+    for (uint32_t i = 1; i < 4; ++i) {
+        for (uint32_t j = 0; j < w; ++j) {
+            x[i * w + j] = randUniform(-1.0f, 1.0f);
+        }
+    }
+    RealFFT2D fft = RealFFT2D(h, w);
+    std::vector<Complex> spectrum(fft.getBinsCount());
+    fft.forward(x.data(), spectrum.data(), 1, 4);
+
+    ASSERT_EQ(h * (w / 2 + 1), fft.getBinsCount());
+    for (uint32_t u = 0; u < h; ++u) {
+        for (uint32_t v = 0; v < w / 2 + 1; ++v) {
+            std::complex<double> expected = 0.0;
+            for (uint32_t i = 0; i < h; ++i) {
+                for (uint32_t j = 0; j < w; ++j) {
+                    double phase = -2.0 * M_PI * (double(u) * i / h + double(v) * j / w);
+                    expected += double(x[i * w + j]) * std::complex<double>(cos(phase), sin(phase));
+                }
+            }
+            ASSERT_NEAR(expected.real(), spectrum[u * (w / 2 + 1) + v].real(), 1e-4f);
+            ASSERT_NEAR(expected.imag(), spectrum[u * (w / 2 + 1) + v].imag(), 1e-4f);
+        }
+    }
+
+    // only the first rows are reconstructed
+    std::vector<float> signal(h * w, 0.0f);
+    fft.inverse(spectrum.data(), signal.data(), 4);
+    for (uint32_t i = 0; i < 4 * w; ++i) {
+        ASSERT_NEAR(x[i] * h * w, signal[i], 1e-3f);
+    }
+    for (uint32_t i = 4 * w; i < h * w; ++i) {
+        ASSERT_EQ(0.0f, signal[i]);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "src/MemoryTracker.h"
+#include "src/Tensor.h"
+#include "src/DenseLayer.h"
+#include "src/ActivationLayer.h"
+#include "src/NeuralNetwork.h"
+
+TEST(MemoryTracker_test, TensorAllocationsShouldBeCounted) {
+    MemoryTracker::reset();
+    MemoryTracker::setEnabled(true);
+    {
+        Tensor a = Tensor({ 16, 16 });
+        Tensor b = Tensor({ 8 });
+        Tensor c = a;
+
+        MemoryStats stats = MemoryTracker::getStats();
+        ASSERT_EQ(3u, stats.allocations_count);
+        ASSERT_EQ((2 * 256 + 8) * sizeof(float), stats.allocated_bytes);
+        ASSERT_EQ((int64_t)((2 * 256 + 8) * sizeof(float)), stats.live_bytes);
+    }
+    MemoryStats stats = MemoryTracker::getStats();
+    MemoryTracker::setEnabled(false);
+
+    ASSERT_EQ(0, stats.live_bytes);
+    ASSERT_EQ((int64_t)((2 * 256 + 8) * sizeof(float)), stats.peak_bytes);
+    // 1024 B falls into [2^10, 2^11), 32 B into [2^5, 2^6)
+    ASSERT_EQ(2u, stats.size_histogram[10]);
+    ASSERT_EQ(1u, stats.size_histogram[5]);
+}
+
+TEST(MemoryTracker_test, DisabledTrackerShouldNotCount) {
+    MemoryTracker::reset();
+    MemoryTracker::setEnabled(false);
+
+    Tensor a = Tensor({ 100 });
+
+    MemoryStats stats = MemoryTracker::getStats();
+    ASSERT_EQ(0u, stats.allocations_count);
+    ASSERT_EQ(0, stats.peak_bytes);
+}
+
+TEST(MemoryTracker_test, AllocationsShouldBeAttributedToInnermostScope) {
+    MemoryTracker::reset();
+    MemoryTracker::setEnabled(true);
+    {
+        MemoryScope outer("outer");
+        Tensor a = Tensor({ 10 });
+        {
+            MemoryScope inner("inner");
+            Tensor b = Tensor({ 20 });
+            Tensor c = Tensor({ 30 });
+        }
+    }
+    MemoryTracker::setEnabled(false);
+
+    MemoryStats outer = MemoryTracker::getScopeStats("outer");
+    MemoryStats inner = MemoryTracker::getScopeStats("inner");
+
+    ASSERT_EQ(1u, outer.allocations_count);
+    ASSERT_EQ(10 * sizeof(float), outer.allocated_bytes);
+    ASSERT_EQ(2u, inner.allocations_count);
+    ASSERT_EQ(50 * sizeof(float), inner.allocated_bytes);
+    ASSERT_EQ((int64_t)(50 * sizeof(float)), inner.peak_bytes);
+    ASSERT_EQ(0, inner.live_bytes);
+}
+
+TEST(MemoryTracker_test, FreesShouldBeChargedToAllocatingScope) {
+    MemoryTracker::reset();
+    MemoryTracker::setEnabled(true);
+    {
+        Tensor a;
+        {
+            MemoryScope producer("producer");
+            a = Tensor({ 10 });
+        }
+        MemoryScope consumer("consumer");
+        Tensor b = Tensor({ 20 });
+        a.release();
+    }
+    MemoryTracker::setEnabled(false);
+
+    ASSERT_EQ(0, MemoryTracker::getScopeStats("producer").live_bytes);
+    ASSERT_EQ(0, MemoryTracker::getScopeStats("consumer").live_bytes);
+}
+
+TEST(MemoryTracker_test, TrainingStepShouldBeAttributedToLayers) {
+    auto layer_1 = DenseLayer({ 8 }, 16);
+    auto layer_2 = ActivationLayer(layer_1, ActivationFun::ReLU);
+    auto layer_3 = DenseLayer(layer_2, 2);
+    NeuralNetwork nn = NeuralNetwork(layer_1, layer_3, CostFun::BinaryCrossentropy);
+
+    Tensor x = Tensor({ 4, 8 });
+    Tensor y = Tensor({ 4, 2 });
+
+    MemoryTracker::reset();
+    MemoryTracker::setEnabled(true);
+    nn.initLayersCachedGradient();
+    nn.backwardPropagation(nn.forwardPropagation(x), y);
+    nn.updateLayersWeights(0.1f);
+    MemoryTracker::setEnabled(false);
+
+    std::vector<std::string> names = MemoryTracker::getScopeNames();
+    for (const auto& name : { "layer 0", "layer 1", "layer 2" }) {
+        ASSERT_NE(names.end(), std::find(names.begin(), names.end(), name));
+        ASSERT_GT(MemoryTracker::getScopeStats(name).allocations_count, 0u);
+    }
+    ASSERT_GE(MemoryTracker::getStats().peak_bytes, (int64_t)(16 * 8 * sizeof(float)));
+}
\ No newline at end of file
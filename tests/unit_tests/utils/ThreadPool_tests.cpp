@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include "src/ThreadPool.h"
+#include "src/Tensor.h"
+
+TEST(ThreadPool_test, ParallelForShouldVisitEachIndexOnce) {
+    ThreadPool pool = ThreadPool(4);
+    std::vector<uint32_t> visits(1000, 0);
+
+    pool.parallelFor(0, 1000, 10, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            ++visits[i];
+        }
+    });
+
+    for (uint32_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(1u, visits[i]);
+    }
+}
+
+TEST(ThreadPool_test, ParallelForCalledManyTimesShouldFinishAllWork) {
+    ThreadPool pool = ThreadPool(3);
+    std::atomic<uint32_t> count{ 0 };
+
+    for (uint32_t k = 0; k < 200; ++k) {
+        pool.parallelFor(0, 64, 1, [&](uint32_t begin, uint32_t end) {
+            count += end - begin;
+        });
+    }
+
+    ASSERT_EQ(200u * 64u, count.load());
+}
+
+TEST(ThreadPool_test, ReductionsShouldNotDependOnThreadsCount) {
+    Tensor tensor = Tensor({ 64, 1024 }).applyFunction([](float) { return static_cast<float>(rand() % 100); });
+    uint32_t threads_count = ThreadPool::getDefault().getThreadsCount();
+
+    ThreadPool::getDefault().setThreadsCount(1);
+    Tensor expected_rows = tensor.sum({ 1 });
+    Tensor expected_columns = tensor.max({ 0 });
+
+    ThreadPool::getDefault().setThreadsCount(4);
+    Tensor result_rows = tensor.sum({ 1 });
+    Tensor result_columns = tensor.max({ 0 });
+
+    ThreadPool::getDefault().setThreadsCount(threads_count);
+
+    ASSERT_EQ(expected_rows.getData(), result_rows.getData());
+    ASSERT_EQ(expected_columns.getData(), result_columns.getData());
+}
\ No newline at end of file
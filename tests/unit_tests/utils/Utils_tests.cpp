@@ -18,6 +18,20 @@ TEST(Utils_test, GenPermutationResultShouldContainAllNumbersUpToN) {
     ASSERT_EQ(32, s);
 }
 
+TEST(Utils_test, GenPermutationWithSameSeedShouldBeEqual) {
+    uint32_t* permutation_a;
+    uint32_t* permutation_b;
+
+    permutation_a = genPermutation(32, 42);
+    permutation_b = genPermutation(32, 42);
+
+    for (int i = 0; i < 32; ++i) {
+        ASSERT_EQ(permutation_a[i], permutation_b[i]);
+    }
+    free(permutation_a);
+    free(permutation_b);
+}
+
 TEST(Utils_test, RandNormalDistributionValesMeanShouldBeCloseToZero) {
     constexpr int n = 1000000;
     float mean = 0;